@@ -41,7 +41,7 @@
 layout(location = 0) noperspective in vec2 vTexCoords;
 layout(location = 1) flat in uvec4  block1;
 layout(location = 2) flat in uvec4  block2;
-layout(location = 3) flat in uvec4  block3;
+layout(location = 3) flat in uvec3  block3;
 
 layout(location = 0) out vec4 fColor;
 
@@ -112,10 +112,9 @@ void main()
 	const bool uIsWall = ( block2.w != 0 );
 
 	const uint vFlags = block3.x;
-	const uint vFlags2 = block3.y;
 
-	const uint vLightLevel = block3.z;
-	const uint vVegetationLevel = block3.w;
+	const uint vLightLevel = block3.y;
+	const uint vVegetationLevel = block3.z;
 
 	uint vFluidLevel = (vFluidLevelPacked1 >> 0) & 0xff;
 	uint vFluidLevelLeft = (vFluidLevelPacked1 >> 8) & 0xff;
@@ -40,7 +40,7 @@ layout(location = 0) in vec3 aPos;
 layout(location = 0) noperspective out vec2 vTexCoords;
 layout(location = 1) flat out uvec4  block1;
 layout(location = 2) flat out uvec4  block2;
-layout(location = 3) flat out uvec4  block3;
+layout(location = 3) flat out uvec3  block3;
 
 uniform uvec3 uWorldSize;
 uniform mat4 uTransform;
@@ -50,10 +50,8 @@ uniform uvec3 uRenderMax;
 
 // DO NOT CHANGE, must match game internal layout
 struct TileData {
-	// TF_ flags 0:32
+	// TF_ flags
 	uint flags;
-	// TF_ flags 32:64
-	uint flags2;
 
 	// Sprites are all:
 	// spriteID=0:16, spriteFlags=16:32
@@ -163,7 +161,6 @@ void main()
 	const uint index = tileID(tile);
 
 	uint vFlags = tileData.data[index].flags;
-	uint vFlags2 = tileData.data[index].flags2;
 	uint vLightLevel = ( tileData.data[index].packedLevels >> 8 ) & 0xff;
 	uint vVegetationLevel = ( tileData.data[index].packedLevels >> 16 ) & 0xff;
 
@@ -298,7 +295,7 @@ void main()
 		vTexCoords = vec2( vVertexCoords.x, 1.0 - vVertexCoords.y );
 		block1 = uvec4(floorSprite, jobFloorSprite, wallSprite, jobWallSprite);
 		block2 = uvec4(itemSprite, creatureSprite, vFluidLevelPacked1, uIsWall);
-		block3 = uvec4(vFlags, vFlags2, vLightLevel, vVegetationLevel);
+		block3 = uvec3(vFlags, vLightLevel, vVegetationLevel);
 
 		vec3 worldPos = project( rotate( tile ), vVertexCoords.xy, uIsWall );
 		gl_Position = uTransform * vec4( worldPos, 1.0 );
@@ -2,10 +2,8 @@
 
 // DO NOT CHANGE, must match game internal layout
 struct TileData {
-	// TF_ flags 0:32
+	// TF_ flags
 	uint flags;
-	// TF_ flags 32:64
-	uint flags2;
 
 	// Sprites are all:
 	// spriteID=0:16, spriteFlags=16:32
@@ -22,9 +22,14 @@
 #include "db.h"
 
 #include "../base/config.h"
+#include "../base/io.h"
 #include "../game/item.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
 #include <QMutexLocker>
 #include <QSqlError>
 #include <QSqlField>
@@ -32,6 +37,8 @@
 #include <QSqlRecord>
 #include <QThread>
 
+#include <tuple>
+
 QMutex DB::m_mutex;
 int DB::accessCounter = 0;
 Counter<QString> DB::m_counter;
@@ -41,23 +48,69 @@ QMap<Qt::HANDLE, QSqlDatabase> DB::m_connections;
 QHash<QString, QSharedPointer<DBS::Workshop>> DB::m_workshops;
 QHash<QString, QSharedPointer<DBS::Job>> DB::m_jobs;
 
-/** @brief Initialize the database by loading and executing ingnomia.db.sql
- *         into the in-memory shared-cache SQLite database.
+/** @brief Bumped whenever the snapshot layout changes, so old snapshots get rebuilt. */
+static constexpr int snapshotFormat = 1;
+
+/** @brief How init() got the tables and how long it took, logged together with the struct timing by initStructs(). */
+static QString initSummary;
+
+/** @brief Initialize the in-memory shared-cache SQLite database from ingnomia.db.sql.
  *
- *  Reads the SQL dump file from the configured data path (content/db/),
- *  splits it into individual statements, and executes each one. Must be
- *  called once at application startup before any queries.
+ *  Parsing the SQL dump statement by statement is the slowest part of the startup,
+ *  so the dump is imported once into a snapshot database in the user data folder
+ *  (cache/ingnomia.db) and every later launch copies the tables from there. The
+ *  snapshot is keyed by size and modification time of the dump and rebuilt when
+ *  either changes. If the snapshot can't be written the dump is imported directly.
+ *  Must be called once at application startup before any queries.
  */
 void DB::init()
 {
 	QMutexLocker lock( &DB::m_mutex );
 
-	QFile file( Global::cfg->get( "dataPath" ).toString() + "/db/" + "ingnomia.db.sql" );
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QString sql = file.readAll();
-    file.close();
+	QElapsedTimer timer;
+	timer.start();
+
+	QFileInfo source( Global::cfg->get( "dataPath" ).toString() + "/db/" + "ingnomia.db.sql" );
+	QString snapshot = IO::getDataFolder() + "/cache/ingnomia.db";
+	QString key      = QString( "%1:%2:%3" ).arg( snapshotFormat ).arg( source.size() ).arg( source.lastModified().toMSecsSinceEpoch() );
+
+	if ( restoreSnapshot( snapshot, key ) )
+	{
+		initSummary = QString( "restored snapshot in %1 ms" ).arg( timer.elapsed() );
+		return;
+	}
+
+	qint64 buildTime = 0;
+	if ( buildSnapshot( source.filePath(), snapshot, key ) )
+	{
+		buildTime = timer.restart();
+		if ( restoreSnapshot( snapshot, key ) )
+		{
+			initSummary = QString( "built snapshot in %1 ms, restored in %2 ms" ).arg( buildTime ).arg( timer.elapsed() );
+			return;
+		}
+	}
+	importDump( getDB(), source.filePath() );
+	initSummary = QString( "no snapshot, imported %1 in %2 ms" ).arg( source.fileName() ).arg( timer.elapsed() );
+}
+
+/** @brief Executes every statement of a SQL dump file on a connection.
+ *  @param db Connection to import into.
+ *  @param path Path of the SQL dump.
+ *  @return False if the file couldn't be read.
+ */
+bool DB::importDump( QSqlDatabase& db, QString path )
+{
+	QFile file( path );
+	if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+	{
+		qDebug() << "Error: can't read" << path;
+		return false;
+	}
+	QString sql = file.readAll();
+	file.close();
 
-	QSqlQuery destQuery( getDB() );
+	QSqlQuery destQuery( db );
 
 	auto statements = sql.split( ";" );
 	for( auto s: statements )
@@ -70,16 +123,172 @@ void DB::init()
 			qDebug() << destQuery.lastError();
 		}
 	}
+	return true;
+}
+
+/** @brief Imports the SQL dump into a new snapshot database file.
+ *
+ *  The snapshot is written next to its final path and renamed when complete,
+ *  a crash halfway through never leaves a truncated snapshot behind.
+ *
+ *  @param source Path of the SQL dump.
+ *  @param path Path of the snapshot file.
+ *  @param key Version key stored in the snapshot's _Snapshot table.
+ *  @return True if the snapshot was written.
+ */
+bool DB::buildSnapshot( QString source, QString path, QString key )
+{
+	QDir().mkpath( QFileInfo( path ).absolutePath() );
+	QString tmpPath = path + ".tmp";
+	QFile::remove( tmpPath );
+
+	bool ok = false;
+	{
+		auto db = QSqlDatabase::addDatabase( "QSQLITE", "snapshot" );
+		db.setDatabaseName( tmpPath );
+		if ( db.open() )
+		{
+			QSqlQuery query( db );
+			// a half written file is thrown away anyway
+			query.exec( "PRAGMA journal_mode = OFF" );
+			query.exec( "PRAGMA synchronous = OFF" );
+
+			ok = importDump( db, source );
+			ok = ok && query.exec( "CREATE TABLE _Snapshot ( Key TEXT )" );
+			ok = ok && query.prepare( "INSERT INTO _Snapshot VALUES ( ? )" );
+			if ( ok )
+			{
+				query.addBindValue( key );
+				ok = query.exec();
+			}
+			if ( !ok )
+			{
+				qDebug() << "Error: build db snapshot" << query.lastError();
+			}
+			query.finish();
+			db.close();
+		}
+	}
+	QSqlDatabase::removeDatabase( "snapshot" );
+
+	ok = ok && ( !QFile::exists( path ) || QFile::remove( path ) ) && QFile::rename( tmpPath, path );
+	if ( !ok )
+	{
+		QFile::remove( tmpPath );
+	}
+	return ok;
+}
+
+/** @brief Copies all tables of a snapshot database into the in-memory database.
+ *
+ *  The snapshot is attached to the in-memory connection and every table is
+ *  recreated from its schema and filled with a single INSERT ... SELECT inside
+ *  one transaction. Row IDs are copied explicitly since item and material UIDs
+ *  are the row IDs of the Items and Materials tables. Indexes, views and triggers
+ *  are recreated from their schema after the tables, so the restored database
+ *  matches the imported dump.
+ *
+ *  @param path Path of the snapshot file.
+ *  @param key Version key the snapshot has to match.
+ *  @return False if the snapshot is missing, stale or couldn't be copied.
+ */
+bool DB::restoreSnapshot( QString path, QString key )
+{
+	if ( !QFile::exists( path ) )
+	{
+		return false;
+	}
+	QSqlQuery query( getDB() );
+	query.prepare( "ATTACH DATABASE ? AS snapshot" );
+	query.addBindValue( path );
+	if ( !query.exec() )
+	{
+		qDebug() << "Error: attach db snapshot" << query.lastError();
+		return false;
+	}
+
+	bool ok = query.exec( "SELECT Key FROM snapshot._Snapshot" ) && query.next() && query.value( 0 ).toString() == key;
+
+	// indexes, views and triggers refer to tables, so they are created after all tables are filled
+	QList<QPair<QString, QString>> tables;
+	QList<std::tuple<QString, QString, QString>> others;
+	if ( ok && query.exec( "SELECT type, name, sql FROM snapshot.sqlite_master WHERE name NOT LIKE 'sqlite_%' AND name <> '_Snapshot' AND sql IS NOT NULL" ) )
+	{
+		while ( query.next() )
+		{
+			const QString type = query.value( 0 ).toString();
+			if ( type == "table" )
+			{
+				tables.append( { query.value( 1 ).toString(), query.value( 2 ).toString() } );
+			}
+			else
+			{
+				others.append( { type, query.value( 1 ).toString(), query.value( 2 ).toString() } );
+			}
+		}
+	}
+	ok = ok && !tables.isEmpty() && query.exec( "BEGIN TRANSACTION" );
+	if ( ok )
+	{
+		for ( const auto& table : tables )
+		{
+			const QString name = "\"" + table.first + "\"";
+
+			QStringList columns;
+			bool hasRowidAlias = false;
+			ok = query.exec( "PRAGMA snapshot.table_info(" + name + ")" );
+			while ( ok && query.next() )
+			{
+				columns.append( "\"" + query.value( "name" ).toString() + "\"" );
+				if ( query.value( "pk" ).toInt() > 0 && query.value( "type" ).toString().compare( "INTEGER", Qt::CaseInsensitive ) == 0 )
+				{
+					hasRowidAlias = true;
+				}
+			}
+			if ( !hasRowidAlias )
+			{
+				columns.prepend( "rowid" );
+			}
+			const QString columnList = columns.join( ", " );
+
+			ok = ok && query.exec( "DROP TABLE IF EXISTS main." + name );
+			ok = ok && query.exec( table.second );
+			ok = ok && query.exec( "INSERT INTO main." + name + " ( " + columnList + " ) SELECT " + columnList + " FROM snapshot." + name );
+			if ( !ok )
+			{
+				qDebug() << "Error: restore db snapshot table" << table.first << query.lastError();
+				break;
+			}
+		}
+		for ( auto it = others.cbegin(); ok && it != others.cend(); ++it )
+		{
+			const auto& [type, name, sql] = *it;
+			ok = query.exec( "DROP " + type.toUpper() + " IF EXISTS main.\"" + name + "\"" );
+			ok = ok && query.exec( sql );
+			if ( !ok )
+			{
+				qDebug() << "Error: restore db snapshot" << type << name << query.lastError();
+			}
+		}
+		query.exec( ok ? "COMMIT" : "ROLLBACK" );
+	}
+	query.finish();
+	query.exec( "DETACH DATABASE snapshot" );
+	return ok;
 }
 
 /** @brief Pre-load Workshop and Job records from the database into cached
  *         QHash maps for fast lookup.
  *
  *  Populates m_workshops and m_jobs by querying the Workshops, Workshops_Components,
- *  Jobs, Jobs_Tasks, and Jobs_SpriteID tables. Should be called after init().
+ *  Jobs, Jobs_Tasks, and Jobs_SpriteID tables. Should be called after init(), logs
+ *  the startup time of both in one line.
  */
 void DB::initStructs()
 {
+	QElapsedTimer timer;
+	timer.start();
+
 	m_workshops.clear();
 	auto rows = DB::selectRows( "Workshops" );
 	for( const auto& row : rows )
@@ -133,7 +342,7 @@ void DB::initStructs()
 		{
 			job->WorkPositions.append( Position( spos ) );
 		}
-		auto trows = DB::selectRows( "Jobs_Tasks" );
+		auto trows = DB::selectRows( "Jobs_Tasks", job->ID );
 		for( const auto& trow : trows )
 		{
 			DBS::Job_Task jt;
@@ -144,7 +353,7 @@ void DB::initStructs()
 			jt.Task = trow.value( "Task" ).toString();
 			job->tasks.append( jt );
 		}
-		auto srows = DB::selectRows( "Jobs_SpriteID" );
+		auto srows = DB::selectRows( "Jobs_SpriteID", job->ID );
 		for( const auto& srow : srows )
 		{
 			DBS::Job_SpriteID js;
@@ -156,6 +365,11 @@ void DB::initStructs()
 		}
 		m_jobs.insert( job->ID, job );
 	}
+	if ( !initSummary.isEmpty() )
+	{
+		qDebug().noquote() << "DB:" << initSummary << "| built workshop and job structs in" << timer.elapsed() << "ms";
+		initSummary.clear();
+	}
 }
 
 /** @brief Get or create a per-thread QSqlDatabase connection.
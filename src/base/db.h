@@ -91,6 +91,9 @@ class DB
 
 private:
 	static QSqlDatabase& getDB();
+	static bool importDump( QSqlDatabase& db, QString path );
+	static bool buildSnapshot( QString source, QString path, QString key );
+	static bool restoreSnapshot( QString path, QString key );
 
 	static QMutex m_mutex;                       ///< Mutex protecting all DB operations.
 	static int accessCounter;                    ///< Total DB access count (reset on read).
@@ -141,6 +141,7 @@ void Filter::update()
 	}
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Adds a single item-material pair into the filter hierarchy.
@@ -154,6 +155,7 @@ void Filter::addItem( QString category, QString group, QString item, QString mat
 	m_categories[category].addItem( group, item, material );
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Returns the list of all category SIDs currently in the filter.
@@ -203,6 +205,7 @@ void Filter::setCheckState( QString category, bool state )
 	m_categories[category].setCheckState( state );
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Sets the checked state for a specific group within a category.
@@ -215,6 +218,7 @@ void Filter::setCheckState( QString category, QString group, bool state )
 	m_categories[category].setCheckState( group, state );
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Sets the checked state for a specific item within a category and group.
@@ -228,6 +232,7 @@ void Filter::setCheckState( QString category, QString group, QString item, bool
 	m_categories[category].setCheckState( group, item, state );
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Sets the checked state for a single item-material combination.
@@ -243,6 +248,7 @@ void Filter::setCheckState( QString category, QString group, QString item, QStri
 	m_categories[category].setCheckState( group, item, material, state );
 	m_activeDirty       = true;
 	m_activeSimpleDirty = true;
+	++m_revision;
 }
 
 /** @brief Queries the checked state of a specific item-material combination.
@@ -119,11 +119,18 @@ class Filter
 
 	void update();
 
+	/** @brief Counter that changes whenever the set of active entries may have changed. */
+	unsigned int revision() const
+	{
+		return m_revision;
+	}
+
 private:
 	QMap<QString, FilterCategory> m_categories;
 
 	bool m_activeDirty       = true;
 	bool m_activeSimpleDirty = true;
+	unsigned int m_revision  = 0;
 	QSet<QPair<QString, QString>> m_active;
 	QSet<QString> m_activeSimple;
 };
@@ -24,6 +24,7 @@
 
 #include "gamestate.h"
 #include "../base/db.h"
+#include "../base/rng.h"
 
 #include <QDebug>
 #include <QDir>
@@ -198,6 +199,7 @@ void GameState::serialize( QVariantMap& out )
 	out.insert( "riverSize", riverSize );
 	out.insert( "rivers", rivers );
 	out.insert( "seed", seed );
+	RNG::serialize( out );
 
 	out.insert( "startingItems", startingItems );
 
@@ -360,6 +362,11 @@ void GameState::load( QVariantMap& vals )
 	riverSize    = tmp.value( "riverSize" ).toInt();
 	rivers       = tmp.value( "rivers" ).toInt();
 	seed         = tmp.value( "seed" ).toString();
+	if ( !RNG::load( tmp ) )
+	{
+		// saves from before the rng service, derive the streams from world seed and tick
+		RNG::seed( qHash( seed ) ^ tick );
+	}
 
 	startingItems = tmp.value( "startingItems" ).toList();
 
@@ -32,6 +32,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/position.h"
+#include "../base/schema.h"
 #include "../base/util.h"
 #include "../game/creaturemanager.h"
 #include "../game/eventmanager.h"
@@ -65,9 +66,19 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <QRandomGenerator>
 #include <QSaveFile>
 #include <QStandardPaths>
-
+#include <QtEndian>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 /** @brief Constructs the IO handler.
@@ -228,7 +239,8 @@ bool IO::loadOriginalConfig( QJsonDocument& jd )
  *
  *  Creates a save folder named after the kingdom. For manual saves, increments a
  *  numbered slot; for autosaves, uses an "autosave" subfolder. Existing folders are
- *  backed up and removed after a successful save. Serializes world, sprites, game
+ *  backed up and removed after a successful save, their world files are carried
+ *  over so only changed levels get written, see saveWorld(). Serializes world, sprites, game
  *  state, config, items, constructions, stockpiles, jobs, gnomes, monsters, plants,
  *  animals, farms, workshops, rooms, doors, item history, events, mechanisms, and pipes.
  *
@@ -304,7 +316,7 @@ QString IO::save( bool autosave )
 	
 	folder += "/";
 
-	IO::saveWorld( folder );
+	IO::saveWorld( folder, oldFolder.isEmpty() ? QString() : oldFolder + "/" );
 	IO::saveFile( folder + "sprites.json", IO::jsonArraySprites() );
 	IO::saveFile( folder + "game.json", IO::jsonArrayGame() );
 	IO::saveFile( folder + "config.json", IO::jsonArrayConfig() );
@@ -348,12 +360,67 @@ QString IO::save( bool autosave )
 	return folder;
 }
 
+/** @brief Items decoded from items.bin. */
+struct ItemFile
+{
+	enum Status
+	{
+		Missing,
+		Damaged,
+		Loaded
+	};
+	Status status = Missing;
+	std::vector<Item> items;
+};
+
+static ItemFile readItemFile( QString folder );
+
+/** @brief Starts reading and parsing every JSON file of a save folder on worker threads.
+ *  @param folder Path to the save folder (must end with '/').
+ */
+void IO::prefetchDocuments( const QString& folder )
+{
+	m_documents.clear();
+	for ( const auto& name : QDir( folder ).entryList( { "*.json" }, QDir::Files ) )
+	{
+		const QString url = folder + name;
+		m_documents.insert( url, std::async( std::launch::async, [url]() {
+									 QJsonDocument jd;
+									 loadFile( url, jd );
+									 return jd;
+								 } ).share() );
+	}
+}
+
+/** @brief Returns a JSON file of the save being loaded, waiting for its worker if it is still parsing.
+ *
+ *  Files that weren't prefetched are loaded right away. A document is handed out once.
+ *
+ *  @param url Path of the JSON file.
+ *  @return The parsed document, empty if the file is missing or broken.
+ */
+QJsonDocument IO::document( const QString& url )
+{
+	auto it = m_documents.find( url );
+	if ( it == m_documents.end() )
+	{
+		QJsonDocument jd;
+		loadFile( url, jd );
+		return jd;
+	}
+	QJsonDocument jd = it.value().get();
+	m_documents.erase( it );
+	return jd;
+}
+
 /** @brief Loads an entire game state from the given save folder.
  *
  *  Deserializes all game data in dependency order: game state, sprites, world grid,
  *  items, constructions, jobs, workshops, farms, stockpiles, mechanisms, pipes,
  *  gnomes, monsters, plants, animals, rooms, doors, item history, events, and config.
- *  Runs sanitize() at the end to fix up any inconsistencies.
+ *  The JSON files and items.bin are read and parsed on worker threads while the
+ *  earlier steps run, see prefetchDocuments(). Runs sanitize() at the end to fix
+ *  up any inconsistencies.
  *
  *  @param folder Path to the save game folder to load from.
  *  @return True if loading succeeded, false if the world file could not be read.
@@ -370,64 +437,72 @@ bool IO::load( QString folder )
 
 	IO::version = versionInt( folder );
 
+	// files are read and parsed on worker threads, the game state is rebuilt
+	// on this thread in dependency order and each step waits for its own file only
+	prefetchDocuments( folder );
+	std::future<ItemFile> itemFile = std::async( std::launch::async, readItemFile, folder );
+
 	QJsonDocument jd;
 
-	loadFile( folder + "game.json", jd );
+	jd = document( folder + "game.json" );
 	IO::loadGame( jd );
 
 	Global::util->initAllowedInContainer();
 
-	loadFile( folder + "sprites.json", jd );
+	jd = document( folder + "sprites.json" );
 	IO::loadSprites( jd );
 	emit signalStatus( "Start loading world.." );
 	if ( !IO::loadWorld( folder ) )
 	{
+		m_documents.clear();
 		return false;
 	}
 	g->w()->afterLoad();
 	emit signalStatus( "Loading world done" );
-	IO::loadItems( folder );
+	ItemFile items = itemFile.get();
+	IO::loadItems( folder, items );
 	emit signalStatus( "Loading items done" );
-	loadFile( folder + "floorconstructions.json", jd );
+	jd = document( folder + "floorconstructions.json" );
 	IO::loadFloorConstructions( jd );
-	loadFile( folder + "wallconstructions.json", jd );
+	jd = document( folder + "wallconstructions.json" );
 	IO::loadWallConstructions( jd );
 	emit signalStatus( "Loading constructions done" );
-	loadFile( folder + "jobs.json", jd );
+	jd = document( folder + "jobs.json" );
 	IO::loadJobs( jd );
-	loadFile( folder + "jobsprites.json", jd );
+	jd = document( folder + "jobsprites.json" );
 	IO::loadJobSprites( jd );
 	emit signalStatus( "Loading jobs done" );
-	loadFile( folder + "workshops.json", jd );
+	jd = document( folder + "workshops.json" );
 	IO::loadWorkshops( jd );
-	loadFile( folder + "farms.json", jd );
+	jd = document( folder + "farms.json" );
 	IO::loadFarms( jd );
-	loadFile( folder + "stockpiles.json", jd );
+	jd = document( folder + "stockpiles.json" );
 	IO::loadStockpiles( jd );
-	loadFile( folder + "mechanisms.json", jd );
+	jd = document( folder + "mechanisms.json" );
 	IO::loadMechanisms( jd );
-	loadFile( folder + "pipes.json", jd );
+	jd = document( folder + "pipes.json" );
 	IO::loadPipes( jd );
 	// anything that has local jobs needs to be loaded before this
-	loadFile( folder + "gnomes.json", jd );
+	jd = document( folder + "gnomes.json" );
 	IO::loadGnomes( jd );
-	loadFile( folder + "monsters.json", jd );
 	IO::loadMonsters( folder );
 	IO::loadPlants( folder );
 	IO::loadAnimals( folder );
 	emit signalStatus( "Loading gnomes, plants and animals done" );
-	loadFile( folder + "rooms.json", jd );
+	jd = document( folder + "rooms.json" );
 	IO::loadRooms( jd );
-	loadFile( folder + "doors.json", jd );
+	jd = document( folder + "doors.json" );
 	IO::loadDoors( jd );
-	loadFile( folder + "itemhistory.json", jd );
+	jd = document( folder + "itemhistory.json" );
 	IO::loadItemHistory( jd );
-	loadFile( folder + "events.json", jd );
+	jd = document( folder + "events.json" );
 	IO::loadEvents( jd );
 
-	loadFile( folder + "config.json", jd );
+	jd = document( folder + "config.json" );
 	IO::loadConfig( jd );
 
+	m_documents.clear();
+
 	sanitize();
 
 	qDebug() << "loading game took: " + QString::number( timer.elapsed() ) + " ms";
@@ -483,7 +558,7 @@ void IO::sanitize()
 			const auto job = item.isInJob();
 			if ( job && !legacyJobs.count( job ) && !g->jm()->getJob( job ) )
 			{
-				item.setInJob( 0 );
+				g->inv()->setInJob( item.id(), 0 );
 				qWarning() << "item " + QString::number( item.id() ) + " " + item.itemSID() + " had illegal job";
 			}
 			const bool carried = 0 != carriedItems.count( item.id() );
@@ -656,6 +731,8 @@ bool IO::loadGame( QJsonDocument& jd )
 	{
 		auto map = doc.first().toMap();
 		GameState::load( map );
+		// the UID tables were replaced, names cached by UID are stale
+		S::clearUIDNames();
 	}
 
 	for ( const auto& vMat : GameState::addedMaterials )
@@ -673,53 +750,657 @@ bool IO::loadGame( QJsonDocument& jd )
 	return true;
 }
 
+/** @brief Magic at the start of a chunked world.dat.
+ *
+ *  Legacy files start with the high half of a big-endian quint64 tile flag
+ *  value, which is always 0, so they can never begin with the magic.
+ */
+static const char worldFileMagic[4]         = { 'I', 'G', 'W', 'D' };
+static constexpr quint32 worldFileVersion   = 4; ///< Version 4 has the layout of version 3, fingerprints before it used an unstable hash.
+static constexpr int worldFileHeaderSize    = 28; ///< Magic, version, dimX/Y/Z, record size, chunk count, save ID. 20 bytes without save ID before version 3.
+static constexpr int worldFileChunkInfoSize = 28; ///< Payload offset, payload size, tile count, encoding, 3 bytes padding, fingerprint. 20 bytes without fingerprint in version 2, 16 bytes without encoding in version 1.
+static constexpr int worldFileRecordSize    = 32; ///< Bytes per tile in a decoded chunk payload.
+
+/** @brief Magic at the start of world.log, the chunks saved after world.dat was written. */
+static const char worldLogMagic[4]          = { 'I', 'G', 'W', 'L' };
+static constexpr quint32 worldLogVersion    = 1;
+static constexpr int worldLogHeaderSize     = 24;         ///< Magic, version, save ID of the world.dat it belongs to, dimX/Y/Z, 2 bytes padding.
+static constexpr int worldLogRecordSize     = 24;         ///< Chunk index, payload size, tile count, encoding, 3 bytes padding, fingerprint. The payload follows.
+static constexpr quint32 worldLogCommit     = 0xffffffff; ///< Chunk index of the record that closes a save, its tile count is the number of chunks in that save.
+
+/** @brief Layout of a chunk payload. Version 1 files only use WCE_RECORDS, compressed or not.
+ *
+ *  The encodings only exist in the file. Loading expands every chunk into the
+ *  dense tile array of World, uniform air and rock levels included.
+ */
+enum WorldChunkEncoding : quint8
+{
+	WCE_RECORDS    = 0,   ///< One record per tile.
+	WCE_UNIFORM    = 1,   ///< A single record shared by every tile of the chunk.
+	WCE_PALETTE8   = 2,   ///< Record count, the distinct records, then an 8 bit palette index per tile.
+	WCE_PALETTE16  = 3,   ///< Same as WCE_PALETTE8 with 16 bit indices.
+	WCE_COMPRESSED = 0x80 ///< Flag, the payload is zlib compressed.
+};
+
+/** @brief Writes a tile as a little-endian world file record. The light level is not saved. */
+static void encodeTile( const Tile& tile, uchar* out )
+{
+	qToLittleEndian<quint32>( (quint32)tile.flags, out );
+	qToLittleEndian<quint16>( tile.wallType, out + 4 );
+	out[6]  = tile.floorType;
+	out[7]  = tile.fluidLevel;
+	out[8]  = tile.pressure;
+	out[9]  = tile.flow;
+	out[10] = tile.vegetationLevel;
+	out[11] = 0;
+	qToLittleEndian<quint16>( tile.floorMaterial, out + 12 );
+	qToLittleEndian<quint16>( tile.wallMaterial, out + 14 );
+	qToLittleEndian<quint16>( tile.embeddedMaterial, out + 16 );
+	out[18] = tile.floorRotation;
+	out[19] = tile.wallRotation;
+	qToLittleEndian<quint32>( tile.wallSpriteUID, out + 20 );
+	qToLittleEndian<quint32>( tile.floorSpriteUID, out + 24 );
+	qToLittleEndian<quint32>( tile.itemSpriteUID, out + 28 );
+}
+
+/** @brief Reads a tile from a little-endian world file record. */
+static void decodeTile( const uchar* in, Tile& tile )
+{
+	tile.flags            = (TileFlag)qFromLittleEndian<quint32>( in );
+	tile.wallType         = (WallType)qFromLittleEndian<quint16>( in + 4 );
+	tile.floorType        = (FloorType)in[6];
+	tile.fluidLevel       = in[7];
+	tile.pressure         = in[8];
+	tile.flow             = (WaterFlow)in[9];
+	tile.vegetationLevel  = in[10];
+	tile.lightLevel       = 0;
+	tile.floorMaterial    = qFromLittleEndian<quint16>( in + 12 );
+	tile.wallMaterial     = qFromLittleEndian<quint16>( in + 14 );
+	tile.embeddedMaterial = qFromLittleEndian<quint16>( in + 16 );
+	tile.floorRotation    = in[18];
+	tile.wallRotation     = in[19];
+	tile.wallSpriteUID    = qFromLittleEndian<quint32>( in + 20 );
+	tile.floorSpriteUID   = qFromLittleEndian<quint32>( in + 24 );
+	tile.itemSpriteUID    = qFromLittleEndian<quint32>( in + 28 );
+}
+
+/** @brief Writes a run of tiles as world file records. */
+static QByteArray encodeRecords( const Tile* tiles, size_t numTiles )
+{
+	QByteArray raw( numTiles * worldFileRecordSize, Qt::Uninitialized );
+	uchar* out = reinterpret_cast<uchar*>( raw.data() );
+	for ( size_t i = 0; i < numTiles; ++i, out += worldFileRecordSize )
+	{
+		encodeTile( tiles[i], out );
+	}
+	return raw;
+}
+
+/** @brief XXH64 of a byte range, a fixed algorithm so fingerprints stay valid across Qt versions and platforms. */
+static quint64 xxHash64( const uchar* data, size_t size, quint64 seed )
+{
+	constexpr quint64 prime1 = 0x9E3779B185EBCA87ull;
+	constexpr quint64 prime2 = 0xC2B2AE3D27D4EB4Full;
+	constexpr quint64 prime3 = 0x165667B19E3779F9ull;
+	constexpr quint64 prime4 = 0x85EBCA77C2B2AE63ull;
+	constexpr quint64 prime5 = 0x27D4EB2F165667C5ull;
+
+	const auto rotl  = []( quint64 v, int r ) { return ( v << r ) | ( v >> ( 64 - r ) ); };
+	const auto round = [&rotl]( quint64 acc, quint64 input ) { return rotl( acc + input * prime2, 31 ) * prime1; };
+	const auto merge = [&round]( quint64 acc, quint64 v ) { return ( acc ^ round( 0, v ) ) * prime1 + prime4; };
+
+	const uchar* const end = data + size;
+	quint64 hash;
+	if ( size >= 32 )
+	{
+		quint64 v1 = seed + prime1 + prime2;
+		quint64 v2 = seed + prime2;
+		quint64 v3 = seed;
+		quint64 v4 = seed - prime1;
+		for ( ; data + 32 <= end; data += 32 )
+		{
+			v1 = round( v1, qFromLittleEndian<quint64>( data ) );
+			v2 = round( v2, qFromLittleEndian<quint64>( data + 8 ) );
+			v3 = round( v3, qFromLittleEndian<quint64>( data + 16 ) );
+			v4 = round( v4, qFromLittleEndian<quint64>( data + 24 ) );
+		}
+		hash = rotl( v1, 1 ) + rotl( v2, 7 ) + rotl( v3, 12 ) + rotl( v4, 18 );
+		hash = merge( merge( merge( merge( hash, v1 ), v2 ), v3 ), v4 );
+	}
+	else
+	{
+		hash = seed + prime5;
+	}
+	hash += size;
+
+	for ( ; data + 8 <= end; data += 8 )
+	{
+		hash = rotl( hash ^ round( 0, qFromLittleEndian<quint64>( data ) ), 27 ) * prime1 + prime4;
+	}
+	if ( data + 4 <= end )
+	{
+		hash = rotl( hash ^ ( qFromLittleEndian<quint32>( data ) * prime1 ), 23 ) * prime2 + prime3;
+		data += 4;
+	}
+	for ( ; data < end; ++data )
+	{
+		hash = rotl( hash ^ ( *data * prime5 ), 11 ) * prime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+/** @brief Fingerprint of a chunk's records, saves only write chunks whose fingerprint changed. */
+static quint64 chunkFingerprint( const QByteArray& raw )
+{
+	return xxHash64( reinterpret_cast<const uchar*>( raw.constData() ), raw.size(), 0 );
+}
+
+/** @brief Encodes a chunk's records into the smallest chunk payload.
+ *
+ *  Levels of untouched air or rock collapse to a single record. Levels with few
+ *  distinct tiles, which is nearly every level away from the surface, store a
+ *  palette and one index per tile. Everything but uniform chunks is zlib
+ *  compressed on top if that saves space.
+ *
+ *  @param raw The chunk's records, see encodeRecords().
+ *  @param numTiles Number of tiles in the chunk.
+ *  @param[out] payload Encoded payload.
+ *  @return The WorldChunkEncoding of the payload.
+ */
+static quint8 encodeChunk( const QByteArray& raw, size_t numTiles, QByteArray& payload )
+{
+	std::unordered_map<std::string_view, quint16> palette;
+	std::vector<quint16> indices( numTiles );
+	bool fits = true;
+	for ( size_t i = 0; i < numTiles; ++i )
+	{
+		auto it    = palette.try_emplace( std::string_view( raw.constData() + i * worldFileRecordSize, worldFileRecordSize ), (quint16)palette.size() ).first;
+		indices[i] = it->second;
+		if ( palette.size() > 0x10000 )
+		{
+			fits = false;
+			break;
+		}
+	}
+
+	quint8 encoding = WCE_RECORDS;
+	if ( palette.size() == 1 )
+	{
+		payload = raw.left( worldFileRecordSize );
+		return WCE_UNIFORM;
+	}
+	const bool wide           = palette.size() > 0x100;
+	const size_t paletteBytes = 4 + palette.size() * worldFileRecordSize + numTiles * ( wide ? 2 : 1 );
+	if ( fits && paletteBytes < (size_t)raw.size() )
+	{
+		payload = QByteArray( paletteBytes, Qt::Uninitialized );
+		uchar* out = reinterpret_cast<uchar*>( payload.data() );
+		qToLittleEndian<quint32>( palette.size(), out );
+		for ( const auto& entry : palette )
+		{
+			memcpy( out + 4 + entry.second * worldFileRecordSize, entry.first.data(), worldFileRecordSize );
+		}
+		out += 4 + palette.size() * worldFileRecordSize;
+		for ( size_t i = 0; i < numTiles; ++i )
+		{
+			if ( wide )
+			{
+				qToLittleEndian<quint16>( indices[i], out + 2 * i );
+			}
+			else
+			{
+				out[i] = (uchar)indices[i];
+			}
+		}
+		encoding = wide ? WCE_PALETTE16 : WCE_PALETTE8;
+	}
+	else
+	{
+		payload = raw;
+	}
+
+	QByteArray packed = qCompress( payload, 1 );
+	if ( packed.size() < payload.size() )
+	{
+		payload = packed;
+		encoding |= WCE_COMPRESSED;
+	}
+	return encoding;
+}
+
+/** @brief Decodes a chunk payload written by encodeChunk().
+ *  @return False if the payload doesn't decode to exactly @p numTiles tiles.
+ */
+static bool decodeChunk( const uchar* in, qsizetype size, quint8 encoding, Tile* tiles, quint32 numTiles )
+{
+	QByteArray unpacked;
+	if ( encoding & WCE_COMPRESSED )
+	{
+		unpacked = qUncompress( in, size );
+		in       = reinterpret_cast<const uchar*>( unpacked.constData() );
+		size     = unpacked.size();
+	}
+
+	switch ( encoding & ~WCE_COMPRESSED )
+	{
+		case WCE_RECORDS:
+			if ( size != (qsizetype)numTiles * worldFileRecordSize )
+			{
+				return false;
+			}
+			for ( quint32 i = 0; i < numTiles; ++i, in += worldFileRecordSize )
+			{
+				decodeTile( in, tiles[i] );
+			}
+			return true;
+		case WCE_UNIFORM:
+		{
+			if ( size != worldFileRecordSize )
+			{
+				return false;
+			}
+			Tile tile;
+			decodeTile( in, tile );
+			std::fill( tiles, tiles + numTiles, tile );
+			return true;
+		}
+		case WCE_PALETTE8:
+		case WCE_PALETTE16:
+		{
+			const int width = ( encoding & ~WCE_COMPRESSED ) == WCE_PALETTE16 ? 2 : 1;
+			if ( size < 4 )
+			{
+				return false;
+			}
+			const quint32 count = qFromLittleEndian<quint32>( in );
+			if ( count > 0x10000 || size != 4 + (qsizetype)count * worldFileRecordSize + (qsizetype)numTiles * width )
+			{
+				return false;
+			}
+			std::vector<Tile> palette( count );
+			in += 4;
+			for ( auto& tile : palette )
+			{
+				decodeTile( in, tile );
+				in += worldFileRecordSize;
+			}
+			for ( quint32 i = 0; i < numTiles; ++i )
+			{
+				const quint32 index = width == 2 ? qFromLittleEndian<quint16>( in + 2 * i ) : in[i];
+				if ( index >= count )
+				{
+					return false;
+				}
+				tiles[i] = palette[index];
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+/** @brief Runs @p work( chunk ) for every chunk index on all cores. */
+template <class F>
+static void forEachChunk( int numChunks, F work )
+{
+	std::atomic<int> nextChunk( 0 );
+	const int numWorkers = qBound( 1, (int)std::thread::hardware_concurrency(), qMax( 1, numChunks ) );
+
+	std::vector<std::future<void>> tasks;
+	for ( int i = 0; i < numWorkers; ++i )
+	{
+		tasks.emplace_back( std::async( std::launch::async, [&nextChunk, numChunks, &work]() {
+			for ( int c = nextChunk++; c < numChunks; c = nextChunk++ )
+			{
+				work( c );
+			}
+		} ) );
+	}
+	for ( auto& task : tasks )
+	{
+		task.get();
+	}
+}
+
+/** @brief A chunk payload in world.dat or world.log. */
+struct WorldChunkInfo
+{
+	quint64 offset      = 0;
+	quint32 size        = 0;
+	quint32 numTiles    = 0;
+	quint8 encoding     = WCE_RECORDS;
+	quint64 fingerprint = 0;
+};
+
+/** @brief Reads the chunks of every complete save in a world.log.
+ *
+ *  Records only count once the commit record of their save was written, the
+ *  tail of a save that was interrupted is ignored.
+ *
+ *  @param data The log file.
+ *  @param size Size of the log file.
+ *  @param saveID Save ID of the world.dat the log has to belong to.
+ *  @param numChunks Number of chunks in world.dat.
+ *  @param[out] chunks Latest payload per chunk index, chunks without one keep offset 0.
+ *  @return End of the last complete save, 0 if the log doesn't belong to the world file.
+ */
+static qint64 readWorldLog( const uchar* data, qint64 size, quint64 saveID, quint32 numChunks, std::vector<WorldChunkInfo>& chunks )
+{
+	if ( size < worldLogHeaderSize || memcmp( data, worldLogMagic, 4 ) != 0 ||
+		 qFromLittleEndian<quint32>( data + 4 ) != worldLogVersion ||
+		 qFromLittleEndian<quint64>( data + 8 ) != saveID ||
+		 qFromLittleEndian<quint16>( data + 16 ) != Global::dimX ||
+		 qFromLittleEndian<quint16>( data + 18 ) != Global::dimY ||
+		 qFromLittleEndian<quint16>( data + 20 ) != Global::dimZ )
+	{
+		return 0;
+	}
+	chunks.assign( numChunks, WorldChunkInfo() );
+
+	std::vector<std::pair<quint32, WorldChunkInfo>> pending;
+	qint64 committed = worldLogHeaderSize;
+	qint64 pos       = worldLogHeaderSize;
+	while ( pos + worldLogRecordSize <= size )
+	{
+		const uchar* record = data + pos;
+		const quint32 chunk = qFromLittleEndian<quint32>( record );
+		WorldChunkInfo info;
+		info.offset      = pos + worldLogRecordSize;
+		info.size        = qFromLittleEndian<quint32>( record + 4 );
+		info.numTiles    = qFromLittleEndian<quint32>( record + 8 );
+		info.encoding    = record[12];
+		info.fingerprint = qFromLittleEndian<quint64>( record + 16 );
+		if ( chunk == worldLogCommit )
+		{
+			if ( info.size != 0 || info.numTiles != pending.size() )
+			{
+				break;
+			}
+			for ( const auto& entry : pending )
+			{
+				chunks[entry.first] = entry.second;
+			}
+			pending.clear();
+			pos       = info.offset;
+			committed = pos;
+			continue;
+		}
+		if ( chunk >= numChunks || info.size > size - info.offset )
+		{
+			break;
+		}
+		pending.emplace_back( chunk, info );
+		pos = info.offset + info.size;
+	}
+	return committed;
+}
+
+/** @brief What a save folder holds of the world: world.dat and the complete part of world.log. */
+struct WorldFileState
+{
+	quint64 saveID = 0;
+	qint64 baseSize = 0;
+	qint64 logSize  = 0; ///< End of the last complete save in world.log, 0 if there is no log.
+	std::vector<quint64> fingerprints; ///< Latest fingerprint per chunk.
+};
+
+/** @brief Reads the chunk fingerprints of the world files in @p folder.
+ *  @return False if there is no world.dat, or one that predates stable fingerprints or doesn't match the world size.
+ */
+static bool readWorldFileState( const QString& folder, quint32 numChunks, WorldFileState& state )
+{
+	QFile base( folder + "world.dat" );
+	if ( !base.open( QIODevice::ReadOnly ) )
+	{
+		return false;
+	}
+	const QByteArray head = base.read( worldFileHeaderSize + (qint64)numChunks * worldFileChunkInfoSize );
+	const uchar* data     = reinterpret_cast<const uchar*>( head.constData() );
+	if ( head.size() != worldFileHeaderSize + (qint64)numChunks * worldFileChunkInfoSize || memcmp( data, worldFileMagic, 4 ) != 0 ||
+		 qFromLittleEndian<quint32>( data + 4 ) != worldFileVersion ||
+		 qFromLittleEndian<quint16>( data + 8 ) != Global::dimX ||
+		 qFromLittleEndian<quint16>( data + 10 ) != Global::dimY ||
+		 qFromLittleEndian<quint16>( data + 12 ) != Global::dimZ ||
+		 qFromLittleEndian<quint32>( data + 16 ) != numChunks )
+	{
+		return false;
+	}
+	state.saveID   = qFromLittleEndian<quint64>( data + 20 );
+	state.baseSize = base.size();
+	state.fingerprints.resize( numChunks );
+	for ( quint32 c = 0; c < numChunks; ++c )
+	{
+		state.fingerprints[c] = qFromLittleEndian<quint64>( data + worldFileHeaderSize + c * worldFileChunkInfoSize + 20 );
+	}
+
+	QFile log( folder + "world.log" );
+	if ( log.open( QIODevice::ReadOnly ) )
+	{
+		const QByteArray logData = log.readAll();
+		std::vector<WorldChunkInfo> chunks;
+		state.logSize = readWorldLog( reinterpret_cast<const uchar*>( logData.constData() ), logData.size(), state.saveID, numChunks, chunks );
+		for ( quint32 c = 0; c < numChunks && state.logSize; ++c )
+		{
+			if ( chunks[c].offset )
+			{
+				state.fingerprints[c] = chunks[c].fingerprint;
+			}
+		}
+	}
+	return true;
+}
+
+/** @brief Hard-links @p from to @p to, or copies it where the file system has no hard links. */
+static bool linkOrCopy( const QString& from, const QString& to )
+{
+	std::error_code error;
+	std::filesystem::create_hard_link( std::filesystem::path( from.toStdU16String() ), std::filesystem::path( to.toStdU16String() ), error );
+	return !error || QFile::copy( from, to );
+}
+
 /** @brief Saves the world grid to a binary file (world.dat).
  *
- *  Writes every tile's flags, wall/floor type and material, rotations,
- *  fluid level, pressure, flow, vegetation, embedded material, and sprite UIDs
- *  as a compact binary stream.
+ *  The file starts with a header and a chunk table followed by one payload per
+ *  z-level. Tiles are stored as fixed size little-endian records with flags,
+ *  wall/floor type and material, rotations, fluid level, pressure, flow,
+ *  vegetation, embedded material, and sprite UIDs, see encodeChunk() for how
+ *  a level's records are packed. Levels are encoded in parallel.
+ *
+ *  Every chunk carries a fingerprint of its records. If @p previous holds the
+ *  world files of the last save of this game, world.dat is hard-linked into
+ *  @p folder, world.log is copied, and only the chunks whose fingerprint changed
+ *  are appended to the copy, followed by a commit record. The files in
+ *  @p previous are never written, so the backup stays usable until the whole
+ *  save is done. Once the log would grow past world.dat, or if there is nothing
+ *  usable in @p previous, world.dat is written in full and the log is dropped.
  *
  *  @param folder Path to the save folder (must end with '/').
+ *  @param previous Folder of the save this one replaces (must end with '/'), or empty.
  *  @return True on success.
  */
-bool IO::saveWorld( QString folder )
+bool IO::saveWorld( QString folder, QString previous )
 {
 	if ( Global::debugMode )
 		qDebug() << "saveWorld";
-	QFile worldFile( folder + "world.dat" );
-	if ( worldFile.open( QIODevice::WriteOnly ) )
+	QElapsedTimer timer;
+	timer.start();
+
+	const std::vector<Tile>& world = g->w()->world();
+	const size_t levelTiles        = (size_t)Global::dimX * Global::dimY;
+	const int numChunks            = levelTiles ? (int)( ( world.size() + levelTiles - 1 ) / levelTiles ) : 0;
+	const auto chunkTiles          = [&]( int c ) { return qMin( levelTiles, world.size() - c * levelTiles ); };
+
+	WorldFileState state;
+	bool incremental = !previous.isEmpty() && readWorldFileState( previous, numChunks, state );
+
+	std::vector<QByteArray> payloads( numChunks );
+	std::vector<quint8> encodings( numChunks );
+	std::vector<quint64> fingerprints( numChunks );
+	std::vector<char> changed( numChunks, 1 );
+	const auto encode = [&]( int c ) {
+		const QByteArray raw = encodeRecords( world.data() + c * levelTiles, chunkTiles( c ) );
+		fingerprints[c]      = chunkFingerprint( raw );
+		changed[c]           = !incremental || fingerprints[c] != state.fingerprints[c];
+		if ( changed[c] )
+		{
+			encodings[c] = encodeChunk( raw, chunkTiles( c ), payloads[c] );
+		}
+	};
+	forEachChunk( numChunks, encode );
+
+	int numChanged   = 0;
+	qint64 logAppend = worldLogRecordSize;
+	for ( int c = 0; c < numChunks; ++c )
 	{
-		QDataStream out( &worldFile );
-		std::vector<Tile>& world = g->w()->world();
+		if ( changed[c] )
+		{
+			++numChanged;
+			logAppend += worldLogRecordSize + payloads[c].size();
+		}
+	}
 
-		for ( const auto& tile : world )
+	if ( incremental && ( state.logSize ? state.logSize : worldLogHeaderSize ) + logAppend <= state.baseSize )
+	{
+		// world.dat is only read from here on and can be shared with the backup, world.log is appended to
+		QFile::remove( folder + "world.dat" );
+		QFile::remove( folder + "world.log" );
+		bool ok = linkOrCopy( previous + "world.dat", folder + "world.dat" );
+		if ( ok && state.logSize )
 		{
-			out << (quint64)tile.flags;
-			out << (quint16)tile.wallType;
-			out << (quint16)tile.wallMaterial;
-			out << (quint16)tile.floorType;
-			out << (quint16)tile.floorMaterial;
-			out << (quint8)tile.wallRotation;
-			out << (quint8)tile.floorRotation;
-			out << (quint8)tile.fluidLevel;
-			out << (quint8)tile.pressure;
-			out << (quint8)tile.flow;
-			out << (quint8)tile.vegetationLevel;
-			out << (quint16)tile.embeddedMaterial;
-
-			out << (quint32)tile.wallSpriteUID;
-			out << (quint32)tile.floorSpriteUID;
-			out << (quint32)tile.itemSpriteUID;
-#ifdef SAVEREGIONINFO
-			out << (quint32)tile.region;
-#endif
+			ok = QFile::copy( previous + "world.log", folder + "world.log" );
+		}
+
+		QFile log( folder + "world.log" );
+		ok = ok && log.open( QIODevice::ReadWrite );
+		if ( ok && !state.logSize )
+		{
+			QByteArray head( worldLogHeaderSize, 0 );
+			uchar* out = reinterpret_cast<uchar*>( head.data() );
+			memcpy( out, worldLogMagic, 4 );
+			qToLittleEndian<quint32>( worldLogVersion, out + 4 );
+			qToLittleEndian<quint64>( state.saveID, out + 8 );
+			qToLittleEndian<quint16>( Global::dimX, out + 16 );
+			qToLittleEndian<quint16>( Global::dimY, out + 18 );
+			qToLittleEndian<quint16>( Global::dimZ, out + 20 );
+			ok = log.resize( 0 ) && log.write( head ) == head.size();
+			state.logSize = worldLogHeaderSize;
+		}
+		// drops the tail of a save that didn't finish
+		ok = ok && log.resize( state.logSize ) && log.seek( state.logSize );
+
+		const auto writeRecord = [&log]( quint32 chunk, quint32 size, quint32 numTiles, quint8 encoding, quint64 fingerprint ) {
+			uchar record[worldLogRecordSize] = {};
+			qToLittleEndian<quint32>( chunk, record );
+			qToLittleEndian<quint32>( size, record + 4 );
+			qToLittleEndian<quint32>( numTiles, record + 8 );
+			record[12] = encoding;
+			qToLittleEndian<quint64>( fingerprint, record + 16 );
+			return log.write( reinterpret_cast<const char*>( record ), worldLogRecordSize ) == worldLogRecordSize;
+		};
+		for ( int c = 0; ok && c < numChunks; ++c )
+		{
+			if ( changed[c] )
+			{
+				ok = writeRecord( c, payloads[c].size(), chunkTiles( c ), encodings[c], fingerprints[c] ) && log.write( payloads[c] ) == payloads[c].size();
+			}
+		}
+		ok = ok && log.flush() && writeRecord( worldLogCommit, 0, numChanged, 0, 0 );
+		log.close();
+
+		if ( ok )
+		{
+			if ( Global::debugMode )
+				qDebug() << "saveWorld" << numChanged << "of" << numChunks << "levels appended," << logAppend / 1024 << "kB in" << timer.elapsed() << "ms";
+			return true;
 		}
+		qDebug() << "Error: appending to world.log failed, writing the whole world";
+	}
+
+	// full write, encode what the fingerprints let us skip
+	if ( numChanged < numChunks )
+	{
+		incremental = false;
+		forEachChunk( numChunks, [&]( int c ) {
+			if ( !changed[c] )
+			{
+				encode( c );
+			}
+		} );
+	}
+
+	QByteArray head( worldFileHeaderSize + numChunks * worldFileChunkInfoSize, Qt::Uninitialized );
+	uchar* out = reinterpret_cast<uchar*>( head.data() );
+	memcpy( out, worldFileMagic, 4 );
+	qToLittleEndian<quint32>( worldFileVersion, out + 4 );
+	qToLittleEndian<quint16>( Global::dimX, out + 8 );
+	qToLittleEndian<quint16>( Global::dimY, out + 10 );
+	qToLittleEndian<quint16>( Global::dimZ, out + 12 );
+	qToLittleEndian<quint16>( worldFileRecordSize, out + 14 );
+	qToLittleEndian<quint32>( numChunks, out + 16 );
+	qToLittleEndian<quint64>( QRandomGenerator::system()->generate64(), out + 20 );
+	out += worldFileHeaderSize;
+
+	quint64 offset = head.size();
+	for ( int c = 0; c < numChunks; ++c, out += worldFileChunkInfoSize )
+	{
+		qToLittleEndian<quint64>( offset, out );
+		qToLittleEndian<quint32>( payloads[c].size(), out + 8 );
+		qToLittleEndian<quint32>( chunkTiles( c ), out + 12 );
+		out[16] = encodings[c];
+		out[17] = out[18] = out[19] = 0;
+		qToLittleEndian<quint64>( fingerprints[c], out + 20 );
+		offset += payloads[c].size();
+	}
+
+	// world.dat may be a link to the backup's file, replace it instead of writing through
+	QFile::remove( folder + "world.dat" );
+	QFile::remove( folder + "world.log" );
+	QFile worldFile( folder + "world.dat" );
+	if ( !worldFile.open( QIODevice::WriteOnly ) )
+	{
+		return false;
+	}
+	bool ok = worldFile.write( head ) == head.size();
+	for ( const auto& payload : payloads )
+	{
+		ok = ok && worldFile.write( payload ) == payload.size();
 	}
 	worldFile.close();
-	return true;
+
+	if ( Global::debugMode )
+	{
+		const auto levels = [&encodings]( quint8 a, quint8 b ) {
+			return std::count_if( encodings.begin(), encodings.end(), [a, b]( quint8 e ) { e &= ~WCE_COMPRESSED; return e == a || e == b; } );
+		};
+		// World keeps every level dense, the uniform ones are the memory sparse levels would give back
+		size_t uniformTiles = 0;
+		for ( int c = 0; c < numChunks; ++c )
+		{
+			if ( ( encodings[c] & ~WCE_COMPRESSED ) == WCE_UNIFORM )
+			{
+				uniformTiles += chunkTiles( c );
+			}
+		}
+		qDebug() << "saveWorld" << world.size() << "tiles," << offset / 1024 << "kB in" << timer.elapsed() << "ms,"
+				 << levels( WCE_UNIFORM, WCE_UNIFORM ) << "uniform" << levels( WCE_PALETTE8, WCE_PALETTE16 ) << "palette" << levels( WCE_RECORDS, WCE_RECORDS ) << "full levels,"
+				 << world.size() * sizeof( Tile ) / 1024 << "kB in memory," << uniformTiles * sizeof( Tile ) / 1024 << "kB of it in uniform levels";
+	}
+	return ok;
 }
 
 /** @brief Loads the world grid from a binary file (world.dat) in the given folder.
+ *
+ *  Chunked files are memory-mapped and decoded straight into the world grid,
+ *  one z-level per task, then the chunks saved to world.log since are decoded
+ *  over them. Files without the chunked header are legacy streams and go
+ *  through loadWorld( QDataStream& ).
+ *
  *  @param folder Path to the save folder.
  *  @return True if the file was opened and read successfully, false otherwise.
  */
@@ -728,16 +1409,183 @@ bool IO::loadWorld( QString folder )
 	QFile worldFile( folder + "world.dat" );
 	if ( worldFile.open( QIODevice::ReadOnly ) )
 	{
+		QElapsedTimer timer;
+		timer.start();
+
+		char magic[4];
+		if ( worldFile.peek( magic, 4 ) == 4 && memcmp( magic, worldFileMagic, 4 ) == 0 )
+		{
+			quint64 saveID = 0;
+			bool ok        = loadWorldChunks( worldFile, saveID );
+			worldFile.close();
+
+			QFile logFile( folder + "world.log" );
+			if ( ok && saveID && logFile.open( QIODevice::ReadOnly ) )
+			{
+				ok = loadWorldLog( logFile, saveID );
+				logFile.close();
+			}
+			if ( Global::debugMode )
+				qDebug() << "loadWorld" << g->w()->world().size() << "tiles in" << timer.elapsed() << "ms";
+			return ok;
+		}
+
 		QDataStream in( &worldFile );
 
 		loadWorld( in );
 
 		worldFile.close();
+		if ( Global::debugMode )
+			qDebug() << "loadWorld (legacy)" << g->w()->world().size() << "tiles in" << timer.elapsed() << "ms";
 		return true;
 	}
 	return false;
 }
 
+/** @brief Reads a chunked world file and populates the world grid.
+ *
+ *  The file is mapped into memory if the platform allows it and read into a
+ *  buffer otherwise. The header has to match Global::dimX/Y/Z and every chunk
+ *  has to lie inside the file and decode to its tile count.
+ *
+ *  @param file Open world file positioned at the start.
+ *  @param[out] saveID Save ID that a world.log next to the file has to carry, 0 before version 3.
+ *  @return False if the file is truncated or doesn't match the world size.
+ */
+bool IO::loadWorldChunks( QFile& file, quint64& saveID )
+{
+	const qint64 fileSize = file.size();
+	QByteArray buffer;
+	uchar* mapped     = file.map( 0, fileSize );
+	const uchar* data = mapped;
+	if ( !mapped )
+	{
+		buffer = file.readAll();
+		data   = reinterpret_cast<const uchar*>( buffer.constData() );
+	}
+
+	const unsigned short dimX = Global::dimX;
+	const unsigned short dimY = Global::dimY;
+	const unsigned short dimZ = Global::dimZ;
+	const size_t numTiles     = (size_t)dimX * dimY * dimZ;
+
+	const quint32 version = fileSize >= 20 ? qFromLittleEndian<quint32>( data + 4 ) : 0;
+	const int headerSize  = version < 3 ? 20 : worldFileHeaderSize;
+	const int infoSize    = version == 1 ? 16 : ( version == 2 ? 20 : worldFileChunkInfoSize );
+
+	bool ok = version >= 1 && version <= worldFileVersion && fileSize >= headerSize &&
+		qFromLittleEndian<quint16>( data + 8 ) == dimX &&
+		qFromLittleEndian<quint16>( data + 10 ) == dimY &&
+		qFromLittleEndian<quint16>( data + 12 ) == dimZ &&
+		qFromLittleEndian<quint16>( data + 14 ) == worldFileRecordSize;
+
+	const int numChunks = ok ? (int)qFromLittleEndian<quint32>( data + 16 ) : 0;
+	ok                  = ok && headerSize + (qint64)numChunks * infoSize <= fileSize;
+	saveID              = ok && version >= 3 ? qFromLittleEndian<quint64>( data + 20 ) : 0;
+
+	std::vector<WorldChunkInfo> chunks( numChunks );
+	std::vector<size_t> firstTiles( numChunks );
+	size_t firstTile = 0;
+	for ( int c = 0; ok && c < numChunks; ++c )
+	{
+		const uchar* info     = data + headerSize + c * infoSize;
+		const quint32 size    = qFromLittleEndian<quint32>( info + 8 );
+		const quint32 count   = qFromLittleEndian<quint32>( info + 12 );
+		// version 1 payloads are records, compressed if they are smaller than that
+		const quint8 encoding = version == 1 ? ( size == count * worldFileRecordSize ? WCE_RECORDS : WCE_RECORDS | WCE_COMPRESSED ) : info[16];
+		chunks[c]             = { qFromLittleEndian<quint64>( info ), size, count, encoding, 0 };
+		firstTiles[c]         = firstTile;
+		firstTile += chunks[c].numTiles;
+		ok = chunks[c].offset <= (quint64)fileSize && chunks[c].size <= fileSize - chunks[c].offset;
+	}
+	ok = ok && firstTile == numTiles;
+
+	if ( ok )
+	{
+		g->setWorld( dimX, dimY, dimZ );
+		std::vector<Tile>& world = g->w()->world();
+		world.clear();
+		world.resize( numTiles );
+
+		std::atomic<bool> decoded( true );
+		forEachChunk( numChunks, [&]( int c ) {
+			const WorldChunkInfo& chunk = chunks[c];
+			if ( !decodeChunk( data + chunk.offset, chunk.size, chunk.encoding, world.data() + firstTiles[c], chunk.numTiles ) )
+			{
+				decoded = false;
+			}
+		} );
+		ok = decoded;
+	}
+	if ( !ok )
+	{
+		qDebug() << "Error: world.dat is damaged or doesn't match the world size";
+	}
+
+	if ( mapped )
+	{
+		file.unmap( mapped );
+	}
+	return ok;
+}
+
+/** @brief Decodes the chunks saved to world.log over the world grid loaded from world.dat.
+ *
+ *  Only the latest complete save of every chunk is decoded. A log that was
+ *  written for another world.dat is ignored.
+ *
+ *  @param file Open log file positioned at the start.
+ *  @param saveID Save ID of the loaded world.dat.
+ *  @return False if a chunk in the log doesn't decode.
+ */
+bool IO::loadWorldLog( QFile& file, quint64 saveID )
+{
+	const qint64 fileSize = file.size();
+	QByteArray buffer;
+	uchar* mapped     = file.map( 0, fileSize );
+	const uchar* data = mapped;
+	if ( !mapped )
+	{
+		buffer = file.readAll();
+		data   = reinterpret_cast<const uchar*>( buffer.constData() );
+	}
+
+	std::vector<Tile>& world = g->w()->world();
+	const size_t levelTiles  = (size_t)Global::dimX * Global::dimY;
+	const int numChunks      = levelTiles ? (int)( ( world.size() + levelTiles - 1 ) / levelTiles ) : 0;
+
+	std::vector<WorldChunkInfo> chunks;
+	bool ok = true;
+	if ( readWorldLog( data, fileSize, saveID, numChunks, chunks ) )
+	{
+		std::atomic<bool> decoded( true );
+		forEachChunk( numChunks, [&]( int c ) {
+			const WorldChunkInfo& chunk = chunks[c];
+			if ( chunk.offset && ( chunk.numTiles != qMin( levelTiles, world.size() - c * levelTiles ) || !decodeChunk( data + chunk.offset, chunk.size, chunk.encoding, world.data() + c * levelTiles, chunk.numTiles ) ) )
+			{
+				decoded = false;
+			}
+		} );
+		ok = decoded;
+		if ( Global::debugMode )
+			qDebug() << "loadWorldLog" << std::count_if( chunks.begin(), chunks.end(), []( const WorldChunkInfo& chunk ) { return chunk.offset != 0; } ) << "levels from world.log";
+	}
+	else
+	{
+		qDebug() << "world.log doesn't belong to world.dat, ignoring it";
+	}
+	if ( !ok )
+	{
+		qDebug() << "Error: world.log is damaged";
+	}
+
+	if ( mapped )
+	{
+		file.unmap( mapped );
+	}
+	return ok;
+}
+
 /** @brief Reads world tile data from a QDataStream and populates the world grid.
  *
  *  Allocates the world using Global::dimX/Y/Z, then reads each tile's binary
@@ -1032,7 +1880,7 @@ bool IO::loadMonsters( QString folder )
 	QJsonDocument jd;
 	if ( QFileInfo::exists( folder + "monsters.json" ) )
 	{
-		loadFile( folder + "monsters.json", jd );
+		jd = document( folder + "monsters.json" );
 		QJsonArray ja = jd.array();
 		for ( const auto& entry : ja.toVariantList() )
 		{
@@ -1044,7 +1892,7 @@ bool IO::loadMonsters( QString folder )
 		int i = 1;
 		while ( QFileInfo::exists( folder + "monsters" + QString::number( i ) + ".json" ) )
 		{
-			loadFile( folder + "monsters" + QString::number( i ) + ".json", jd );
+			jd = document( folder + "monsters" + QString::number( i ) + ".json" );
 			QJsonArray ja = jd.array();
 			for ( const auto& entry : ja.toVariantList() )
 			{
@@ -1067,18 +1915,21 @@ QJsonArray IO::jsonArrayPlants( int startIndex, int amount )
 		qDebug() << "jsonArrayAnimals";
 
 	QJsonArray ja;
-	auto plants = g->w()->plants();
-	auto keys   = plants.keys();
-	int i       = startIndex;
-
-	while ( i < keys.size() && amount > 0 )
+	int i = 0;
+	for ( const auto& plant : g->w()->plants() )
 	{
-		const auto& plant = plants[keys[i]];
+		if ( amount == 0 )
+		{
+			break;
+		}
+		if ( i++ < startIndex )
+		{
+			continue;
+		}
 
 		QJsonValue jv = QJsonValue::fromVariant( plant.serialize() );
 		ja.append( jv );
 
-		++i;
 		--amount;
 	}
 	return ja;
@@ -1127,7 +1978,7 @@ bool IO::loadPlants( QString folder )
 	QJsonDocument jd;
 	if ( QFileInfo::exists( folder + "plants.json" ) )
 	{
-		loadFile( folder + "plants.json", jd );
+		jd = document( folder + "plants.json" );
 		QJsonArray ja = jd.array();
 		for ( const auto& entry : ja.toVariantList() )
 		{
@@ -1141,7 +1992,7 @@ bool IO::loadPlants( QString folder )
 
 		while ( QFileInfo::exists( folder + "plants" + QString::number( i ) + ".json" ) )
 		{
-			loadFile( folder + "plants" + QString::number( i ) + ".json", jd );
+			jd = document( folder + "plants" + QString::number( i ) + ".json" );
 			QJsonArray ja = jd.array();
 
 			for ( const auto& entry : ja.toVariantList() )
@@ -1166,28 +2017,32 @@ QJsonArray IO::jsonArrayItems( int startIndex, int amount )
 		qDebug() << "jsonArrayAnimals";
 
 	QJsonArray ja;
-	auto& items = g->inv()->allItems();
-	auto keys   = items.keys();
-
-	int i = startIndex;
+	const auto& items = g->inv()->allItems();
 
-	while ( i < keys.size() && amount > 0 )
+	int i = 0;
+	for ( auto it = items.begin(); it != items.end() && amount > 0; ++it, ++i )
 	{
-		auto itemID   = keys[i];
-		auto& item    = items[itemID];
-		QJsonValue jv = QJsonValue::fromVariant( item.serialize() );
+		if ( i < startIndex )
+		{
+			continue;
+		}
+		QJsonValue jv = QJsonValue::fromVariant( it->serialize() );
 		ja.append( jv );
 
-		++i;
 		--amount;
 	}
 	return ja;
 }
 
-/** @brief Saves all items to numbered chunk files (items1.json, items2.json, ...).
+/** @brief Magic and version at the start of items.bin. */
+static const char itemFileMagic[4]       = { 'I', 'G', 'I', 'T' };
+static constexpr quint32 itemFileVersion = 1;
+
+/** @brief Saves all items to items.bin.
  *
- *  Runs a sanity check on the inventory before saving. Each chunk contains
- *  up to 50,000 items.
+ *  Runs a sanity check on the inventory before saving. After the magic and
+ *  version the file holds one length-prefixed record per item, see
+ *  Item::serialize( Schema::Writer& ).
  *
  *  @param folder Path to the save folder.
  *  @return True on success.
@@ -1196,46 +2051,106 @@ bool IO::saveItems( QString folder )
 {
 	g->inv()->sanityCheck();
 
-	QByteArray out;
+	QElapsedTimer timer;
+	timer.start();
 
-	auto& items = g->inv()->allItems();
+	Schema::Writer out;
+	Schema::Writer record;
+	for ( const auto& item : g->inv()->allItems() )
+	{
+		record.clear();
+		item.serialize( record );
+		out.record( record );
+	}
 
-	int i          = 1;
-	int startIndex = 0;
-	while ( true )
+	QFile file( folder + "items.bin" );
+	if ( !file.open( QIODevice::WriteOnly ) )
 	{
-		auto ja = jsonArrayItems( startIndex, 50000 );
-		if ( ja.size() > 0 )
-		{
-			IO::saveFile( folder + "items" + QString::number( i ) + ".json", ja );
-			++i;
-			startIndex += 50000;
-		}
-		else
+		return false;
+	}
+	uchar head[8];
+	memcpy( head, itemFileMagic, 4 );
+	qToLittleEndian<quint32>( itemFileVersion, head + 4 );
+	bool ok = file.write( reinterpret_cast<const char*>( head ), 8 ) == 8 && file.write( out.data() ) == out.data().size();
+	file.close();
+
+	if ( Global::debugMode )
+		qDebug() << "saveItems" << g->inv()->allItems().size() << "items," << out.data().size() / 1024 << "kB in" << timer.elapsed() << "ms";
+	return ok;
+}
+
+/** @brief Reads and decodes items.bin without touching the game state, so it can run on a worker thread.
+ *  @param folder Path to the save folder.
+ *  @return The decoded items. A damaged file keeps the items in front of the damage.
+ */
+static ItemFile readItemFile( QString folder )
+{
+	ItemFile out;
+	QFile file( folder + "items.bin" );
+	if ( !file.open( QIODevice::ReadOnly ) )
+	{
+		return out;
+	}
+	QByteArray data = file.readAll();
+	file.close();
+
+	out.status      = ItemFile::Damaged;
+	const uchar* in = reinterpret_cast<const uchar*>( data.constData() );
+	if ( data.size() < 8 || memcmp( in, itemFileMagic, 4 ) != 0 || qFromLittleEndian<quint32>( in + 4 ) > itemFileVersion )
+	{
+		qDebug() << "Error: items.bin has an unknown format";
+		return out;
+	}
+
+	// count first so the items are constructed in place and never copied on growth
+	size_t count = 0;
+	for ( Schema::Reader counter( in + 8, data.size() - 8 ); !counter.atEnd() && counter.ok(); ++count )
+	{
+		counter.record();
+	}
+	out.items.reserve( count );
+
+	Schema::Reader reader( in + 8, data.size() - 8 );
+	while ( !reader.atEnd() )
+	{
+		Schema::Reader record = reader.record();
+		out.items.emplace_back( record );
+		if ( !record.ok() || !reader.ok() )
 		{
-			break;
+			out.items.pop_back();
+			qDebug() << "Error: items.bin is truncated after" << out.items.size() << "items";
+			return out;
 		}
 	}
-
-	return true;
+	out.status = ItemFile::Loaded;
+	return out;
 }
 
 /** @brief Loads items from the save folder.
  *
- *  Initializes the inventory filter, then loads items from either a single
- *  items.json (legacy) or chunked files (items1.json, items2.json, ...).
+ *  Initializes the inventory filter, then adds the items decoded from items.bin
+ *  in bulk, see Inventory::loadItems(), or, for older saves, loads them from a single items.json or chunked files
+ *  (items1.json, items2.json, ...).
  *
  *  @param folder Path to the save folder.
+ *  @param file Result of readItemFile() for the folder.
  *  @return True on success.
  */
-bool IO::loadItems( QString folder )
+bool IO::loadItems( QString folder, ItemFile& file )
 {
 	g->inv()->loadFilter();
 
+	if ( file.status != ItemFile::Missing )
+	{
+		const int count = g->inv()->loadItems( file.items );
+		qDebug() << "loaded" << count << "items";
+		return file.status == ItemFile::Loaded;
+	}
+
 	QJsonDocument jd;
 	if ( QFileInfo::exists( folder + "items.json" ) )
 	{
-		loadFile( folder + "items.json", jd );
+		jd = document( folder + "items.json" );
 		QJsonArray ja = jd.array();
 		int count     = 0;
 		for ( const auto& entry : ja.toVariantList() )
@@ -1251,7 +2166,7 @@ bool IO::loadItems( QString folder )
 		int count = 0;
 		while ( QFileInfo::exists( folder + "items" + QString::number( i ) + ".json" ) )
 		{
-			loadFile( folder + "items" + QString::number( i ) + ".json", jd );
+			jd = document( folder + "items" + QString::number( i ) + ".json" );
 			QJsonArray ja = jd.array();
 
 			for ( const auto& entry : ja.toVariantList() )
@@ -1267,6 +2182,46 @@ bool IO::loadItems( QString folder )
 	return true;
 }
 
+/** @brief Writes the items of a save's items.bin as items.json next to it, for debugging.
+ *
+ *  Item and material UIDs are resolved through the UID tables of the save's
+ *  game.json. The output has the layout of the JSON item saves, so with
+ *  items.bin removed the save loads the dumped items instead.
+ *
+ *  @param folder Path to the save folder.
+ *  @return True if the items were decoded completely and the dump was written.
+ */
+bool IO::dumpItems( QString folder )
+{
+	QJsonDocument jd;
+	if ( !loadFile( folder + "game.json", jd ) )
+	{
+		qDebug() << "Error: no game.json in" << folder;
+		return false;
+	}
+	auto doc = jd.array().toVariantList();
+	if ( doc.size() )
+	{
+		auto map = doc.first().toMap();
+		GameState::load( map );
+	}
+
+	ItemFile file = readItemFile( folder );
+	if ( file.status == ItemFile::Missing )
+	{
+		qDebug() << "Error: no items.bin in" << folder;
+		return false;
+	}
+
+	QJsonArray ja;
+	for ( const auto& item : file.items )
+	{
+		ja.append( QJsonValue::fromVariant( item.serialize() ) );
+	}
+	qDebug() << "dumped" << file.items.size() << "items to" << folder + "items.json";
+	return saveFile( folder + "items.json", ja ) && file.status == ItemFile::Loaded;
+}
+
 /** @brief Loads item history data from a parsed JSON document.
  *  @param jd JSON document containing the item history map.
  *  @return True on success.
@@ -1612,7 +2567,7 @@ bool IO::loadAnimals( QString folder )
 	QJsonDocument jd;
 	if ( QFileInfo::exists( folder + "animals.json" ) )
 	{
-		loadFile( folder + "animals.json", jd );
+		jd = document( folder + "animals.json" );
 		QJsonArray ja = jd.array();
 		for ( const auto& entry : ja.toVariantList() )
 		{
@@ -1624,7 +2579,7 @@ bool IO::loadAnimals( QString folder )
 		int i = 1;
 		while ( QFileInfo::exists( folder + "animals" + QString::number( i ) + ".json" ) )
 		{
-			loadFile( folder + "animals" + QString::number( i ) + ".json", jd );
+			jd = document( folder + "animals" + QString::number( i ) + ".json" );
 			QJsonArray ja = jd.array();
 			for ( const auto& entry : ja.toVariantList() )
 			{
@@ -1806,12 +2761,12 @@ bool IO::saveFile( QString url, const QJsonDocument& jd )
 bool IO::loadFile( QString url, QJsonDocument& ja )
 {
 	QFile file( url );
-	file.open( QIODevice::ReadOnly | QIODevice::Text );
-	QString val = file.readAll();
+	file.open( QIODevice::ReadOnly );
+	const QByteArray val = file.readAll();
 	file.close();
 
 	QJsonParseError error;
-	ja = QJsonDocument::fromJson( val.toUtf8(), &error );
+	ja = QJsonDocument::fromJson( val, &error );
 
 	if ( error.error == QJsonParseError::NoError )
 	{
@@ -21,9 +21,15 @@
 
 #pragma once
 
+#include <QHash>
+#include <QJsonDocument>
 #include <QObject>
 
+#include <future>
+
 class Game;
+class QFile;
+struct ItemFile;
 
 /**
  * @brief Handles all game save/load operations and static file I/O utilities.
@@ -39,6 +45,11 @@ class IO : public QObject
 private:
 	QPointer<Game> g;
 
+	QHash<QString, std::shared_future<QJsonDocument>> m_documents; ///< JSON files of the save being loaded, parsed on worker threads.
+
+	void prefetchDocuments( const QString& folder );
+	QJsonDocument document( const QString& url );
+
 public:
 	IO( Game* g, QObject* parent );
 	~IO();
@@ -64,8 +75,12 @@ class IO : public QObject
 	static bool saveFile( QString url, const QJsonObject& jo );
 	static bool loadFile( QString url, QJsonDocument& ja );
 
-	bool saveWorld( QString folder );
+	static bool dumpItems( QString folder );
+
+	bool saveWorld( QString folder, QString previous = QString() );
 	bool loadWorld( QString folder );
+	bool loadWorldChunks( QFile& file, quint64& saveID );
+	bool loadWorldLog( QFile& file, quint64 saveID );
 	void loadWorld( QDataStream& in );
 
 	QJsonArray jsonArraySprites();
@@ -101,7 +116,7 @@ class IO : public QObject
 	bool loadGnomes( QJsonDocument& jd );
 	bool loadMonsters( QString folder );
 	bool loadPlants( QString folder );
-	bool loadItems( QString folder );
+	bool loadItems( QString folder, ItemFile& file );
 	bool loadItemHistory( QJsonDocument& jd );
 	bool loadJobs( QJsonDocument& jd );
 	bool loadJobSprites( QJsonDocument& jd );
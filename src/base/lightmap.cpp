@@ -33,6 +33,8 @@
 #include <QQueue>
 #include <QVector3D>
 
+#include <set>
+
 /** @brief Default constructor. */
 LightMap::LightMap()
 {
@@ -240,4 +242,37 @@ void LightMap::updateLight( QSet<unsigned int>& updateList, std::vector<Tile>& w
 			addLight( updateList, world, key, light.pos, light.intensity );
 		}
 	}
-}
\ No newline at end of file
+}
+
+/** @brief Recalculates every light that reaches any of the given tiles, each light once.
+ *
+ *  Batched form of updateLight() for many changed tiles, a light that reaches
+ *  several of them is removed and re-added only once.
+ *
+ *  @param[in,out] updateList Set of tile IDs that need rendering updates.
+ *  @param[in,out] world      The world tile array.
+ *  @param positions          The positions where the world geometry changed.
+ */
+void LightMap::updateLights( QSet<unsigned int>& updateList, std::vector<Tile>& world, const std::vector<Position>& positions )
+{
+	// ordered, so lights are re-added in the same order on every run
+	std::set<unsigned int> lights;
+	for ( const auto& pos : positions )
+	{
+		auto it = m_lightMap.constFind( pos.toInt() );
+		if ( it != m_lightMap.constEnd() )
+		{
+			for ( auto key : it.value().keys() )
+			{
+				lights.insert( key );
+			}
+		}
+	}
+	for ( auto key : lights )
+	{
+		Light light = m_lights[key];
+
+		removeLight( updateList, world, key );
+		addLight( updateList, world, key, light.pos, light.intensity );
+	}
+}
@@ -53,6 +53,7 @@ class LightMap
 	void addLight( QSet<unsigned int>& updateList, std::vector<Tile>& world, unsigned int id, Position pos, int intensity );
 	void removeLight( QSet<unsigned int>& updateList, std::vector<Tile>& world, unsigned int id );
 	void updateLight( QSet<unsigned int>& updateList, std::vector<Tile>& world, Position pos );
+	void updateLights( QSet<unsigned int>& updateList, std::vector<Tile>& world, const std::vector<Position>& positions );
 
 private:
 	QMap<unsigned int, QMap<unsigned int, unsigned char>> m_lightMap;
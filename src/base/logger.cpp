@@ -17,42 +17,355 @@
 */
 
 /** @file logger.cpp
- *  @brief Implementation of Logger, a thread-safe game event message log.
+ *  @brief Implementation of Logger, a lock-free ring buffer of game event messages
+ *         with lazy formatting and an optional background log file writer.
  */
 
 #include "logger.h"
 
 #include "../base/gamestate.h"
 
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 /** @brief Constructs an empty Logger instance. */
 Logger::Logger()
 {
 }
 
-/** @brief Destructor. */
+/** @brief Destructor. Flushes and stops the log file writer if it is running. */
 Logger::~Logger()
 {
+	stopSpill();
 }
 
-/** @brief Clears all stored log messages. */
+/** @brief Discards all stored log messages.
+ *
+ *  Records are not touched, only the start of the visible window is moved, so
+ *  producers on other threads are never blocked.
+ */
 void Logger::reset()
 {
-	m_messages.clear();
+	m_first.store( m_head.load( std::memory_order_acquire ), std::memory_order_release );
 }
 
-/** @brief Adds a timestamped log message to the message list.
+/** @brief Records a log message.
  *
- *  Creates a LogMessage stamped with the current game tick and appends
- *  it to the internal message buffer. Access is mutex-protected for
- *  thread safety.
+ *  Claims the next slot of the ring buffer with one atomic increment and takes
+ *  it over from the record a ring earlier. If that record is still being written,
+ *  the message is dropped instead of waiting. Stores the template pointer, the
+ *  raw numbers and a copy of the string arguments, the text is not formatted here.
+ *  String arguments longer than the record's text buffer together get one claim
+ *  in the shared text ring.
  *
  *  @param lt            The log type/category of the message.
- *  @param msg           The human-readable log message text.
+ *  @param tmpl          Message template with %1..%n placeholders, must be a string literal.
  *  @param sourceEntity  The ID of the entity that generated the message (0 if none).
+ *  @param args          Up to maxArgs arguments for the placeholders.
+ */
+void Logger::log( LogType lt, const char* tmpl, unsigned int sourceEntity, std::initializer_list<LogArg> args )
+{
+	const quint64 index = m_head.fetch_add( 1, std::memory_order_acq_rel );
+	Record& record      = m_records[index % capacity];
+
+	// The slot is free for this lap once the record a ring earlier is complete. Odd means a
+	// stalled writer still owns it, a sequence of this lap or later means a later writer took it.
+	quint64 seq = record.seq.load( std::memory_order_acquire );
+	if ( ( seq & 1 ) || seq > 2 * index || !record.seq.compare_exchange_strong( seq, 2 * index + 1, std::memory_order_acquire ) )
+	{
+		return;
+	}
+	std::atomic_thread_fence( std::memory_order_release );
+
+	record.tick    = GameState::tick;
+	record.source  = sourceEntity;
+	record.tmpl    = tmpl;
+	record.type    = lt;
+	record.numArgs = 0;
+
+	// cut single arguments where maxLongText ends, but not between the halves of a surrogate pair
+	qsizetype lengths[maxArgs] {};
+	int textLength = 0;
+	int numArgs    = 0;
+	for ( const auto& arg : args )
+	{
+		if ( numArgs == maxArgs )
+		{
+			break;
+		}
+		if ( arg.kind == LogArg::Kind::String )
+		{
+			qsizetype length = qMin<qsizetype>( arg.string->size(), maxLongText );
+			if ( length > 0 && length < arg.string->size() && arg.string->at( length - 1 ).isHighSurrogate() )
+			{
+				--length;
+			}
+			lengths[numArgs] = length;
+			textLength += length;
+		}
+		++numArgs;
+	}
+	record.textLength = textLength;
+	record.longText   = textLength > maxText ? m_longHead.fetch_add( textLength, std::memory_order_acq_rel ) : 0;
+
+	int textUsed = 0;
+	for ( const auto& arg : args )
+	{
+		if ( record.numArgs == maxArgs )
+		{
+			break;
+		}
+		record.kinds[record.numArgs] = arg.kind;
+		switch ( arg.kind )
+		{
+			case LogArg::Kind::Int:
+				record.values[record.numArgs] = arg.intValue;
+				break;
+			case LogArg::Kind::Real:
+				std::memcpy( &record.values[record.numArgs], &arg.realValue, sizeof( double ) );
+				break;
+			case LogArg::Kind::String:
+			{
+				const qsizetype length = lengths[record.numArgs];
+				if ( textLength > maxText )
+				{
+					writeLongText( record.longText + textUsed, arg.string->utf16(), length );
+				}
+				else
+				{
+					std::memcpy( record.text + textUsed, arg.string->utf16(), length * sizeof( char16_t ) );
+				}
+				record.values[record.numArgs] = textUsed | ( (qint64)length << 32 );
+				textUsed += length;
+				break;
+			}
+		}
+		++record.numArgs;
+	}
+
+	record.seq.store( 2 * index + 2, std::memory_order_release );
+
+	// wake the log file writer once it is half a ring behind, not only on its next poll
+	if ( m_spillActive.load( std::memory_order_relaxed ) && index - m_spilled.load( std::memory_order_relaxed ) == capacity / 2 )
+	{
+		m_spillWake.wakeAll();
+	}
+}
+
+/** @brief Copies text into the shared ring, wrapping at its end. */
+void Logger::writeLongText( quint64 pos, const char16_t* text, qsizetype length )
+{
+	const qsizetype start = pos % longTextCapacity;
+	const qsizetype first = qMin<qsizetype>( length, longTextCapacity - start );
+	std::memcpy( m_longText + start, text, first * sizeof( char16_t ) );
+	std::memcpy( m_longText, text + first, ( length - first ) * sizeof( char16_t ) );
+}
+
+/** @brief Copies text out of the shared ring, wrapping at its end. */
+void Logger::readLongText( quint64 pos, char16_t* text, qsizetype length ) const
+{
+	const qsizetype start = pos % longTextCapacity;
+	const qsizetype first = qMin<qsizetype>( length, longTextCapacity - start );
+	std::memcpy( text, m_longText + start, first * sizeof( char16_t ) );
+	std::memcpy( text + first, m_longText, ( length - first ) * sizeof( char16_t ) );
+}
+
+/** @brief Copies and formats one record.
+ *  @param index Absolute record index.
+ *  @param[out] out The formatted message.
+ *  @return False if the record is still being written or was already overwritten.
+ */
+bool Logger::readRecord( quint64 index, LogMessage& out )
+{
+	const Record& record   = m_records[index % capacity];
+	const quint64 expected = 2 * index + 2;
+	if ( record.seq.load( std::memory_order_acquire ) != expected )
+	{
+		return false;
+	}
+	const quint64 tick          = record.tick;
+	const unsigned int source   = record.source;
+	const char* tmpl            = record.tmpl;
+	const LogType type          = record.type;
+	const unsigned char numArgs = record.numArgs;
+	const int textLength        = qBound( 0, record.textLength, maxArgs * maxLongText );
+	const quint64 longText      = record.longText;
+	LogArg::Kind kinds[maxArgs];
+	qint64 values[maxArgs];
+	QString text( textLength, Qt::Uninitialized );
+	char16_t* textData = reinterpret_cast<char16_t*>( text.data() );
+	std::copy( std::begin( record.kinds ), std::end( record.kinds ), std::begin( kinds ) );
+	std::copy( std::begin( record.values ), std::end( record.values ), std::begin( values ) );
+	if ( textLength <= maxText )
+	{
+		std::copy( record.text, record.text + textLength, textData );
+	}
+	std::atomic_thread_fence( std::memory_order_acquire );
+	if ( record.seq.load( std::memory_order_relaxed ) != expected )
+	{
+		return false;
+	}
+	if ( textLength > maxText )
+	{
+		// the record is valid, so its claim in the ring was written; it is intact unless a later claim wrapped onto it
+		readLongText( longText, textData, textLength );
+		std::atomic_thread_fence( std::memory_order_acquire );
+		if ( m_longHead.load( std::memory_order_relaxed ) > longText + longTextCapacity )
+		{
+			return false;
+		}
+	}
+
+	QString message = QString::fromUtf8( tmpl );
+	for ( int i = 0; i < numArgs; ++i )
+	{
+		switch ( kinds[i] )
+		{
+			case LogArg::Kind::Int:
+				message = message.arg( values[i] );
+				break;
+			case LogArg::Kind::Real:
+			{
+				double value;
+				std::memcpy( &value, &values[i], sizeof( double ) );
+				message = message.arg( value );
+				break;
+			}
+			case LogArg::Kind::String:
+				message = message.arg( text.mid( values[i] & 0xffffffff, values[i] >> 32 ) );
+				break;
+		}
+	}
+	out = { tick, type, message, source };
+	return true;
+}
+
+/** @brief Formats the retained messages.
+ *  @param fromIndex Only return messages with an index >= fromIndex, see lastIndex().
+ *  @return The messages still held by the ring buffer, oldest first.
+ */
+std::vector<LogMessage> Logger::messages( quint64 fromIndex )
+{
+	const quint64 head = m_head.load( std::memory_order_acquire );
+	quint64 first      = qMax( fromIndex, m_first.load( std::memory_order_acquire ) );
+	if ( head > capacity )
+	{
+		first = qMax( first, head - capacity );
+	}
+
+	std::vector<LogMessage> out;
+	out.reserve( head > first ? head - first : 0 );
+	LogMessage message;
+	for ( quint64 i = first; i < head; ++i )
+	{
+		if ( readRecord( i, message ) )
+		{
+			out.push_back( std::move( message ) );
+		}
+	}
+	return out;
+}
+
+/** @brief Returns the index the next message will get. */
+quint64 Logger::lastIndex() const
+{
+	return m_head.load( std::memory_order_acquire );
+}
+
+/** @brief Streams all messages to a file on a background thread.
+ *
+ *  Messages are appended as they arrive, independent of the in-memory capacity.
+ *  If the writer falls behind by more than the ring buffer capacity, the number
+ *  of lost messages is written instead.
+ *
+ *  @param path Log file path, empty to stop writing.
  */
-void Logger::log( LogType lt, QString msg, unsigned int sourceEntity )
+void Logger::setLogFile( QString path )
+{
+	stopSpill();
+	if ( path.isEmpty() )
+	{
+		return;
+	}
+	m_spillPath    = path;
+	m_spillRunning = true;
+	m_spillThread  = std::thread( &Logger::spillLoop, this );
+}
+
+/** @brief Stops the log file writer after it has written all pending messages. */
+void Logger::stopSpill()
 {
-	LogMessage lm { GameState::tick, "", lt, msg, sourceEntity };
-	QMutexLocker lock( &m_mutex );
-	m_messages.push_back( lm );
+	{
+		QMutexLocker lock( &m_spillMutex );
+		if ( !m_spillRunning )
+		{
+			return;
+		}
+		m_spillRunning = false;
+		m_spillWake.wakeAll();
+	}
+	if ( m_spillThread.joinable() )
+	{
+		m_spillThread.join();
+	}
+}
+
+/** @brief Body of the log file writer thread. */
+void Logger::spillLoop()
+{
+	QFile file( m_spillPath );
+	if ( !file.open( QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text ) )
+	{
+		qWarning() << "Logger: failed to open" << m_spillPath;
+		return;
+	}
+	QTextStream out( &file );
+
+	static const char* typeNames[] = { "DEBUG", "JOB", "CRAFT", "COMBAT" };
+
+	quint64 next  = m_head.load( std::memory_order_acquire );
+	quint64 retry = std::numeric_limits<quint64>::max();
+	m_spilled.store( next, std::memory_order_relaxed );
+	m_spillActive.store( true, std::memory_order_relaxed );
+	bool running = true;
+	while ( running )
+	{
+		{
+			QMutexLocker lock( &m_spillMutex );
+			if ( m_spillRunning )
+			{
+				m_spillWake.wait( &m_spillMutex, 500 );
+			}
+			running = m_spillRunning;
+		}
+
+		const quint64 head = m_head.load( std::memory_order_acquire );
+		if ( head > capacity && next < head - capacity )
+		{
+			out << "... " << ( head - capacity - next ) << " messages lost\n";
+			next = head - capacity;
+		}
+		LogMessage message;
+		for ( ; next < head; ++next )
+		{
+			if ( m_records[next % capacity].seq.load( std::memory_order_acquire ) < 2 * next + 2 && next != retry )
+			{
+				// Still being written, pick it up next round. If it is still missing then, it was dropped.
+				retry = next;
+				break;
+			}
+			if ( readRecord( next, message ) )
+			{
+				out << message.tick << " " << typeNames[(int)message.type] << " " << message.source << " " << message.message << "\n";
+			}
+		}
+		m_spilled.store( next, std::memory_order_relaxed );
+		out.flush();
+	}
+	m_spillActive.store( false, std::memory_order_relaxed );
 }
@@ -23,11 +23,15 @@
 
 #include <QMutex>
 #include <QString>
+#include <QWaitCondition>
 
+#include <atomic>
+#include <initializer_list>
+#include <thread>
 #include <vector>
 
 /** @brief Categories of log messages. */
-enum class LogType
+enum class LogType : unsigned char
 {
 	DEBUG,
 	JOB,
@@ -35,39 +39,137 @@ enum class LogType
 	COMBAT
 };
 
-/** @brief A single log entry with timestamp, type, message text, and source entity. */
+/** @brief A formatted log entry with game tick, type, message text, and source entity. */
 struct LogMessage
 {
 	quint64 tick;
-	QString dateTime;
 	LogType type;
 	QString message;
 	unsigned int source;
 };
 
 /**
- * @brief Thread-safe in-game event logger.
+ * @brief A single argument for a message template, stored unformatted.
  *
- * Stores log messages with game tick, date/time string, type, and source entity ID.
- * Used for debug output and the in-game log panel.
+ * Strings are only referenced here and copied into the record when the
+ * message is recorded, so the argument must not outlive the log() call.
+ */
+struct LogArg
+{
+	enum class Kind : unsigned char
+	{
+		Int,
+		Real,
+		String
+	};
+
+	LogArg( int value ) :
+		kind( Kind::Int ), intValue( value )
+	{
+	}
+	LogArg( unsigned int value ) :
+		kind( Kind::Int ), intValue( value )
+	{
+	}
+	LogArg( qint64 value ) :
+		kind( Kind::Int ), intValue( value )
+	{
+	}
+	LogArg( float value ) :
+		kind( Kind::Real ), realValue( value )
+	{
+	}
+	LogArg( double value ) :
+		kind( Kind::Real ), realValue( value )
+	{
+	}
+	LogArg( const QString& value ) :
+		kind( Kind::String ), string( &value )
+	{
+	}
+
+	Kind kind;
+	union
+	{
+		qint64 intValue;
+		double realValue;
+		const QString* string;
+	};
+};
+
+/**
+ * @brief Lock-free, fixed-capacity in-game event logger.
+ *
+ * Messages are recorded as compact records (template pointer plus up to four
+ * raw arguments) in a ring buffer that overwrites the oldest entries, so memory
+ * stays bounded no matter how long a session runs. Producers on any thread
+ * claim a slot with a single atomic increment; each slot carries a sequence
+ * number that hands it from one writer to the next, and lets readers detect
+ * records that are being written or overwritten. A producer that finds its
+ * slot still owned by a stalled writer a whole ring earlier drops its message.
+ * Templates are string literals and are kept as pointers, string arguments
+ * are copied into the record, or into a shared text ring when they don't fit
+ * into it, e.g. a combat line with two long names. Text is only built when messages() is read or
+ * the optional log file is written. The log file is streamed by a background
+ * thread and never blocks the producers.
  */
 class Logger
 {
 public:
+	static constexpr int capacity = 4096; ///< Number of records kept in memory.
+	static constexpr int maxArgs  = 4;    ///< Maximum number of arguments per message.
+	static constexpr int maxText  = 64;   ///< UTF-16 code units of string arguments kept in the record itself.
+	static constexpr int longTextCapacity = 1 << 16;            ///< UTF-16 code units in the ring for string arguments that don't fit into a record.
+	static constexpr int maxLongText      = longTextCapacity / 16; ///< UTF-16 code units kept of a single string argument, longer strings are cut.
+
 	Logger();
 	~Logger();
 
 	void reset();
 
-	void log( LogType lt, QString msg, unsigned int sourceEntity );
+	/** @brief Records a message. @p tmpl must be a string literal with %1..%n placeholders. */
+	void log( LogType lt, const char* tmpl, unsigned int sourceEntity, std::initializer_list<LogArg> args = {} );
 
-	std::vector<LogMessage>& messages()
-	{
-		return m_messages;
-	}
+	std::vector<LogMessage> messages( quint64 fromIndex = 0 );
+	quint64 lastIndex() const;
+
+	void setLogFile( QString path );
 
 private:
-	QMutex m_mutex;
+	struct Record
+	{
+		std::atomic<quint64> seq { 0 }; ///< 2 * index + 1 while writing, 2 * index + 2 when complete
+		quint64 tick             = 0;
+		const char* tmpl         = nullptr;
+		unsigned int source      = 0;
+		LogType type             = LogType::DEBUG;
+		unsigned char numArgs    = 0;
+		LogArg::Kind kinds[maxArgs] {};
+		qint64 values[maxArgs] {}; ///< For strings the offset into the text in the low and the length in the high 32 bits.
+		int textLength         = 0;  ///< Code units of all string arguments.
+		quint64 longText       = 0;  ///< Start in m_longText if textLength exceeds maxText, the text is in the record otherwise.
+		char16_t text[maxText] {};
+	};
+
+	Record m_records[capacity];
+	std::atomic<quint64> m_head { 0 };  ///< Number of claimed records.
+	std::atomic<quint64> m_first { 0 }; ///< Index of the first record after the last reset.
+
+	char16_t m_longText[longTextCapacity] {};
+	std::atomic<quint64> m_longHead { 0 }; ///< Number of claimed code units in m_longText.
+
+	bool readRecord( quint64 index, LogMessage& out );
+	void writeLongText( quint64 pos, const char16_t* text, qsizetype length );
+	void readLongText( quint64 pos, char16_t* text, qsizetype length ) const;
+
+	QMutex m_spillMutex;
+	QWaitCondition m_spillWake;
+	std::thread m_spillThread;
+	QString m_spillPath;
+	bool m_spillRunning = false;
+	std::atomic<bool> m_spillActive { false }; ///< The writer thread has opened the log file.
+	std::atomic<quint64> m_spilled { 0 };      ///< Index of the next record the writer thread reads.
 
-	std::vector<LogMessage> m_messages;
+	void spillLoop();
+	void stopSpill();
 };
@@ -24,6 +24,8 @@
  */
 #include "octree.h"
 
+#include <algorithm>
+
 /** @brief Constructs an Octree node centered at (x, y, z) with half-extents (dx, dy, dz).
  *
  *  Becomes a leaf node if any half-extent is 4 or less.
@@ -82,19 +84,75 @@ void Octree::insertItem( int x, int y, int z, unsigned int item )
 			id += 1;
 		if ( z >= m_z )
 			id += 4;
-		if ( !m_children[id] )
+		child( id )->insertItem( x, y, z, item );
+	}
+}
+
+/** @brief Inserts many items at once.
+ *
+ *  Splits the range into the eight octants in place and hands every part to its
+ *  child in one call, so each node is visited once per batch instead of once per
+ *  item. Leaves reserve room for their whole part before inserting.
+ *
+ *  @param begin First entry, the range is reordered.
+ *  @param end   One past the last entry.
+ */
+void Octree::insertItems( Entry* begin, Entry* end )
+{
+	if ( begin == end )
+	{
+		return;
+	}
+	if ( m_isLeaf )
+	{
+		m_items.reserve( m_items.size() + ( end - begin ) );
+		for ( Entry* e = begin; e != end; ++e )
 		{
-			int x2         = m_dx / 2;
-			int y2         = m_dy / 2;
-			int z2         = m_dz / 2;
-			m_children[id] = new Octree(
-				( x >= m_x ) ? m_x + x2 : m_x - x2,
-				( y >= m_y ) ? m_y + y2 : m_y - y2,
-				( z >= m_z ) ? m_z + z2 : m_z - z2,
-				x2, y2, z2 );
+			m_items.insert( e->item );
 		}
-		m_children[id]->insertItem( x, y, z, item );
+		return;
+	}
+
+	// octant order matches the child IDs: z adds 4, x adds 2, y adds 1
+	Entry* bounds[9];
+	bounds[0] = begin;
+	bounds[8] = end;
+	bounds[4] = std::partition( begin, end, [this]( const Entry& e ) { return e.z < m_z; } );
+	for ( int z = 0; z < 8; z += 4 )
+	{
+		bounds[z + 2] = std::partition( bounds[z], bounds[z + 4], [this]( const Entry& e ) { return e.x < m_x; } );
+		for ( int x = z; x < z + 4; x += 2 )
+		{
+			bounds[x + 1] = std::partition( bounds[x], bounds[x + 2], [this]( const Entry& e ) { return e.y < m_y; } );
+		}
+	}
+	for ( int id = 0; id < 8; ++id )
+	{
+		if ( bounds[id] != bounds[id + 1] )
+		{
+			child( id )->insertItems( bounds[id], bounds[id + 1] );
+		}
+	}
+}
+
+/** @brief Returns the child node of an octant, creating it if it does not exist yet.
+ *  @param id Octant: +2 for the upper x half, +1 for the upper y half, +4 for the upper z half.
+ *  @return The child node.
+ */
+Octree* Octree::child( int id )
+{
+	if ( !m_children[id] )
+	{
+		int x2         = m_dx / 2;
+		int y2         = m_dy / 2;
+		int z2         = m_dz / 2;
+		m_children[id] = new Octree(
+			( id & 2 ) ? m_x + x2 : m_x - x2,
+			( id & 1 ) ? m_y + y2 : m_y - y2,
+			( id & 4 ) ? m_z + z2 : m_z - z2,
+			x2, y2, z2 );
 	}
+	return m_children[id];
 }
 
 /** @brief Removes an item from the given 3D position.
@@ -39,7 +39,17 @@ class Octree
 	Octree( int x, int y, int z, int dx, int dy, int dz );
 	~Octree();
 
+	/** @brief Position and ID of an item for insertItems(). */
+	struct Entry
+	{
+		int x;
+		int y;
+		int z;
+		unsigned int item;
+	};
+
 	void insertItem( int x, int y, int z, unsigned int item );
+	void insertItems( Entry* begin, Entry* end );
 	bool removeItem( int x, int y, int z, unsigned int item );
 
 	QList<unsigned int> query( int x, int y, int z, int limit = 999999999 ) const;
@@ -58,4 +68,6 @@ class Octree
 
 	Octree* m_children[8] = { 0 };
 	QSet<unsigned int> m_items;
+
+	Octree* child( int id );
 };
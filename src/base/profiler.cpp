@@ -0,0 +1,343 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file profiler.cpp
+ *  @brief Implementation of the tick profiler: sample recording, percentile
+ *         statistics and Chrome trace (Perfetto compatible) JSON export.
+ */
+
+#include "profiler.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+Profiler::TickSample Profiler::m_samples[Profiler::capacity];
+std::atomic<quint64> Profiler::m_head { 0 };
+bool Profiler::m_inTick = false;
+
+/** @brief Opens the sample for a new game tick. Called from the game thread only.
+ *  @param tick The game tick about to be processed.
+ */
+void Profiler::beginTick( quint64 tick )
+{
+	TickSample& sample = m_samples[m_head.load( std::memory_order_relaxed ) % capacity];
+	// Odd sequence marks the slot as being written
+	sample.seq.fetch_add( 1, std::memory_order_acq_rel );
+	std::atomic_thread_fence( std::memory_order_release );
+
+	sample.tick    = tick;
+	sample.startNs = now();
+	std::fill( std::begin( sample.startUs ), std::end( sample.startUs ), 0 );
+	std::fill( std::begin( sample.durationUs ), std::end( sample.durationUs ), 0 );
+	std::fill( std::begin( sample.counts ), std::end( sample.counts ), 0 );
+	m_inTick = true;
+}
+
+/** @brief Closes the current tick sample, records the total tick time and publishes the slot. */
+void Profiler::endTick()
+{
+	if ( !m_inTick )
+	{
+		return;
+	}
+	const quint64 head = m_head.load( std::memory_order_relaxed );
+	TickSample& sample = m_samples[head % capacity];
+	record( ProfileSection::Tick, sample.startNs, now() );
+	m_inTick = false;
+
+	sample.seq.fetch_add( 1, std::memory_order_release );
+	m_head.store( head + 1, std::memory_order_release );
+}
+
+/** @brief Adds a measured interval to the current tick sample.
+ *
+ *  Sections measured more than once per tick accumulate their duration and keep
+ *  the start offset of the first measurement. Calls outside of a tick are ignored.
+ *
+ *  @param section The subsystem that was measured.
+ *  @param startNs Start of the interval, as returned by now().
+ *  @param endNs   End of the interval, as returned by now().
+ */
+void Profiler::record( ProfileSection section, qint64 startNs, qint64 endNs )
+{
+	if ( !m_inTick )
+	{
+		return;
+	}
+	TickSample& sample = m_samples[m_head.load( std::memory_order_relaxed ) % capacity];
+	const int i        = (int)section;
+	if ( sample.durationUs[i] == 0 )
+	{
+		sample.startUs[i] = (qint32)( ( startNs - sample.startNs ) / 1000 );
+	}
+	sample.durationUs[i] += (qint32)qMax( 1LL, ( endNs - startNs ) / 1000 );
+}
+
+/** @brief Adds @p n to a counter of the current tick sample. Calls outside of a tick are ignored.
+ *  @param counter The counter.
+ *  @param n       Amount to add.
+ */
+void Profiler::count( ProfileCounter counter, int n )
+{
+	if ( !m_inTick )
+	{
+		return;
+	}
+	m_samples[m_head.load( std::memory_order_relaxed ) % capacity].counts[(int)counter] += n;
+}
+
+/** @brief Returns the display name of a profiler section.
+ *  @param section The section.
+ *  @return Name used in the debug window and in exported traces.
+ */
+QString Profiler::sectionName( ProfileSection section )
+{
+	switch ( section )
+	{
+		case ProfileSection::Tick: return "Tick";
+		case ProfileSection::Grass: return "World::processGrass";
+		case ProfileSection::Plants: return "Game::processPlants";
+		case ProfileSection::Creatures: return "CreatureManager::onTick";
+		case ProfileSection::Gnomes: return "GnomeManager::onTick";
+		case ProfileSection::Jobs: return "JobManager::onTick";
+		case ProfileSection::Stockpiles: return "StockpileManager::onTick";
+		case ProfileSection::Farming: return "FarmingManager::onTick";
+		case ProfileSection::Workshops: return "WorkshopManager::onTick";
+		case ProfileSection::Rooms: return "RoomManager::onTick";
+		case ProfileSection::ItemHistory: return "ItemHistory::onTick";
+		case ProfileSection::Timers: return "Game::timers";
+		case ProfileSection::Events: return "EventManager::onTick";
+		case ProfileSection::Mechanisms: return "MechanismManager::onTick";
+		case ProfileSection::Fluids: return "FluidManager::onTick";
+		case ProfileSection::Sound: return "SoundManager::onTick";
+		case ProfileSection::Water: return "World::processWater";
+		case ProfileSection::TileUpdates: return "World::applyTileUpdates";
+		case ProfileSection::PathFinder: return "PathFinder::findPaths";
+		case ProfileSection::Aggregators: return "Aggregators";
+		case ProfileSection::COUNT: break;
+	}
+	return "";
+}
+
+/** @brief Returns the display name of a profiler counter.
+ *  @param counter The counter.
+ *  @return Name used in exported traces and replay reports.
+ */
+QString Profiler::counterName( ProfileCounter counter )
+{
+	switch ( counter )
+	{
+		case ProfileCounter::AutomatonsWoken: return "AutomatonsWoken";
+		case ProfileCounter::WorkshopsWoken: return "WorkshopsWoken";
+		case ProfileCounter::COUNT: break;
+	}
+	return "";
+}
+
+/** @brief Copies up to @p numTicks of the most recent published samples without locking.
+ *
+ *  Slots that are overwritten by the game thread while being copied are skipped.
+ *
+ *  @param out      Destination array, must hold at least @p numTicks entries.
+ *  @param numTicks Maximum number of samples to copy.
+ *  @return Number of samples copied, oldest first.
+ */
+int Profiler::readSamples( SampleCopy* out, int numTicks )
+{
+	const quint64 head  = m_head.load( std::memory_order_acquire );
+	// Leave one slot as margin, it is the one being written right now
+	const quint64 count = qMin<quint64>( head, qMin( numTicks, capacity - 1 ) );
+
+	int copied = 0;
+	for ( quint64 i = head - count; i < head; ++i )
+	{
+		const TickSample& sample = m_samples[i % capacity];
+		const quint32 seqBefore  = sample.seq.load( std::memory_order_acquire );
+		if ( seqBefore & 1 )
+		{
+			continue;
+		}
+		SampleCopy& copy = out[copied];
+		copy.tick        = sample.tick;
+		copy.startNs     = sample.startNs;
+		std::copy( std::begin( sample.startUs ), std::end( sample.startUs ), std::begin( copy.startUs ) );
+		std::copy( std::begin( sample.durationUs ), std::end( sample.durationUs ), std::begin( copy.durationUs ) );
+		std::copy( std::begin( sample.counts ), std::end( sample.counts ), std::begin( copy.counts ) );
+		std::atomic_thread_fence( std::memory_order_acquire );
+		if ( sample.seq.load( std::memory_order_relaxed ) == seqBefore )
+		{
+			++copied;
+		}
+	}
+	return copied;
+}
+
+/** @brief Computes per-section percentiles over the most recent ticks.
+ *  @param numTicks Number of ticks to evaluate, at most the ring buffer capacity.
+ *  @return One QVariantMap per section with keys "Section", "P50", "P90", "P99", "Max" (milliseconds) and "Samples".
+ */
+QVariantList Profiler::percentiles( int numTicks )
+{
+	numTicks = qBound( 1, numTicks, capacity );
+	std::unique_ptr<SampleCopy[]> samples( new SampleCopy[numTicks] );
+	const int count = readSamples( samples.get(), numTicks );
+
+	QVariantList out;
+	std::vector<qint32> values;
+	values.reserve( count );
+	for ( int s = 0; s < (int)ProfileSection::COUNT; ++s )
+	{
+		values.clear();
+		for ( int i = 0; i < count; ++i )
+		{
+			values.push_back( samples[i].durationUs[s] );
+		}
+
+		auto percentile = [&values]( double p ) -> double {
+			if ( values.empty() )
+			{
+				return 0.0;
+			}
+			const size_t n = qMin( values.size() - 1, (size_t)( p * values.size() ) );
+			std::nth_element( values.begin(), values.begin() + n, values.end() );
+			return values[n] / 1000.0;
+		};
+
+		QVariantMap entry;
+		entry.insert( "Section", sectionName( (ProfileSection)s ) );
+		entry.insert( "P50", percentile( 0.5 ) );
+		entry.insert( "P90", percentile( 0.9 ) );
+		entry.insert( "P99", percentile( 0.99 ) );
+		entry.insert( "Max", percentile( 1.0 ) );
+		entry.insert( "Samples", count );
+		out.append( entry );
+	}
+	return out;
+}
+
+/** @brief Computes per-counter averages over the most recent ticks.
+ *  @param numTicks Number of ticks to evaluate, at most the ring buffer capacity.
+ *  @return One QVariantMap per counter with keys "Counter", "Average", "Max" and "Samples".
+ */
+QVariantList Profiler::counters( int numTicks )
+{
+	numTicks = qBound( 1, numTicks, capacity );
+	std::unique_ptr<SampleCopy[]> samples( new SampleCopy[numTicks] );
+	const int count = readSamples( samples.get(), numTicks );
+
+	QVariantList out;
+	for ( int c = 0; c < (int)ProfileCounter::COUNT; ++c )
+	{
+		qint64 sum = 0;
+		qint32 max = 0;
+		for ( int i = 0; i < count; ++i )
+		{
+			sum += samples[i].counts[c];
+			max = qMax( max, samples[i].counts[c] );
+		}
+
+		QVariantMap entry;
+		entry.insert( "Counter", counterName( (ProfileCounter)c ) );
+		entry.insert( "Average", count ? (double)sum / count : 0.0 );
+		entry.insert( "Max", max );
+		entry.insert( "Samples", count );
+		out.append( entry );
+	}
+	return out;
+}
+
+/** @brief Writes the most recent ticks as a Chrome trace event file.
+ *
+ *  Produces complete ("X") events, one per measured section and tick, and one counter
+ *  ("C") event per tick, which load in chrome://tracing and in the Perfetto UI.
+ *
+ *  @param path     Output file path.
+ *  @param numTicks Number of ticks to export, at most the ring buffer capacity.
+ *  @return True if the file was written.
+ */
+bool Profiler::exportChromeTrace( QString path, int numTicks )
+{
+	numTicks = qBound( 1, numTicks, capacity );
+	std::unique_ptr<SampleCopy[]> samples( new SampleCopy[numTicks] );
+	const int count = readSamples( samples.get(), numTicks );
+
+	QFile file( path );
+	if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+	{
+		qWarning() << "Profiler: failed to open" << path;
+		return false;
+	}
+
+	const qint64 origin = count ? samples[0].startNs : 0;
+
+	QTextStream out( &file );
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for ( int i = 0; i < count; ++i )
+	{
+		const SampleCopy& sample = samples[i];
+		const qint64 tickStartUs = ( sample.startNs - origin ) / 1000;
+		for ( int s = 0; s < (int)ProfileSection::COUNT; ++s )
+		{
+			if ( sample.durationUs[s] == 0 )
+			{
+				continue;
+			}
+			if ( !first )
+			{
+				out << ",";
+			}
+			first = false;
+			out << "\n{\"name\":\"" << sectionName( (ProfileSection)s ) << "\",\"cat\":\"tick\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ( s == 0 ? 1 : 2 )
+				<< ",\"ts\":" << tickStartUs + sample.startUs[s] << ",\"dur\":" << sample.durationUs[s]
+				<< ",\"args\":{\"tick\":" << sample.tick << "}}";
+		}
+		if ( !first )
+		{
+			out << ",";
+		}
+		first = false;
+		out << "\n{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << tickStartUs << ",\"args\":{";
+		for ( int c = 0; c < (int)ProfileCounter::COUNT; ++c )
+		{
+			out << ( c ? "," : "" ) << "\"" << counterName( (ProfileCounter)c ) << "\":" << sample.counts[c];
+		}
+		out << "}}";
+	}
+	out << "\n]}\n";
+	out.flush();
+
+	qDebug() << "Profiler: exported" << count << "ticks to" << path;
+	return true;
+}
+
+/** @brief Discards all recorded samples, e.g. when a new game is loaded. */
+void Profiler::reset()
+{
+	m_inTick = false;
+	for ( auto& sample : m_samples )
+	{
+		sample.seq.fetch_add( 2, std::memory_order_relaxed );
+		sample.tick = 0;
+	}
+	m_head.store( 0, std::memory_order_release );
+}
@@ -0,0 +1,149 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file profiler.h
+ * @brief Per-subsystem tick profiler with a lock-free ring buffer of tick samples.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVariantList>
+
+#include <atomic>
+#include <chrono>
+
+/** @brief Subsystems measured once per game tick. */
+enum class ProfileSection : unsigned char
+{
+	Tick,
+	Grass,
+	Plants,
+	Creatures,
+	Gnomes,
+	Jobs,
+	Stockpiles,
+	Farming,
+	Workshops,
+	Rooms,
+	ItemHistory,
+	Timers,
+	Events,
+	Mechanisms,
+	Fluids,
+	Sound,
+	Water,
+	TileUpdates,
+	PathFinder,
+	Aggregators,
+	COUNT
+};
+
+/** @brief Events counted once per game tick, next to the section timings. */
+enum class ProfileCounter : unsigned char
+{
+	AutomatonsWoken,
+	WorkshopsWoken,
+	COUNT
+};
+
+/**
+ * @brief Static-only collector for per-tick subsystem timings.
+ *
+ * The game thread opens a sample with beginTick(), ProfileScope instances record
+ * the start offset and duration of each subsystem, and endTick() publishes the
+ * sample into a fixed-size ring buffer. Every slot carries a sequence counter
+ * (seqlock), so readers on any thread copy samples without taking a lock and
+ * simply skip a slot that is being overwritten while they read it.
+ */
+class Profiler
+{
+public:
+	Profiler()  = delete;
+	~Profiler() = delete;
+
+	static constexpr int capacity = 1024; ///< Number of ticks kept in the ring buffer.
+
+	static void beginTick( quint64 tick );
+	static void endTick();
+	static void record( ProfileSection section, qint64 startNs, qint64 endNs );
+	static void count( ProfileCounter counter, int n = 1 );
+
+	static qint64 now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+	static QString sectionName( ProfileSection section );
+	static QString counterName( ProfileCounter counter );
+
+	static QVariantList percentiles( int numTicks = capacity );
+	static QVariantList counters( int numTicks = capacity );
+	static bool exportChromeTrace( QString path, int numTicks = capacity );
+
+	static void reset();
+
+private:
+	struct TickSample
+	{
+		std::atomic<quint32> seq { 0 };
+		quint64 tick    = 0;
+		qint64 startNs  = 0;
+		qint32 startUs[(int)ProfileSection::COUNT]    = {};
+		qint32 durationUs[(int)ProfileSection::COUNT] = {};
+		qint32 counts[(int)ProfileCounter::COUNT]     = {};
+	};
+
+	struct SampleCopy
+	{
+		quint64 tick   = 0;
+		qint64 startNs = 0;
+		qint32 startUs[(int)ProfileSection::COUNT]    = {};
+		qint32 durationUs[(int)ProfileSection::COUNT] = {};
+		qint32 counts[(int)ProfileCounter::COUNT]     = {};
+	};
+
+	static int readSamples( SampleCopy* out, int numTicks );
+
+	static TickSample m_samples[capacity];
+	static std::atomic<quint64> m_head; ///< Number of published samples.
+	static bool m_inTick;
+};
+
+/**
+ * @brief RAII timer that records the lifetime of the scope into the current tick sample.
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope( ProfileSection section ) :
+		m_section( section ),
+		m_start( Profiler::now() )
+	{
+	}
+	~ProfileScope()
+	{
+		Profiler::record( m_section, m_start, Profiler::now() );
+	}
+
+	ProfileScope( const ProfileScope& )            = delete;
+	ProfileScope& operator=( const ProfileScope& ) = delete;
+
+private:
+	ProfileSection m_section;
+	qint64 m_start;
+};
@@ -20,8 +20,8 @@
  *
  *  Assigns every walkable tile to a region via flood-fill, tracks inter-region
  *  connections (stairs, scaffolds, ramps), and supports dynamic updates when
- *  tiles become walkable or unwalkable. Provides BFS-based reachability queries
- *  over the region graph with result caching.
+ *  tiles become walkable or unwalkable. Keeps the connected components of the
+ *  region graph up to date, so reachability queries compare two integers.
  */
 #include "regionmap.h"
 
@@ -34,6 +34,14 @@
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QQueue>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
 /** @brief Constructs the RegionMap.
  *  @param parent Pointer to the owning World instance.
  */
@@ -52,6 +60,12 @@ void RegionMap::clear()
 {
 	m_regionMap.clear();
 	m_regions.clear();
+	m_regionTiles.clear();
+	m_componentOf.clear();
+	m_componentMembers.clear();
+	m_freeComponents.clear();
+	m_pending.clear();
+	m_pendingTiles.resize( 0 );
 
 	m_dimX = 0;
 	m_dimY = 0;
@@ -66,6 +80,7 @@ void RegionMap::clear()
  */
 unsigned int RegionMap::regionID( unsigned int tileID )
 {
+	applyUpdates();
 	return m_regions[m_regionMap[tileID]].id();
 }
 
@@ -75,6 +90,7 @@ unsigned int RegionMap::regionID( unsigned int tileID )
  */
 unsigned int RegionMap::regionID( const Position& pos )
 {
+	applyUpdates();
 	return m_regions[m_regionMap[index( pos )]].id();
 }
 
@@ -84,6 +100,7 @@ unsigned int RegionMap::regionID( const Position& pos )
  */
 Region& RegionMap::region( const Position& pos )
 {
+	applyUpdates();
 	return m_regions[m_regionMap[index( pos )]];
 }
 
@@ -93,13 +110,17 @@ Region& RegionMap::region( const Position& pos )
  */
 Region& RegionMap::region( unsigned int id )
 {
+	applyUpdates();
 	return m_regions[id];
 }
 
-/** @brief Initializes regions by flood-filling all walkable, passable tiles.
+/** @brief Initializes regions by labelling all walkable, passable tiles.
  *
- *  Iterates over every tile in the world. When an unassigned walkable tile is found,
- *  creates a new region and flood-fills all contiguous walkable tiles into it.
+ *  Regions never span more than one Z-level, so every level is labelled
+ *  independently on a pool of worker threads (see labelLevel()). Each level
+ *  produces local region numbers; a serial merge step turns them into global
+ *  IDs by offsetting with the running region count of the levels below.
+ *  The resulting IDs are identical to a serial z/y/x scan with flood-fill.
  *  After all regions are created, scans for stairs, scaffolds, and ramps to
  *  establish inter-region vertical connections (to/from).
  */
@@ -112,33 +133,86 @@ void RegionMap::initRegions()
 	m_regions.clear();
 	m_regions.emplace_back( 0 );
 	m_regionMap.clear();
-	m_regionMap.resize( m_world->world().size() );
-	for ( auto i = 0; i < m_regionMap.size(); ++i )
-		m_regionMap[i] = 0;
+	m_regionMap.resize( m_world->world().size(), 0 );
+	m_pending.clear();
+	m_pendingTiles.resize( m_regionMap.size() );
 
 	QElapsedTimer timer;
 	timer.start();
 
-	for ( int z = 1; z < m_dimZ - 1; ++z )
+	std::vector<unsigned int> regionsPerLevel( m_dimZ, 0 );
 	{
-		for ( int y = 1; y < m_dimY - 1; ++y )
+		std::atomic<int> nextLevel( 1 );
+		const int numWorkers = qBound( 1, (int)std::thread::hardware_concurrency(), qMax( 1, m_dimZ - 2 ) );
+
+		std::vector<std::future<void>> tasks;
+		for ( int i = 0; i < numWorkers; ++i )
 		{
-			for ( int x = 1; x < m_dimX - 1; ++x )
-			{
-				Tile& tile = m_world->getTile( x, y, z );
-				if ( ( tile.flags & TileFlag::TF_WALKABLE && !( tile.flags & TileFlag::TF_NOPASS ) ) && ( m_regionMap[index( x, y, z )] == 0 ) )
+			tasks.emplace_back( std::async( std::launch::async, [this, &nextLevel, &regionsPerLevel]() {
+				for ( int z = nextLevel++; z < m_dimZ - 1; z = nextLevel++ )
 				{
-					////qDebug() << "found new tile without region";
-					// assign new region numer
-					unsigned int id               = static_cast<unsigned int>( m_regions.size() );
-					m_regionMap[index( x, y, z )] = id;
-					m_regions.emplace_back( id );
+					regionsPerLevel[z] = labelLevel( z );
+				}
+			} ) );
+		}
+		for ( auto& task : tasks )
+		{
+			task.get();
+		}
+	}
 
-					floodFill( 0, id, x, y, z );
+	// Boundary merge: local labels of each level become global region IDs
+	std::vector<unsigned int> levelOffset( m_dimZ, 0 );
+	unsigned int numRegions = 0;
+	for ( int z = 1; z < m_dimZ - 1; ++z )
+	{
+		levelOffset[z] = numRegions;
+		numRegions += regionsPerLevel[z];
+	}
+	{
+		std::atomic<int> nextLevel( 1 );
+		const int numWorkers = qBound( 1, (int)std::thread::hardware_concurrency(), qMax( 1, m_dimZ - 2 ) );
+
+		std::vector<std::future<void>> tasks;
+		for ( int i = 0; i < numWorkers; ++i )
+		{
+			tasks.emplace_back( std::async( std::launch::async, [this, &nextLevel, &levelOffset]() {
+				const size_t levelSize = (size_t)m_dimX * m_dimY;
+				for ( int z = nextLevel++; z < m_dimZ - 1; z = nextLevel++ )
+				{
+					const unsigned int offset = levelOffset[z];
+					if ( offset == 0 )
+					{
+						continue;
+					}
+					auto first = m_regionMap.begin() + z * levelSize;
+					for ( auto it = first; it != first + levelSize; ++it )
+					{
+						if ( *it )
+						{
+							*it += offset;
+						}
+					}
 				}
-			}
+			} ) );
+		}
+		for ( auto& task : tasks )
+		{
+			task.get();
 		}
 	}
+
+	m_regions.reserve( numRegions + 1 );
+	for ( unsigned int id = 1; id <= numRegions; ++id )
+	{
+		m_regions.emplace_back( id );
+	}
+	m_regionTiles.assign( numRegions + 1, 0 );
+	for ( auto id : m_regionMap )
+	{
+		++m_regionTiles[id];
+	}
+
 	unsigned int currentIndex = 0;
 	for ( int z = 1; z < m_dimZ - 1; ++z )
 	{
@@ -166,15 +240,114 @@ void RegionMap::initRegions()
 		}
 	}
 
+	rebuildComponents();
+
 	qDebug() << "initialized " << m_regions.size() << " regions in " + QString::number( timer.elapsed() ) + " ms";
 	m_initialized = true;
 }
 
+/** @brief Labels the connected walkable areas of a single Z-level.
+ *
+ *  Classic two-pass connected-component labelling: the first pass assigns
+ *  provisional labels in scan order and records equivalences in a union-find
+ *  whose roots are always the smallest label, the second pass resolves every
+ *  tile to a compact local label (1..n) numbered by first appearance in scan
+ *  order. Only touches the slice of m_regionMap belonging to @p z, so levels
+ *  can be labelled concurrently.
+ *
+ *  @param z The Z-level to label.
+ *  @return Number of regions found on the level.
+ */
+unsigned int RegionMap::labelLevel( int z )
+{
+	std::vector<unsigned int> parent( 1, 0 );
+
+	auto findRoot = [&parent]( unsigned int label ) {
+		while ( parent[label] != label )
+		{
+			parent[label] = parent[parent[label]];
+			label         = parent[label];
+		}
+		return label;
+	};
+
+	for ( int y = 1; y < m_dimY - 1; ++y )
+	{
+		unsigned int currentIndex = index( 1, y, z );
+		for ( int x = 1; x < m_dimX - 1; ++x, ++currentIndex )
+		{
+			if ( !isPassable( currentIndex ) )
+			{
+				continue;
+			}
+			const unsigned int west  = m_regionMap[currentIndex - 1];
+			const unsigned int north = m_regionMap[currentIndex - m_dimX];
+			if ( west == 0 && north == 0 )
+			{
+				const unsigned int label = static_cast<unsigned int>( parent.size() );
+				parent.push_back( label );
+				m_regionMap[currentIndex] = label;
+			}
+			else if ( west == 0 || north == 0 )
+			{
+				m_regionMap[currentIndex] = west | north;
+			}
+			else
+			{
+				const unsigned int rootWest  = findRoot( west );
+				const unsigned int rootNorth = findRoot( north );
+				const unsigned int root      = qMin( rootWest, rootNorth );
+				parent[rootWest]             = root;
+				parent[rootNorth]            = root;
+				m_regionMap[currentIndex]    = root;
+			}
+		}
+	}
+
+	// Roots are the smallest label of their component, so numbering them in
+	// ascending order reproduces the order in which a scan would find them.
+	std::vector<unsigned int> compact( parent.size(), 0 );
+	unsigned int numRegions = 0;
+	for ( unsigned int label = 1; label < parent.size(); ++label )
+	{
+		const unsigned int root = findRoot( label );
+		if ( root == label )
+		{
+			compact[label] = ++numRegions;
+		}
+		else
+		{
+			compact[label] = compact[root];
+		}
+	}
+
+	for ( int y = 1; y < m_dimY - 1; ++y )
+	{
+		unsigned int currentIndex = index( 1, y, z );
+		for ( int x = 1; x < m_dimX - 1; ++x, ++currentIndex )
+		{
+			m_regionMap[currentIndex] = compact[m_regionMap[currentIndex]];
+		}
+	}
+	return numRegions;
+}
+
+/** @brief Returns whether a tile can be part of a region (walkable and not a no-pass zone).
+ *  @param tileID Linear index into the world tile array.
+ */
+bool RegionMap::isPassable( unsigned int tileID )
+{
+	const Tile& tile = m_world->getTile( tileID );
+	return tile.flags & TileFlag::TF_WALKABLE && !( tile.flags & TileFlag::TF_NOPASS );
+}
+
 /** @brief Merges one region into another after a tile becomes walkable.
  *
  *  Flood-fills tiles from @p oldRegionID into @p newRegionID starting at @p pos,
  *  then migrates all vertical connections (to/from) from the old region to the new one,
- *  updating the connected regions' reciprocal connection sets.
+ *  updating the connected regions' reciprocal connection sets. The emptied old region
+ *  is left without connections and leaves its component, so a later recomputeComponent()
+ *  can't walk stale connections.
  *
  *  @param pos          The position that triggered the merge.
  *  @param oldRegionID  The region being absorbed.
@@ -182,7 +355,14 @@ void RegionMap::initRegions()
  */
 void RegionMap::mergeRegions( const Position& pos, unsigned int oldRegionID, unsigned int newRegionID )
 {
+	if ( m_regionTiles[oldRegionID] == 0 )
+	{
+		// several neighbors of the tile were in the old region, it is merged already
+		return;
+	}
 	floodFill( oldRegionID, newRegionID, pos.x, pos.y, pos.z );
+	// everything connected to the old region is connected to the new one from now on
+	linkRegions( oldRegionID, newRegionID );
 
 	Region& oldRegion = m_regions[oldRegionID];
 	Region& newRegion = m_regions[newRegionID];
@@ -206,6 +386,13 @@ void RegionMap::mergeRegions( const Position& pos, unsigned int oldRegionID, uns
 		}
 		m_regions[con].removeAllConnectionsTo( oldRegionID );
 	}
+
+	// the old region has no tiles left, it must not keep connecting anything
+	oldRegion.clearConnectionsTo();
+	oldRegion.clearConnectionsFrom();
+	auto& members = m_componentMembers[m_componentOf[oldRegionID]];
+	members.erase( std::find( members.begin(), members.end(), oldRegionID ) );
+	m_componentOf[oldRegionID] = std::numeric_limits<unsigned int>::max();
 }
 
 /** @brief Redistributes vertical connections after a region has been split.
@@ -213,16 +400,14 @@ void RegionMap::mergeRegions( const Position& pos, unsigned int oldRegionID, uns
  *  After flood-fill has reassigned some tiles from @p fromRegionID to @p intoRegionID,
  *  this method examines all existing connections (to and from) and reassigns them
  *  based on whether the connection position now belongs to the old or new region.
- *  Clears the cached reachability results since connectivity may have changed.
+ *  Afterwards the connected component of the old region is recomputed, since the two
+ *  parts may no longer reach each other.
  *
  *  @param fromRegionID The original region that was split.
  *  @param intoRegionID The newly created region from the split.
  */
 void RegionMap::splitRegions( unsigned int fromRegionID, unsigned int intoRegionID )
 {
-	// Purge cache in case of split
-	m_cachedConnections.clear();
-
 	Region& fromRegion = m_regions[fromRegionID];
 	Region& intoRegion = m_regions[intoRegionID];
 
@@ -275,10 +460,16 @@ void RegionMap::splitRegions( unsigned int fromRegionID, unsigned int intoRegion
 					downRegion.addConnectionTo( regionID( con ), curPos );
 					// insert into the region above this region
 					m_regions[m_regionMap[index( con )]].addConnectionFrom( downRegionID, curPos );
+					linkRegions( downRegionID, regionID( con ) );
 				}
 			}
 		}
 	}
+
+	// the new region starts out in the component of the old one, then the component is split
+	// along whatever connections are left
+	linkRegions( fromRegionID, intoRegionID );
+	recomputeComponent( m_componentOf[fromRegionID] );
 }
 
 /** @brief Computes the linear index for a 3D tile coordinate.
@@ -301,14 +492,27 @@ unsigned int RegionMap::index( const Position& pos )
 	return pos.x + pos.y * m_dimX + pos.z * m_dimX * m_dimY;
 }
 
+/** @brief Moves a tile into a region and keeps the tile counts of both regions current.
+ *  @param tileID   Linear index into the region map.
+ *  @param regionID The new region of the tile, 0 for none.
+ */
+void RegionMap::setRegion( unsigned int tileID, unsigned int regionID )
+{
+	--m_regionTiles[m_regionMap[tileID]];
+	++m_regionTiles[regionID];
+	m_regionMap[tileID] = regionID;
+}
+
 /** @brief Flood-fills contiguous walkable tiles from one region ID to another.
  *
  *  Uses a scanline flood-fill algorithm: for each queued position, scans east and
  *  west along the X axis, reassigning tiles from @p oldID to @p newID. Adjacent
  *  rows (Y-1, Y+1) are enqueued when a new span of matching tiles is found.
- *  Also marks affected tiles for rendering update.
+ *  Follows the region map, not tile flags: a tile that changed but is still queued in
+ *  applyUpdates() keeps its old region until it is applied, so the whole old region
+ *  is relabelled and regions stay contiguous.
  *
- *  @param oldID The region ID to replace (0 for initial assignment).
+ *  @param oldID The region ID to replace.
  *  @param newID The region ID to assign.
  *  @param x_    Starting X coordinate.
  *  @param y_    Starting Y coordinate.
@@ -325,7 +529,6 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 	while ( !floodQueue.isEmpty() )
 	{
 		Position p0 = floodQueue.dequeue();
-		m_world->addToUpdateList( p0 );
 		//qDebug() << "continue with " << p0.toString();
 		unsigned int currentIndex = index( p0.x, p0.y, p0.z );
 
@@ -333,16 +536,15 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 		bool nextLineAdded = false;
 		for ( int x = p0.x; x < m_dimX - 1; ++x )
 		{
-			if ( m_world->getTile( currentIndex ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex ).flags & TileFlag::TF_NOPASS ) )
+			if ( m_regionMap[currentIndex] == oldID || m_regionMap[currentIndex] == newID )
 			{
-				m_regionMap[currentIndex] = newID;
-				m_world->addToUpdateList( Position( x, p0.y, p0.z ) );
+				setRegion( currentIndex, newID );
 
-				if ( ( m_world->getTile( currentIndex - m_dimX ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex - m_dimX ).flags & TileFlag::TF_NOPASS ) ) && ( m_regionMap[currentIndex - m_dimX] == oldID ) )
+				if ( m_regionMap[currentIndex - m_dimX] == oldID )
 				{
 					if ( !prevLineAdded )
 					{
-						m_regionMap[currentIndex - m_dimX] = newID;
+						setRegion( currentIndex - m_dimX, newID );
 						Position pos( x, p0.y - 1, p0.z );
 						floodQueue.enqueue( pos );
 						prevLineAdded = true;
@@ -353,11 +555,11 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 				{
 					prevLineAdded = false;
 				}
-				if ( ( m_world->getTile( currentIndex + m_dimX ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex + m_dimX ).flags & TileFlag::TF_NOPASS ) ) && ( m_regionMap[currentIndex + m_dimX] == oldID ) )
+				if ( m_regionMap[currentIndex + m_dimX] == oldID )
 				{
 					if ( !nextLineAdded )
 					{
-						m_regionMap[currentIndex + m_dimX] = newID;
+						setRegion( currentIndex + m_dimX, newID );
 						Position pos( x, p0.y + 1, p0.z );
 						floodQueue.enqueue( pos );
 						nextLineAdded = true;
@@ -382,16 +584,15 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 		nextLineAdded = false;
 		for ( int x = p0.x; x > 0; --x )
 		{
-			if ( m_world->getTile( currentIndex ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex ).flags & TileFlag::TF_NOPASS ) )
+			if ( m_regionMap[currentIndex] == oldID || m_regionMap[currentIndex] == newID )
 			{
-				m_regionMap[currentIndex] = newID;
-				m_world->addToUpdateList( Position( x, p0.y, p0.z ) );
+				setRegion( currentIndex, newID );
 
-				if ( ( m_world->getTile( currentIndex - m_dimX ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex - m_dimX ).flags & TileFlag::TF_NOPASS ) ) && ( m_regionMap[currentIndex - m_dimX] == oldID ) )
+				if ( m_regionMap[currentIndex - m_dimX] == oldID )
 				{
 					if ( !prevLineAdded )
 					{
-						m_regionMap[currentIndex - m_dimX] = newID;
+						setRegion( currentIndex - m_dimX, newID );
 						Position pos( x, p0.y - 1, p0.z );
 						floodQueue.enqueue( pos );
 						prevLineAdded = true;
@@ -401,11 +602,11 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 				{
 					prevLineAdded = false;
 				}
-				if ( ( m_world->getTile( currentIndex + m_dimX ).flags & TileFlag::TF_WALKABLE && !( m_world->getTile( currentIndex + m_dimX ).flags & TileFlag::TF_NOPASS ) ) && ( m_regionMap[currentIndex + m_dimX] == oldID ) )
+				if ( m_regionMap[currentIndex + m_dimX] == oldID )
 				{
 					if ( !nextLineAdded )
 					{
-						m_regionMap[currentIndex + m_dimX] = newID;
+						setRegion( currentIndex + m_dimX, newID );
 						Position pos( x, p0.y + 1, p0.z );
 						floodQueue.enqueue( pos );
 						nextLineAdded = true;
@@ -427,20 +628,45 @@ void RegionMap::floodFill( unsigned int oldID, unsigned int newID, int x_, int y
 	//if( z_ == 100 ) qDebug() << "initialized region 100 in " +  QString::number( timer.elapsed() ) + " ms";
 }
 
-/** @brief Handles a tile walkability change at the given position.
+/** @brief Queues a tile whose walkability or vertical connections may have changed.
  *
- *  If the tile is now walkable, assigns it to an existing or new region and
- *  merges adjacent regions if needed. If the tile is no longer walkable, removes
- *  it from its region and checks for region splits. In both cases, updates
- *  vertical connections (stairs/ramps/scaffolds) at the position.
+ *  A tile is queued once no matter how often it changes before the queue is
+ *  applied, see applyUpdates().
  *
  *  @param pos The position of the tile that changed.
  */
 void RegionMap::updatePosition( const Position& pos )
 {
-	if ( m_initialized )
+	if ( m_initialized && m_pendingTiles.set( index( pos ) ) )
+	{
+		m_pending.push_back( pos );
+	}
+}
+
+/** @brief Applies all queued tile changes.
+ *
+ *  Tiles that are walkable now join or merge regions, tiles that aren't any more
+ *  leave their region, which may split it. Vertical connections (stairs, ramps,
+ *  scaffolds) are updated afterwards, when the regions on both levels are final.
+ *  Tiles are handled in the order they were queued, which keeps replays
+ *  deterministic.
+ */
+void RegionMap::applyUpdates()
+{
+	if ( m_pending.empty() )
+	{
+		return;
+	}
+	// queries made while applying must not apply the queue again
+	std::vector<Position> pending;
+	pending.swap( m_pending );
+	for ( const auto& pos : pending )
+	{
+		m_pendingTiles.reset( index( pos ) );
+	}
+
+	for ( const auto& pos : pending )
 	{
-		//qDebug() << "update position " << pos.toString();
 		if ( m_world->isWalkableGnome( pos ) )
 		{
 			updatePositionSetWalkable( pos );
@@ -449,8 +675,23 @@ void RegionMap::updatePosition( const Position& pos )
 		{
 			updatePositionClearWalkable( pos );
 		}
+	}
+	for ( const auto& pos : pending )
+	{
 		updateConnectedRegions( pos );
 	}
+
+	// keep the allocation for the next batch
+	if ( m_pending.empty() )
+	{
+		pending.clear();
+		m_pending.swap( pending );
+	}
+
+	if ( Global::debugMode )
+	{
+		verifyComponents();
+	}
 }
 
 /** @brief Removes a tile from its region when it becomes unwalkable.
@@ -468,7 +709,7 @@ void RegionMap::updatePositionClearWalkable( const Position& pos )
 		if ( m_regionMap[index( pos )] != 0 )
 		{
 			// check for possible split of regions
-			m_regionMap[index( pos )] = 0;
+			setRegion( index( pos ), 0 );
 
 			bool isSplit = checkSplit( pos );
 		}
@@ -506,13 +747,11 @@ void RegionMap::updatePositionSetWalkable( const Position& pos )
 			if ( region == 0 )
 			{
 				// if no neighbor with region, start new region
-				unsigned int id           = static_cast<unsigned int>( m_regions.size() );
-				m_regionMap[index( pos )] = id;
-				m_regions.emplace_back( id );
+				setRegion( index( pos ), newRegion() );
 			}
 			else
 			{
-				m_regionMap[index( pos )] = region;
+				setRegion( index( pos ), region );
 
 				// if neighbors have different regions -> merge
 
@@ -565,6 +804,7 @@ void RegionMap::updateConnectedRegions( const Position& pos )
 				m_regions[m_regionMap[currentIndex]].addConnectionTo( m_regions[m_regionMap[index( con )]].id(), pos );
 				// insert into the region above this region
 				m_regions[m_regionMap[index( con )]].addConnectionFrom( m_regions[m_regionMap[currentIndex]].id(), pos );
+				linkRegions( m_regionMap[currentIndex], m_regionMap[index( con )] );
 			}
 		}
 	}
@@ -572,387 +812,429 @@ void RegionMap::updateConnectedRegions( const Position& pos )
 
 /** @brief Checks whether removing a tile caused its region to split.
  *
- *  Examines the four cardinal neighbors. When two neighbors share the same region
- *  but may no longer be connected (no direct path via diagonal corners), performs
- *  a flood-based connectivity check. If a split is detected, creates a new region
- *  and flood-fills one side, then redistributes connections via splitRegions().
- *  Rechecks after each split since region IDs may change.
+ *  Groups the four cardinal neighbors by region, treating two neighbors next to
+ *  each other on the 8-ring as locally connected when the corner tile between
+ *  them belongs to the same region. A region with a single local group cannot
+ *  have been split. Otherwise the groups race each other in splitFlood(), which
+ *  only explores as much of the region as the smaller side(s) of a split occupy.
  *
  *  @param pos The position of the removed tile.
- *  @return Always returns false (splits are handled in-place).
+ *  @return True if at least one region was split.
  */
 bool RegionMap::checkSplit( const Position& pos )
 {
-	unsigned int region1 = m_regionMap[index( pos.x - 1, pos.y, pos.z )];
-	unsigned int region2 = m_regionMap[index( pos.x + 1, pos.y, pos.z )];
-	unsigned int region3 = m_regionMap[index( pos.x, pos.y - 1, pos.z )];
-	unsigned int region4 = m_regionMap[index( pos.x, pos.y + 1, pos.z )];
-
-	unsigned int between13 = m_regionMap[index( pos.x - 1, pos.y - 1, pos.z )];
-	unsigned int between14 = m_regionMap[index( pos.x - 1, pos.y + 1, pos.z )];
-
-	unsigned int between23 = m_regionMap[index( pos.x + 1, pos.y - 1, pos.z )];
-	unsigned int between24 = m_regionMap[index( pos.x + 1, pos.y + 1, pos.z )];
+	// Cardinal and corner neighbors in ring order: N, NE, E, SE, S, SW, W, NW
+	const unsigned int center = index( pos );
+	const int ringOffset[8]   = { -m_dimX, -m_dimX + 1, 1, m_dimX + 1, m_dimX, m_dimX - 1, -1, -m_dimX - 1 };
+	unsigned int ring[8];
+	for ( int i = 0; i < 8; ++i )
+	{
+		ring[i] = m_regionMap[center + ringOffset[i]];
+	}
 
-	if ( region1 )
+	// group[i] for cardinal neighbor i (0..3 = N, E, S, W): index of the first
+	// cardinal neighbor it is locally connected to
+	int group[4] = { 0, 1, 2, 3 };
+	for ( int i = 0; i < 4; ++i )
 	{
-		bool split = false;
-		if ( region1 == region2 )
+		const int next = ( i + 1 ) % 4;
+		const unsigned int region = ring[i * 2];
+		if ( region && ring[i * 2 + 1] == region && ring[next * 2] == region )
 		{
-			//oposite
-			if ( ( region1 == between13 ) && ( region1 == region3 ) && ( region1 == between23 ) ||
-				 ( region1 == between14 ) && ( region1 == region4 ) && ( region1 == between24 ) )
+			const int from = qMax( group[i], group[next] );
+			const int to   = qMin( group[i], group[next] );
+			for ( auto& g : group )
 			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				split = checkSplitFlood( Position( pos.x - 1, pos.y, pos.z ), Position( pos.x + 1, pos.y, pos.z ), region1 );
-			}
-		}
-		if ( region1 == region3 )
-		{
-			//quick check is the corner tile between them still connected?
-			if ( between13 == region1 )
-			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				split = checkSplitFlood( Position( pos.x - 1, pos.y, pos.z ), Position( pos.x, pos.y - 1, pos.z ), region1 );
-			}
-		}
-		if ( region1 == region4 )
-		{
-			//quick check is the corner tile between them still connected?
-			if ( between23 == region1 )
-			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				split = checkSplitFlood( Position( pos.x - 1, pos.y, pos.z ), Position( pos.x, pos.y + 1, pos.z ), region1 );
+				if ( g == from )
+				{
+					g = to;
+				}
 			}
 		}
-		if ( split )
-		{
-			unsigned int id                                           = static_cast<unsigned int>( m_regions.size() );
-			m_regionMap[index( Position( pos.x - 1, pos.y, pos.z ) )] = id;
-			m_regions.emplace_back( id );
-			//qDebug() << "flood fill 2 : " << Position( pos.x-1, pos.y, pos.z ).toString();
-			floodFill( region1, id, pos.x - 1, pos.y, pos.z );
-			splitRegions( region1, id );
-		}
 	}
-	region2 = m_regionMap[index( pos.x + 1, pos.y, pos.z )];
-	region3 = m_regionMap[index( pos.x, pos.y - 1, pos.z )];
-	region4 = m_regionMap[index( pos.x, pos.y + 1, pos.z )];
-	if ( region2 )
+
+	bool split = false;
+	QSet<unsigned int> checked;
+	for ( int i = 0; i < 4; ++i )
 	{
-		bool split = false;
-		if ( region2 == region3 )
+		const unsigned int region = ring[i * 2];
+		if ( region == 0 || checked.contains( region ) )
 		{
-			//quick check is the corner tile between them still connected?
-			if ( between23 == region2 )
-			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				split = checkSplitFlood( Position( pos.x + 1, pos.y, pos.z ), Position( pos.x, pos.y - 1, pos.z ), region2 );
-			}
+			continue;
 		}
-		if ( region2 == region4 )
+		checked.insert( region );
+
+		std::vector<unsigned int> seeds;
+		QSet<int> seenGroups;
+		for ( int j = i; j < 4; ++j )
 		{
-			//quick check is the corner tile between them still connected?
-			if ( between24 == region2 )
+			if ( ring[j * 2] == region && !seenGroups.contains( group[j] ) )
 			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				split = checkSplitFlood( Position( pos.x + 1, pos.y, pos.z ), Position( pos.x, pos.y + 1, pos.z ), region2 );
+				seenGroups.insert( group[j] );
+				seeds.push_back( center + ringOffset[j * 2] );
 			}
 		}
-		if ( split )
+		if ( seeds.size() > 1 )
 		{
-			unsigned int id                                           = static_cast<unsigned int>( m_regions.size() );
-			m_regionMap[index( Position( pos.x + 1, pos.y, pos.z ) )] = id;
-			Region r( id );
-			m_regions.emplace_back( id );
-			//qDebug() << "flood fill 2 : " << Position( pos.x+1, pos.y, pos.z ).toString();
-			floodFill( region2, id, pos.x + 1, pos.y, pos.z );
-			splitRegions( region2, id );
+			split |= splitFlood( seeds, region );
 		}
 	}
-	region1 = m_regionMap[index( pos.x - 1, pos.y, pos.z )];
-	region2 = m_regionMap[index( pos.x + 1, pos.y, pos.z )];
-	region3 = m_regionMap[index( pos.x, pos.y - 1, pos.z )];
-	region4 = m_regionMap[index( pos.x, pos.y + 1, pos.z )];
-
-	between13 = m_regionMap[index( pos.x - 1, pos.y - 1, pos.z )];
-	between14 = m_regionMap[index( pos.x - 1, pos.y + 1, pos.z )];
-
-	between23 = m_regionMap[index( pos.x + 1, pos.y - 1, pos.z )];
-	between24 = m_regionMap[index( pos.x + 1, pos.y + 1, pos.z )];
-	if ( region3 )
-	{
-		if ( region3 == region4 )
-		{
-			//oposite
-			if ( ( region3 == between13 ) && ( region3 == region1 ) && ( region3 == between14 ) ||
-				 ( region3 == between23 ) && ( region3 == region2 ) && ( region3 == between24 ) )
-			{
-				//still connected
-			}
-			else
-			{
-				//qDebug() << "check split flood";
-				if ( checkSplitFlood( Position( pos.x, pos.y - 1, pos.z ), Position( pos.x, pos.y + 1, pos.z ), region3 ) )
-				{
-					unsigned int id                                           = static_cast<unsigned int>( m_regions.size() );
-					m_regionMap[index( Position( pos.x, pos.y - 1, pos.z ) )] = id;
-					m_regions.emplace_back( id );
-					//qDebug() << "flood fill 2 : " << Position( pos.x, pos.y-1, pos.z ).toString();
-					floodFill( region3, id, pos.x, pos.y - 1, pos.z );
-					splitRegions( region3, id );
-				}
-			}
-		}
-	}
-	return false;
+	return split;
 }
 
-/** @brief Determines whether two positions in the same region are still connected.
+/** @brief Resolves a possible split of a region into several parts.
  *
- *  Performs a scanline flood-fill from @p pos, limited to tiles matching @p regionID.
- *  If @p pos2 is reached, the tiles are still connected and no split occurred.
- *  Uses a visited array to avoid revisiting tiles.
+ *  Runs one breadth-first search per seed, advancing them in lock step one tile
+ *  at a time. Searches that meet are joined. A search (or joined set of searches)
+ *  that runs out of tiles while another one is still active has explored a
+ *  separate part of the region: its tiles get a new region ID right away and the
+ *  vertical connections are redistributed via splitRegions(). The last remaining
+ *  search keeps the old ID and is never explored to completion, so the cost is
+ *  bounded by the size of the parts that are cut off, not by the region size.
  *
- *  @param pos      First position to check connectivity from.
- *  @param pos2     Second position to check connectivity to.
- *  @param regionID The region both positions belong to.
- *  @return True if @p pos2 was NOT reached (a split occurred), false if still connected.
+ *  @param seeds    Tiles of @p regionID adjacent to the removed tile, one per local group.
+ *  @param regionID The region the seeds belong to.
+ *  @return True if the region was split.
  */
-bool RegionMap::checkSplitFlood( const Position& pos, const Position& pos2, unsigned int regionID )
+bool RegionMap::splitFlood( const std::vector<unsigned int>& seeds, unsigned int regionID )
 {
-	QElapsedTimer timer;
-	timer.start();
-	QQueue<Position> floodQueue;
-
-	QVector<bool> visited( m_dimX * m_dimX, false );
-
-	floodQueue.enqueue( pos );
-	//qDebug() << "start flood fill:" << id << startPos.toString();
-	while ( !floodQueue.isEmpty() )
+	struct Search
 	{
-		Position p0 = floodQueue.dequeue();
-		if ( p0 == pos2 )
+		std::vector<unsigned int> tiles; // visited tiles, doubles as BFS queue
+		size_t head = 0;
+		int joinedTo = -1;
+	};
+	std::vector<Search> searches( seeds.size() );
+	std::unordered_map<unsigned int, int> owner;
+
+	auto rootOf = [&searches]( int s ) {
+		while ( searches[s].joinedTo != -1 )
 		{
-			//found target pos, no split happened;
-			//qDebug() << "found target in " +  QString::number( timer.elapsed() ) + " ms, no split";
-			return false;
+			s = searches[s].joinedTo;
 		}
+		return s;
+	};
 
-		//qDebug() << "continue with " << p0.toString();
-		unsigned int currentIndex     = index( p0.x, p0.y, p0.z );
-		visited[p0.x + p0.y * m_dimX] = true;
+	for ( size_t s = 0; s < seeds.size(); ++s )
+	{
+		searches[s].tiles.push_back( seeds[s] );
+		owner.emplace( seeds[s], (int)s );
+	}
 
-		bool prevLineAdded = false;
-		bool nextLineAdded = false;
-		for ( int x = p0.x; x < m_dimX - 1; ++x )
+	const int neighborOffset[4] = { -m_dimX, 1, m_dimX, -1 };
+	const size_t levelSize       = (size_t)m_dimX * m_dimY;
+
+	bool split = false;
+	int active = (int)seeds.size();
+	while ( active > 1 )
+	{
+		for ( size_t s = 0; s < searches.size() && active > 1; ++s )
 		{
-			if ( m_regionMap[currentIndex] == regionID )
+			if ( searches[s].joinedTo != -1 || searches[s].head == std::numeric_limits<size_t>::max() )
 			{
-				if ( m_regionMap[currentIndex - m_dimX] == regionID && !visited[x + ( p0.y - 1 ) * m_dimX] )
-				{
-					if ( !prevLineAdded )
-					{
-						visited[x + ( p0.y - 1 ) * m_dimX] = true;
-						Position pos( x, p0.y - 1, p0.z );
-						floodQueue.enqueue( pos );
-						prevLineAdded = true;
-						//qDebug() << "add to queue: " << pos.toString();
-					}
-				}
-				else
+				continue;
+			}
+
+			// A joined set of searches advances through the queue of any member that still has tiles
+			bool advanced = false;
+			for ( size_t m = 0; m < searches.size() && !advanced; ++m )
+			{
+				Search& member = searches[m];
+				if ( rootOf( (int)m ) != (int)s || member.head >= member.tiles.size() )
 				{
-					prevLineAdded = false;
+					continue;
 				}
-				if ( m_regionMap[currentIndex + m_dimX] == regionID && !visited[x + ( p0.y + 1 ) * m_dimX] )
+				const unsigned int current = member.tiles[member.head++];
+				const unsigned int plane   = current % levelSize;
+				const int x                = plane % m_dimX;
+				const int y                = plane / m_dimX;
+				for ( int n = 0; n < 4; ++n )
 				{
-					if ( !nextLineAdded )
+					const int nx = x + ( n == 1 ) - ( n == 3 );
+					const int ny = y + ( n == 2 ) - ( n == 0 );
+					if ( nx < 1 || ny < 1 || nx >= m_dimX - 1 || ny >= m_dimY - 1 )
 					{
-						visited[x + ( p0.y + 1 ) * m_dimX] = true;
-						Position pos( x, p0.y + 1, p0.z );
-						floodQueue.enqueue( pos );
-						nextLineAdded = true;
-						//qDebug() << "add to queue: " << pos.toString();
+						continue;
+					}
+					const unsigned int next = current + neighborOffset[n];
+					if ( m_regionMap[next] != regionID )
+					{
+						continue;
+					}
+					auto it = owner.find( next );
+					if ( it == owner.end() )
+					{
+						owner.emplace( next, (int)m );
+						member.tiles.push_back( next );
+					}
+					else
+					{
+						// s may have been joined by an earlier neighbor of the same tile
+						const int self  = rootOf( (int)s );
+						const int other = rootOf( it->second );
+						if ( other != self )
+						{
+							// Two searches met, they are in the same part of the region
+							searches[qMax( other, self )].joinedTo = qMin( other, self );
+							--active;
+						}
 					}
 				}
-				else
-				{
-					nextLineAdded = false;
-				}
+				advanced = true;
 			}
-			else
-			{
-				break;
-			}
-
-			++currentIndex;
-		}
 
-		currentIndex  = index( p0.x, p0.y, p0.z );
-		prevLineAdded = false;
-		nextLineAdded = false;
-		for ( int x = p0.x; x > 0; --x )
-		{
-			if ( m_regionMap[currentIndex] == regionID )
+			if ( !advanced && searches[s].joinedTo == -1 )
 			{
-				if ( m_regionMap[currentIndex - m_dimX] == regionID && !visited[x + ( p0.y - 1 ) * m_dimX] )
+				// Exhausted while others are still running: this part is cut off
+				const unsigned int id = newRegion();
+				for ( size_t m = 0; m < searches.size(); ++m )
 				{
-					if ( !prevLineAdded )
+					if ( rootOf( (int)m ) == (int)s )
 					{
-						visited[x + ( p0.y - 1 ) * m_dimX] = true;
-						Position pos( x, p0.y - 1, p0.z );
-						floodQueue.enqueue( pos );
-						prevLineAdded = true;
+						for ( auto tile : searches[m].tiles )
+						{
+							setRegion( tile, id );
+						}
 					}
 				}
-				else
-				{
-					prevLineAdded = false;
-				}
-				if ( m_regionMap[currentIndex + m_dimX] == regionID && !visited[x + ( p0.y + 1 ) * m_dimX] )
-				{
-					if ( !nextLineAdded )
-					{
-						visited[x + ( p0.y + 1 ) * m_dimX] = true;
-						Position pos( x, p0.y + 1, p0.z );
-						floodQueue.enqueue( pos );
-						nextLineAdded = true;
-					}
-				}
-				else
-				{
-					nextLineAdded = false;
-				}
+				splitRegions( regionID, id );
+				searches[s].head = std::numeric_limits<size_t>::max();
+				--active;
+				split = true;
 			}
-			else
-			{
-				break;
-			}
-
-			--currentIndex;
 		}
 	}
-	//qDebug() << "check took " +  QString::number( timer.elapsed() ) + " ms, split happened";
-	return true;
+	return split;
 }
 
-/** @brief Checks reachability between two regions via BFS over the region graph.
- *
- *  Performs a breadth-first search over inter-region connections (both to and from)
- *  starting from @p start's connections. Results are cached in m_cachedConnections
- *  to speed up repeated queries. The pair is normalized (smaller ID first) for
- *  cache consistency.
- *
+/** @brief Checks reachability between two regions.
  *  @param start The starting region ID.
  *  @param goal  The target region ID.
- *  @return True if the two regions are connected, false otherwise.
+ *  @return True if the two regions are in the same connected component.
  */
 bool RegionMap::checkConnectedRegions( unsigned int start, unsigned int goal )
 {
-	if ( start == goal )
+	applyUpdates();
+	return m_componentOf[start] == m_componentOf[goal];
+}
+
+/** @brief Checks reachability between two positions by looking up their regions.
+ *  @param start The starting position.
+ *  @param goal  The target position.
+ *  @return True if the regions containing start and goal are connected.
+ */
+bool RegionMap::checkConnectedRegions( const Position& start, const Position& goal )
+{
+	/*
+	QElapsedTimer et;
+	et.start();
+	bool connected = checkConnectedRegions( regionID( start), regionID( goal ) );
+	qDebug() << "check connected regions took " << et.elapsed() << " ms";
+	return connected;
+	*/
+	return checkConnectedRegions( regionID( start ), regionID( goal ) );
+}
+
+/** @brief Checks reachability from one region to a list of candidate positions.
+ *  @param start The starting region ID.
+ *  @param goals Candidate positions.
+ *  @return One entry per goal, true if the goal is reachable from @p start.
+ */
+std::vector<bool> RegionMap::checkConnectedRegions( unsigned int start, const std::vector<Position>& goals )
+{
+	applyUpdates();
+	const unsigned int component = m_componentOf[start];
+
+	std::vector<bool> out( goals.size() );
+	for ( size_t i = 0; i < goals.size(); ++i )
 	{
-		return true;
+		out[i] = m_componentOf[m_regionMap[index( goals[i] )]] == component;
 	}
-	if ( start > goal )
+	return out;
+}
+
+/** @brief Appends a new, unconnected region with its own component.
+ *  @return ID of the new region.
+ */
+unsigned int RegionMap::newRegion()
+{
+	const unsigned int id = static_cast<unsigned int>( m_regions.size() );
+	m_regions.emplace_back( id );
+
+	m_regionTiles.push_back( 0 );
+
+	const unsigned int component = newComponent();
+	m_componentOf.push_back( component );
+	m_componentMembers[component].push_back( id );
+	return id;
+}
+
+/** @brief Returns an unused component ID, reusing IDs of components that were emptied.
+ *  @return The component ID, its member list is empty.
+ */
+unsigned int RegionMap::newComponent()
+{
+	if ( !m_freeComponents.empty() )
 	{
-		std::swap( start, goal );
+		const unsigned int id = m_freeComponents.back();
+		m_freeComponents.pop_back();
+		return id;
 	}
-	const auto it = m_cachedConnections.find( std::make_pair( start, goal ) );
-	if ( it != m_cachedConnections.end() )
+	m_componentMembers.emplace_back();
+	return static_cast<unsigned int>( m_componentMembers.size() - 1 );
+}
+
+/** @brief Puts two regions into the same component after they got connected.
+ *
+ *  The regions of the smaller component are moved into the larger one, so every region
+ *  changes its component O(log n) times at most over all merges.
+ *
+ *  @param region1 First region ID.
+ *  @param region2 Second region ID.
+ */
+void RegionMap::linkRegions( unsigned int region1, unsigned int region2 )
+{
+	unsigned int keep = m_componentOf[region1];
+	unsigned int drop = m_componentOf[region2];
+	if ( keep == drop )
 	{
-		return it->second;
+		return;
 	}
-	//qDebug() << "check connection between " << start << goal;
-	QQueue<unsigned int> floodQueue;
-	QSet<unsigned int> visited;
-	for ( auto con : region( start ).connectionsTo() )
+	if ( m_componentMembers[keep].size() < m_componentMembers[drop].size() )
 	{
-		floodQueue.enqueue( con );
-		visited.insert( con );
+		std::swap( keep, drop );
 	}
-	for ( auto con : region( start ).connectionsFrom() )
+	auto& members = m_componentMembers[keep];
+	for ( auto region : m_componentMembers[drop] )
 	{
-		floodQueue.enqueue( con );
-		visited.insert( con );
+		m_componentOf[region] = keep;
+		members.push_back( region );
 	}
-	visited.insert( start );
+	m_componentMembers[drop].clear();
+	m_freeComponents.push_back( drop );
+}
 
-	bool found = false;
-	while ( !floodQueue.isEmpty() && !found )
+/** @brief Assigns @p componentID to every unassigned region reachable from @p regionID.
+ *
+ *  Walks the region graph breadth first over connections in both directions. Regions
+ *  that already have a component are not entered.
+ *
+ *  @param regionID    Region to start from, must be unassigned.
+ *  @param componentID Component to assign.
+ */
+void RegionMap::fillComponent( unsigned int regionID, unsigned int componentID )
+{
+	constexpr unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+
+	std::vector<unsigned int> queue( 1, regionID );
+	m_componentOf[regionID] = componentID;
+	for ( size_t head = 0; head < queue.size(); ++head )
 	{
-		unsigned int currentRegionID = floodQueue.dequeue();
-		if ( currentRegionID == goal )
-		{
-			m_cachedConnections.insert( { std::make_pair( start, goal ), true } );
-			return true;
-		}
-		for ( auto con : region( currentRegionID ).connectionsTo() )
+		Region& current = m_regions[queue[head]];
+		for ( const auto& cons : { current.connectionsTo(), current.connectionsFrom() } )
 		{
-			if ( con == goal )
-			{
-				m_cachedConnections.insert( { std::make_pair( start, goal ), true } );
-				return true;
-			}
-			if ( !visited.contains( con ) )
+			for ( auto con : cons )
 			{
-				floodQueue.enqueue( con );
-				visited.insert( con );
+				if ( m_componentOf[con] == unassigned )
+				{
+					m_componentOf[con] = componentID;
+					queue.push_back( con );
+				}
 			}
 		}
-		for ( auto con : region( currentRegionID ).connectionsFrom() )
+	}
+	auto& members = m_componentMembers[componentID];
+	members.insert( members.end(), queue.begin(), queue.end() );
+}
+
+/** @brief Compares the incrementally maintained components with a fresh build.
+ *
+ *  Labels the world from scratch into a second RegionMap and checks that both
+ *  group the walkable tiles into the same components. Region and component IDs
+ *  differ between the two, only the partition is compared. Expensive, meant for
+ *  debug mode.
+ *
+ *  @return True if both maps agree.
+ */
+bool RegionMap::verifyComponents()
+{
+	applyUpdates();
+
+	RegionMap fresh( m_world );
+	fresh.initRegions();
+
+	std::unordered_map<unsigned int, unsigned int> toFresh;
+	std::unordered_map<unsigned int, unsigned int> fromFresh;
+	for ( unsigned int tileID = 0; tileID < m_regionMap.size(); ++tileID )
+	{
+		const unsigned int region      = m_regionMap[tileID];
+		const unsigned int freshRegion = fresh.m_regionMap[tileID];
+		if ( region == 0 && freshRegion == 0 )
+		{
+			continue;
+		}
+		if ( region == 0 || freshRegion == 0 )
 		{
-			if ( con == goal )
-			{
-				m_cachedConnections.insert( { std::make_pair( start, goal ), true } );
-				return true;
-			}
-			if ( !visited.contains( con ) )
-			{
-				floodQueue.enqueue( con );
-				visited.insert( con );
-			}
+			qWarning() << "RegionMap: tile" << tileID << "is in region" << region << "but a fresh build puts it into" << freshRegion;
+			return false;
+		}
+		const unsigned int component      = m_componentOf[region];
+		const unsigned int freshComponent = fresh.m_componentOf[freshRegion];
+		if ( toFresh.emplace( component, freshComponent ).first->second != freshComponent || fromFresh.emplace( freshComponent, component ).first->second != component )
+		{
+			qWarning() << "RegionMap: components of tile" << tileID << "differ from a fresh build";
+			return false;
 		}
 	}
-	m_cachedConnections.insert( { std::make_pair( start, goal ), false } );
-	//qDebug() << "no connection";
-	return false;
+	return true;
 }
 
-/** @brief Checks reachability between two positions by looking up their regions.
- *  @param start The starting position.
- *  @param goal  The target position.
- *  @return True if the regions containing start and goal are connected.
+/** @brief Computes the connected components of all regions from scratch. */
+void RegionMap::rebuildComponents()
+{
+	constexpr unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+
+	m_componentOf.assign( m_regions.size(), unassigned );
+	m_componentMembers.clear();
+	m_freeComponents.clear();
+
+	for ( unsigned int id = 0; id < m_regions.size(); ++id )
+	{
+		if ( m_componentOf[id] == unassigned )
+		{
+			fillComponent( id, newComponent() );
+		}
+	}
+}
+
+/** @brief Splits a component into its connected parts after connections were removed.
+ *
+ *  Only the regions of @p componentID are visited. The part found first keeps the ID,
+ *  every further part gets a new component. Regions without tiles are dropped from the
+ *  component instead of starting a part of their own.
+ *
+ *  @param componentID The component to recompute.
  */
-bool RegionMap::checkConnectedRegions( const Position& start, const Position& goal )
+void RegionMap::recomputeComponent( unsigned int componentID )
 {
-	/*
-	QElapsedTimer et;
-	et.start();
-	bool connected = checkConnectedRegions( regionID( start), regionID( goal ) );
-	qDebug() << "check connected regions took " << et.elapsed() << " ms";
-	return connected;
-	*/
-	return checkConnectedRegions( regionID( start ), regionID( goal ) );
+	constexpr unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+
+	std::vector<unsigned int> members;
+	members.swap( m_componentMembers[componentID] );
+	for ( auto region : members )
+	{
+		m_componentOf[region] = unassigned;
+	}
+
+	bool first = true;
+	for ( auto region : members )
+	{
+		if ( m_componentOf[region] == unassigned && m_regionTiles[region] != 0 )
+		{
+			fillComponent( region, first ? componentID : newComponent() );
+			first = false;
+		}
+	}
 }
 
 
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../base/position.h"
+#include "../base/tilebitset.h"
 
 #include <QSet>
 
@@ -34,10 +35,16 @@ class World;
 /**
  * @brief Maps every walkable tile to a region ID and tracks inter-region connectivity.
  *
- * Initialized via flood-fill over all walkable tiles. Dynamically updated when tiles
+ * Initialized by labelling all Z-levels in parallel. Dynamically updated when tiles
  * change walkability (construction, mining, etc.). Regions merge when adjacent walkable
  * areas connect and split when connections are broken. Provides O(1) region lookup per
- * tile and cached BFS for cross-region reachability checks.
+ * tile. Regions that reach each other over stairs, ramps and scaffolds share a connected
+ * component, which is kept up to date on every merge, split and new connection, so a
+ * reachability check compares two component IDs.
+ *
+ * Tile changes are queued by updatePosition() and applied in one batch, once per tile,
+ * by applyUpdates(). Every query applies the queue first, so readers never see stale
+ * regions.
  */
 class RegionMap
 {
@@ -58,25 +65,39 @@ class RegionMap
 	unsigned int regionID( unsigned int tileID );
 
 	void updatePosition( const Position& pos );
-	void updateConnectedRegions( const Position& pos );
+	void applyUpdates();
 
 	bool checkConnectedRegions( unsigned int start, unsigned int goal );
 	bool checkConnectedRegions( const Position& start, const Position& goal );
+	std::vector<bool> checkConnectedRegions( unsigned int start, const std::vector<Position>& goals );
+
+	bool verifyComponents();
+
+	/** @brief Connected component of a region, two regions reach each other if their components are equal. */
+	unsigned int componentID( unsigned int regionID ) const
+	{
+		return m_componentOf[regionID];
+	}
+	/** @brief Connected component of the region at a position. */
+	unsigned int componentID( const Position& pos )
+	{
+		applyUpdates();
+		return m_componentOf[m_regionMap[index( pos )]];
+	}
 
 private:
 	World* m_world = nullptr;
 
 	std::vector<unsigned int> m_regionMap;
 	std::vector<Region> m_regions;
+	std::vector<unsigned int> m_regionTiles; ///< Region ID → number of tiles labelled with it.
 
-	struct mHash
-	{
-		inline std::size_t operator()( const std::pair<unsigned int, unsigned int>& s ) const noexcept
-		{
-			return std::hash<std::size_t> {}( static_cast<std::size_t>( s.first ) ^ ( static_cast<std::size_t>( s.second ) << 32 ) );
-		}
-	};
-	std::unordered_map<std::pair<unsigned int, unsigned int>, bool, mHash> m_cachedConnections;
+	std::vector<unsigned int> m_componentOf;                   ///< Region ID → connected component ID.
+	std::vector<std::vector<unsigned int>> m_componentMembers; ///< Component ID → region IDs, empty if unused.
+	std::vector<unsigned int> m_freeComponents;                ///< Unused component IDs.
+
+	std::vector<Position> m_pending; ///< Tiles queued by updatePosition(), in the order they were queued.
+	TileBitset m_pendingTiles;       ///< Tiles in m_pending.
 
 	int m_dimX = 0;
 	int m_dimY = 0;
@@ -87,13 +108,25 @@ class RegionMap
 	unsigned int index( int x, int y, int z );
 	unsigned int index( const Position& pos );
 
+	unsigned int labelLevel( int z );
+	bool isPassable( unsigned int tileID );
+
+	void setRegion( unsigned int tileID, unsigned int regionID );
 	void floodFill( unsigned int oldID, unsigned int newID, int x, int y, int z );
 
 	bool checkSplit( const Position& pos );
-	bool checkSplitFlood( const Position& pos, const Position& pos2, unsigned int regionID );
+	bool splitFlood( const std::vector<unsigned int>& seeds, unsigned int regionID );
 
 	void updatePositionClearWalkable( const Position& pos );
 	void updatePositionSetWalkable( const Position& pos );
+	void updateConnectedRegions( const Position& pos );
 
 	std::vector<Position> connectedNeighborsUp( const Position& pos );
+
+	unsigned int newRegion();
+	unsigned int newComponent();
+	void linkRegions( unsigned int region1, unsigned int region2 );
+	void fillComponent( unsigned int regionID, unsigned int componentID );
+	void rebuildComponents();
+	void recomputeComponent( unsigned int componentID );
 };
@@ -0,0 +1,89 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file rng.cpp
+ *  @brief Implementation of the random number service: seeding, hashing and save game state.
+ */
+
+#include "rng.h"
+
+#include <QVariantList>
+
+std::atomic<quint64> RNG::m_state[(int)RngStream::COUNT];
+
+/** @brief Derives the state of every stream from a single master seed.
+ *  @param masterSeed Seed of the session, e.g. the world seed.
+ */
+void RNG::seed( quint64 masterSeed )
+{
+	for ( int i = 0; i < (int)RngStream::COUNT; ++i )
+	{
+		// One mix round per stream so neighbouring seeds give unrelated sequences
+		quint64 z = masterSeed + ( i + 1 ) * gamma;
+		z         = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+		z         = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+		m_state[i].store( z ^ ( z >> 31 ), std::memory_order_relaxed );
+	}
+}
+
+/** @brief Combines the state of all streams into one value for desync checks.
+ *  @return FNV-1a hash over the stream states.
+ */
+quint64 RNG::stateHash()
+{
+	quint64 hash = 14695981039346656037ull;
+	for ( const auto& state : m_state )
+	{
+		hash ^= state.load( std::memory_order_relaxed );
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/** @brief Writes the stream states into the save game map.
+ *
+ *  States are stored as hex strings, JSON numbers cannot hold 64 bit integers.
+ *
+ *  @param out Map receiving the "rng" entry.
+ */
+void RNG::serialize( QVariantMap& out )
+{
+	QVariantList states;
+	for ( const auto& state : m_state )
+	{
+		states.append( QString::number( state.load( std::memory_order_relaxed ), 16 ) );
+	}
+	out.insert( "rng", states );
+}
+
+/** @brief Restores the stream states from a save game map.
+ *  @param in Map containing the "rng" entry written by serialize().
+ *  @return False if the save has no or an incomplete entry, the caller should seed instead.
+ */
+bool RNG::load( const QVariantMap& in )
+{
+	const QVariantList states = in.value( "rng" ).toList();
+	if ( states.size() != (int)RngStream::COUNT )
+	{
+		return false;
+	}
+	for ( int i = 0; i < (int)RngStream::COUNT; ++i )
+	{
+		m_state[i].store( states[i].toString().toULongLong( nullptr, 16 ), std::memory_order_relaxed );
+	}
+	return true;
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file rng.h
+ * @brief Seeded, per-subsystem random number service used by the simulation.
+ */
+
+#pragma once
+
+#include <QVariantMap>
+
+#include <atomic>
+
+/** @brief Independent random streams, one per subsystem.
+ *
+ *  Keeping the streams apart means a change in how often one subsystem draws
+ *  numbers does not shift the sequence seen by all the others.
+ */
+enum class RngStream : unsigned char
+{
+	World,
+	Grass,
+	Water,
+	Plants,
+	Creatures,
+	Gnomes,
+	Combat,
+	Events,
+	Neighbors,
+	Items,
+	Names,
+	Sprites,
+	COUNT
+};
+
+/**
+ * @brief Static-only deterministic random number generator.
+ *
+ * Every stream is a SplitMix64 counter. A draw is a single atomic add followed by
+ * a bit mix, so streams are safe to use from worker threads and their state is a
+ * single integer that goes into the save game. Seeding the service with the same
+ * master seed reproduces the same sequences on every platform, which is what the
+ * replay recorder relies on.
+ */
+class RNG
+{
+public:
+	RNG()  = delete;
+	~RNG() = delete;
+
+	static constexpr int max = 0x7fffffff; ///< Largest value returned by rand().
+
+	static void seed( quint64 masterSeed );
+
+	/** @brief Returns the next 64 bit value of @p stream. */
+	static quint64 next( RngStream stream )
+	{
+		quint64 z = m_state[(int)stream].fetch_add( gamma, std::memory_order_relaxed ) + gamma;
+		z         = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+		z         = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+		return z ^ ( z >> 31 );
+	}
+
+	/** @brief Drop-in replacement for ::rand(), uniform in [0, RNG::max]. */
+	static int rand( RngStream stream )
+	{
+		return (int)( next( stream ) >> 33 );
+	}
+
+	static quint64 stateHash();
+
+	static void serialize( QVariantMap& out );
+	static bool load( const QVariantMap& in );
+
+private:
+	static constexpr quint64 gamma = 0x9E3779B97F4A7C15ull;
+
+	static std::atomic<quint64> m_state[(int)RngStream::COUNT];
+};
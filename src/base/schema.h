@@ -0,0 +1,273 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file schema.h
+ * @brief Compile-time field schemas and the tagged binary records they are saved as.
+ */
+
+#pragma once
+
+#include "../base/position.h"
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Tagged binary records for save games.
+ *
+ * A record is a sequence of fields, each a varint key followed by its value.
+ * The key holds the field tag and the wire type, a varint or a length-prefixed
+ * byte string. Readers skip tags they don't know and leave fields that are
+ * missing at their defaults, so fields can be added in later versions without
+ * breaking older saves. Tags are never reused once a field is dropped.
+ *
+ * A type describes its plain fields with a tuple of Schema::field() entries
+ * pointing at its members. Integers, enums and positions go through the
+ * schema, anything else (lists, optional data) is written with explicit tags.
+ */
+namespace Schema
+{
+enum Wire : quint8
+{
+	Varint = 0,
+	Bytes  = 1
+};
+
+/** @brief Tag, name and member of one schema field. */
+template <class C, class M>
+struct Field
+{
+	quint8 tag;
+	const char* name;
+	M C::*member;
+};
+
+template <class C, class M>
+constexpr Field<C, M> field( quint8 tag, const char* name, M C::*member )
+{
+	return { tag, name, member };
+}
+
+/** @brief Varint value of a schema field. Positions pack their three coordinates. */
+template <class T>
+quint64 toWire( const T& value )
+{
+	if constexpr ( std::is_same_v<T, Position> )
+	{
+		return (quint64)(quint16)value.x | (quint64)(quint16)value.y << 16 | (quint64)(quint16)value.z << 32;
+	}
+	else if constexpr ( std::is_enum_v<T> )
+	{
+		return (quint64)static_cast<std::underlying_type_t<T>>( value );
+	}
+	else
+	{
+		static_assert( std::is_unsigned_v<T>, "schema fields are unsigned integers, enums or positions" );
+		return value;
+	}
+}
+
+template <class T>
+void fromWire( quint64 wire, T& value )
+{
+	if constexpr ( std::is_same_v<T, Position> )
+	{
+		value = Position( (short)( wire & 0xffff ), (short)( ( wire >> 16 ) & 0xffff ), (short)( ( wire >> 32 ) & 0xffff ) );
+	}
+	else if constexpr ( std::is_enum_v<T> )
+	{
+		value = static_cast<T>( wire );
+	}
+	else
+	{
+		value = (T)wire;
+	}
+}
+
+/** @brief Appends records to a byte buffer. */
+class Writer
+{
+public:
+	void varint( quint64 value )
+	{
+		while ( value >= 0x80 )
+		{
+			m_out.append( (char)( value | 0x80 ) );
+			value >>= 7;
+		}
+		m_out.append( (char)value );
+	}
+
+	void uint( quint8 tag, quint64 value )
+	{
+		varint( tag << 1 | Varint );
+		varint( value );
+	}
+
+	void bytes( quint8 tag, const QByteArray& value )
+	{
+		varint( tag << 1 | Bytes );
+		varint( value.size() );
+		m_out.append( value );
+	}
+
+	/** @brief Writes every field of @p schema from @p object. */
+	template <class T, class... F>
+	void fields( const T& object, const std::tuple<F...>& schema )
+	{
+		std::apply( [this, &object]( const auto&... f ) { ( uint( f.tag, toWire( object.*( f.member ) ) ), ... ); }, schema );
+	}
+
+	/** @brief Appends a finished record, prefixed by its length. */
+	void record( const Writer& record )
+	{
+		varint( record.m_out.size() );
+		m_out.append( record.m_out );
+	}
+
+	const QByteArray& data() const
+	{
+		return m_out;
+	}
+	void clear()
+	{
+		m_out.clear();
+	}
+
+private:
+	QByteArray m_out;
+};
+
+/** @brief Reads records from a byte range. Reads past the end set the error flag and return 0. */
+class Reader
+{
+public:
+	Reader( const uchar* data, qsizetype size ) :
+		m_pos( data ),
+		m_end( data + size )
+	{
+	}
+
+	quint64 varint()
+	{
+		quint64 value = 0;
+		for ( int shift = 0; shift < 64; shift += 7 )
+		{
+			if ( m_pos == m_end )
+			{
+				m_ok = false;
+				return 0;
+			}
+			const uchar b = *m_pos++;
+			value |= (quint64)( b & 0x7f ) << shift;
+			if ( !( b & 0x80 ) )
+			{
+				return value;
+			}
+		}
+		m_ok = false;
+		return value;
+	}
+
+	/** @brief Key of the next field, 0 at the end of the data. */
+	quint32 next()
+	{
+		return atEnd() ? 0 : (quint32)varint();
+	}
+
+	static quint8 tag( quint32 key )
+	{
+		return key >> 1;
+	}
+
+	/** @brief Reads a field into @p object if its tag is part of @p schema.
+	 *  @return False if the tag is not in the schema, the field is not consumed then.
+	 */
+	template <class T, class... F>
+	bool field( quint32 key, T& object, const std::tuple<F...>& schema )
+	{
+		if ( ( key & 1 ) != Varint )
+		{
+			return false;
+		}
+		return std::apply( [this, key, &object]( const auto&... f ) {
+			return ( ( tag( key ) == f.tag ? ( fromWire( varint(), object.*( f.member ) ), true ) : false ) || ... );
+		},
+			schema );
+	}
+
+	QByteArray bytes()
+	{
+		const quint64 size = varint();
+		if ( size > (quint64)( m_end - m_pos ) )
+		{
+			m_ok  = false;
+			m_pos = m_end;
+			return QByteArray();
+		}
+		QByteArray out( reinterpret_cast<const char*>( m_pos ), size );
+		m_pos += size;
+		return out;
+	}
+
+	/** @brief Skips the value of a field nobody asked for. */
+	void skip( quint32 key )
+	{
+		if ( ( key & 1 ) == Varint )
+		{
+			varint();
+		}
+		else
+		{
+			const quint64 size = varint();
+			m_pos += qMin( size, (quint64)( m_end - m_pos ) );
+		}
+	}
+
+	/** @brief Reader over the next length-prefixed record, the outer reader moves past it. */
+	Reader record()
+	{
+		const quint64 size = varint();
+		if ( size > (quint64)( m_end - m_pos ) )
+		{
+			m_ok  = false;
+			m_pos = m_end;
+			return Reader( m_end, 0 );
+		}
+		Reader out( m_pos, size );
+		m_pos += size;
+		return out;
+	}
+
+	bool atEnd() const
+	{
+		return m_pos == m_end;
+	}
+	bool ok() const
+	{
+		return m_ok;
+	}
+
+private:
+	const uchar* m_pos;
+	const uchar* m_end;
+	bool m_ok = true;
+};
+} // namespace Schema
@@ -35,6 +35,7 @@
 #include "../game/jobmanager.h"
 #include "../game/mechanismmanager.h"
 #include "../game/plant.h"
+#include "../game/replay.h"
 #include "../game/roommanager.h"
 #include "../game/stockpilemanager.h"
 #include "../game/workshopmanager.h"
@@ -127,6 +128,63 @@ QVariantMap Selection::serialize()
 	return out;
 }
 
+/** @brief Captures the finished selection as a replay command.
+ *
+ *  Unlike serialize() only the tiles that passed validation are kept, and the
+ *  flags onSecondClick() depends on are stored with it.
+ *
+ *  @param shift Whether Shift was held on the second click.
+ *  @param ctrl  Whether Ctrl was held on the second click.
+ *  @return Command map understood by execute().
+ */
+QVariantMap Selection::command( bool shift, bool ctrl )
+{
+	QVariantMap out;
+	out.insert( "Action", m_action );
+	out.insert( "Item", m_item );
+	out.insert( "Mats", m_materials );
+	out.insert( "Rot", m_rotation );
+	out.insert( "Pos", m_firstClick.toString() );
+	out.insert( "Multi", m_isMulti );
+	out.insert( "Debug", m_debug );
+	out.insert( "Shift", shift );
+	out.insert( "Ctrl", ctrl );
+
+	QVariantList spl;
+	for ( const auto& s : m_selection )
+	{
+		if ( s.second )
+		{
+			spl.push_back( s.first.toString() );
+		}
+	}
+	out.insert( "Selection", spl );
+	return out;
+}
+
+/** @brief Re-runs a selection recorded with command() as if the player had clicked it.
+ *
+ *  Used by the replay player, the selection is cleared again afterwards.
+ *
+ *  @param command Command map created by command().
+ */
+void Selection::execute( const QVariantMap& command )
+{
+	setAction( command.value( "Action" ).toString() );
+	m_item       = command.value( "Item" ).toString();
+	m_materials  = command.value( "Mats" ).toStringList();
+	m_rotation   = command.value( "Rot" ).toInt();
+	m_firstClick = Position( command.value( "Pos" ) );
+	m_isMulti    = command.value( "Multi" ).toBool();
+	m_debug      = command.value( "Debug" ).toBool();
+	for ( const auto& pos : command.value( "Selection" ).toList() )
+	{
+		m_selection.push_back( QPair<Position, bool>( Position( pos ), true ) );
+	}
+	onSecondClick( command.value( "Shift" ).toBool(), command.value( "Ctrl" ).toBool() );
+	clear();
+}
+
 /** @brief Resets the selection to its default empty state.
  *
  *  Clears the action, selected tiles, first-click state, item, materials,
@@ -770,6 +828,11 @@ bool Selection::testTileForJobSelection( const Position& pos )
 void Selection::onSecondClick( bool shift, bool ctrl )
 {
 	m_changed = true;
+	if ( Replay::isRecording() )
+	{
+		Replay::record( "Selection", { command( shift, ctrl ) } );
+	}
+
 	if ( m_action == "RemoveDesignation" )
 	{
 		for ( auto p : m_selection )
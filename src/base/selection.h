@@ -100,6 +100,7 @@ class Selection : public QObject
 
 	bool testTileForJobSelection( const Position& pos );
 	void onSecondClick( bool shift, bool ctrl );
+	QVariantMap command( bool shift, bool ctrl );
 
 	bool m_changed = false;
 
@@ -108,6 +109,7 @@ class Selection : public QObject
 	~Selection();
 
 	QVariantMap serialize();
+	void execute( const QVariantMap& command );
 
 	void clear();
 	void rotate();
@@ -0,0 +1,307 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file slab.h
+ * @brief Chunked object pool with generational 32 bit handles, and a sparse ID → handle table.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/** @brief Handle into a Slab: slot index in the low 24 bits, slot generation in the high 8 bits.
+ *
+ *  Generations start at 1, so 0 is never a valid handle.
+ */
+using SlabHandle = quint32;
+
+/**
+ * @brief Pool that keeps objects in fixed-size chunks of contiguous slots.
+ *
+ * Objects never move once created, pointers stay valid until the object is erased.
+ * Erased slots are reused, and every reuse bumps the slot generation so handles to
+ * the old object stop resolving. A slot that reached the last generation is retired
+ * instead of wrapping around, which costs one slot per 254 reuses but keeps stale
+ * handles from ever resolving again. Iteration walks the chunks in memory order and
+ * skips free slots.
+ */
+template <class T>
+class Slab
+{
+	static constexpr quint32 chunkShift = 10;
+	static constexpr quint32 chunkSize  = 1u << chunkShift;
+	static constexpr quint32 indexBits  = 24;
+	static constexpr quint32 indexMask  = ( 1u << indexBits ) - 1;
+
+	struct Slot
+	{
+		union
+		{
+			T value;
+		};
+		quint8 generation = 1;
+		bool alive        = false;
+
+		Slot() {}
+		~Slot()
+		{
+			if ( alive )
+			{
+				value.~T();
+			}
+		}
+	};
+
+public:
+	Slab() = default;
+	Slab( const Slab& ) = delete;
+	Slab& operator=( const Slab& ) = delete;
+
+	/**
+	 * @brief Constructs a new object in a free slot.
+	 * @return Handle of the new object.
+	 */
+	template <class... Args>
+	SlabHandle emplace( Args&&... args )
+	{
+		quint32 index;
+		if ( !m_free.empty() )
+		{
+			index = m_free.back();
+			m_free.pop_back();
+		}
+		else
+		{
+			index = m_used++;
+			Q_ASSERT( index <= indexMask );
+			if ( ( index >> chunkShift ) >= m_chunks.size() )
+			{
+				m_chunks.emplace_back( new Slot[chunkSize] );
+			}
+		}
+		Slot& slot = slotAt( index );
+		new ( &slot.value ) T( std::forward<Args>( args )... );
+		slot.alive = true;
+		++m_size;
+		return ( (quint32)slot.generation << indexBits ) | index;
+	}
+
+	/**
+	 * @brief Destroys the object of a handle. Stale handles are ignored.
+	 * @param handle Handle returned by emplace().
+	 */
+	void erase( SlabHandle handle )
+	{
+		Slot* slot = resolve( handle );
+		if ( slot )
+		{
+			slot->value.~T();
+			slot->alive = false;
+			--m_size;
+			// a wrapped generation would let old handles resolve to a new object, so the slot stays dead
+			if ( slot->generation < 255 )
+			{
+				++slot->generation;
+				m_free.push_back( handle & indexMask );
+			}
+		}
+	}
+
+	/**
+	 * @brief Resolves a handle.
+	 * @param handle Handle returned by emplace().
+	 * @return The object or nullptr if the handle is stale or invalid.
+	 */
+	T* get( SlabHandle handle )
+	{
+		Slot* slot = resolve( handle );
+		return slot ? &slot->value : nullptr;
+	}
+
+	const T* get( SlabHandle handle ) const
+	{
+		return const_cast<Slab*>( this )->get( handle );
+	}
+
+	/** @brief Number of live objects. */
+	int size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	/** @brief Destroys all objects and frees the chunks. Outstanding handles become invalid. */
+	void clear()
+	{
+		m_chunks.clear();
+		m_free.clear();
+		m_used = 0;
+		m_size = 0;
+	}
+
+	/** @brief Forward iterator over live objects in slot order. */
+	template <class S, class V>
+	class Iterator
+	{
+	public:
+		Iterator( S* slab, quint32 index ) :
+			m_slab( slab ),
+			m_index( index )
+		{
+			skipFree();
+		}
+		V& operator*() const
+		{
+			return m_slab->slotAt( m_index ).value;
+		}
+		V* operator->() const
+		{
+			return &m_slab->slotAt( m_index ).value;
+		}
+		Iterator& operator++()
+		{
+			++m_index;
+			skipFree();
+			return *this;
+		}
+		bool operator!=( const Iterator& other ) const
+		{
+			return m_index != other.m_index;
+		}
+
+	private:
+		void skipFree()
+		{
+			while ( m_index < m_slab->m_used && !m_slab->slotAt( m_index ).alive )
+			{
+				++m_index;
+			}
+		}
+		S* m_slab;
+		quint32 m_index;
+	};
+	using iterator       = Iterator<Slab, T>;
+	using const_iterator = Iterator<const Slab, const T>;
+
+	iterator begin()
+	{
+		return iterator( this, 0 );
+	}
+	iterator end()
+	{
+		return iterator( this, m_used );
+	}
+	const_iterator begin() const
+	{
+		return const_iterator( this, 0 );
+	}
+	const_iterator end() const
+	{
+		return const_iterator( this, m_used );
+	}
+
+private:
+	Slot& slotAt( quint32 index ) const
+	{
+		return m_chunks[index >> chunkShift][index & ( chunkSize - 1 )];
+	}
+
+	Slot* resolve( SlabHandle handle ) const
+	{
+		const quint32 index = handle & indexMask;
+		if ( index >= m_used )
+		{
+			return nullptr;
+		}
+		Slot& slot = slotAt( index );
+		if ( !slot.alive || slot.generation != ( handle >> indexBits ) )
+		{
+			return nullptr;
+		}
+		return &slot;
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> m_chunks;
+	std::vector<quint32> m_free;
+	quint32 m_used = 0; ///< Slots handed out so far, free or not.
+	int m_size     = 0;
+};
+
+/**
+ * @brief Sparse table from object IDs to slab handles.
+ *
+ * Object IDs come from one counter shared by all kinds of objects, so the IDs of one
+ * kind are spread over a wide range. The table is split into pages of 4096 entries
+ * that are allocated on first use, a lookup is two array accesses and no hashing.
+ */
+class SlabIndex
+{
+public:
+	static constexpr unsigned int pageShift = 12;
+	static constexpr unsigned int pageSize  = 1u << pageShift;
+
+	/** @brief Handle stored for @p id, 0 if there is none. */
+	SlabHandle get( unsigned int id ) const
+	{
+		const size_t p = id >> pageShift;
+		if ( p >= m_pages.size() || !m_pages[p] )
+		{
+			return 0;
+		}
+		return m_pages[p][id & ( pageSize - 1 )];
+	}
+
+	void set( unsigned int id, SlabHandle handle )
+	{
+		const size_t p = id >> pageShift;
+		if ( p >= m_pages.size() )
+		{
+			m_pages.resize( p + 1 );
+		}
+		if ( !m_pages[p] )
+		{
+			m_pages[p].reset( new SlabHandle[pageSize]() );
+		}
+		m_pages[p][id & ( pageSize - 1 )] = handle;
+	}
+
+	void remove( unsigned int id )
+	{
+		const size_t p = id >> pageShift;
+		if ( p < m_pages.size() && m_pages[p] )
+		{
+			m_pages[p][id & ( pageSize - 1 )] = 0;
+		}
+	}
+
+	void clear()
+	{
+		m_pages.clear();
+	}
+
+private:
+	std::vector<std::unique_ptr<SlabHandle[]>> m_pages;
+};
@@ -0,0 +1,132 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file tilebitset.h
+ * @brief One bit per world tile, stored in lazily allocated fixed-size chunks.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Per-tile flag set indexed by Position::toInt().
+ *
+ * The tile range is split into chunks of 4096 tiles. A chunk is a dense array of
+ * 64 words that is only allocated when the first bit in it is set, so flags that
+ * cover a small part of the map (grass near the surface, for example) do not pay
+ * for the whole world. Tiles outside of the sized range read as unset and are
+ * ignored by set() and reset().
+ */
+class TileBitset
+{
+public:
+	static constexpr unsigned int chunkShift = 12;
+	static constexpr unsigned int chunkTiles = 1u << chunkShift;
+	static constexpr unsigned int chunkWords = chunkTiles / 64;
+
+	/**
+	 * @brief Drops all bits and sizes the set for @p numTiles tiles.
+	 * @param numTiles Number of tiles in the world.
+	 */
+	void resize( size_t numTiles )
+	{
+		m_chunks.clear();
+		m_chunks.resize( ( numTiles + chunkTiles - 1 ) >> chunkShift );
+		m_count = 0;
+	}
+
+	/**
+	 * @brief Tests the bit of a tile.
+	 * @param tileID Flat tile index.
+	 * @return True if the bit is set.
+	 */
+	bool test( unsigned int tileID ) const
+	{
+		const size_t c = tileID >> chunkShift;
+		if ( c >= m_chunks.size() )
+		{
+			return false;
+		}
+		const auto& chunk = m_chunks[c];
+		return chunk && ( chunk[( tileID & ( chunkTiles - 1 ) ) >> 6] >> ( tileID & 63 ) ) & 1;
+	}
+
+	/**
+	 * @brief Sets the bit of a tile.
+	 * @param tileID Flat tile index.
+	 * @return True if the bit was not set before.
+	 */
+	bool set( unsigned int tileID )
+	{
+		const size_t c = tileID >> chunkShift;
+		if ( c >= m_chunks.size() )
+		{
+			return false;
+		}
+		auto& chunk = m_chunks[c];
+		if ( !chunk )
+		{
+			chunk.reset( new quint64[chunkWords]() );
+		}
+		quint64& word   = chunk[( tileID & ( chunkTiles - 1 ) ) >> 6];
+		const quint64 b = 1ull << ( tileID & 63 );
+		if ( word & b )
+		{
+			return false;
+		}
+		word |= b;
+		++m_count;
+		return true;
+	}
+
+	/**
+	 * @brief Clears the bit of a tile. Chunks stay allocated.
+	 * @param tileID Flat tile index.
+	 * @return True if the bit was set before.
+	 */
+	bool reset( unsigned int tileID )
+	{
+		const size_t c = tileID >> chunkShift;
+		if ( c >= m_chunks.size() || !m_chunks[c] )
+		{
+			return false;
+		}
+		quint64& word   = m_chunks[c][( tileID & ( chunkTiles - 1 ) ) >> 6];
+		const quint64 b = 1ull << ( tileID & 63 );
+		if ( !( word & b ) )
+		{
+			return false;
+		}
+		word &= ~b;
+		--m_count;
+		return true;
+	}
+
+	/** @brief Number of set bits. */
+	size_t count() const
+	{
+		return m_count;
+	}
+
+private:
+	std::vector<std::unique_ptr<quint64[]>> m_chunks;
+	size_t m_count = 0;
+};
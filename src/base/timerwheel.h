@@ -0,0 +1,229 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file timerwheel.h
+ * @brief Hierarchical timer wheel keyed by game tick.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Schedules values for a game tick and hands them back once that tick is reached.
+ *
+ * The wheel has four levels of 256 slots. Level 0 holds the entries due within the
+ * current run of 256 ticks, one slot per tick, and every level above covers 256 times
+ * the range of the one below. An entry sits in the lowest level whose range still
+ * contains its tick and is moved down a level each time the wheel turns over into that
+ * range, so advancing one tick only touches the slots that are actually due. Ticks
+ * beyond the top level wait in a separate list.
+ *
+ * Entries due on the same tick come out in the order they were scheduled. Nothing is
+ * saved, owners schedule their wake-ups again after loading a game.
+ */
+template <class T>
+class TimerWheel
+{
+	static constexpr unsigned int slotBits  = 8;
+	static constexpr unsigned int numSlots  = 1u << slotBits;
+	static constexpr unsigned int slotMask  = numSlots - 1;
+	static constexpr unsigned int numLevels = 4;
+
+	struct Entry
+	{
+		quint64 tick;
+		quint64 seq;
+		T value;
+	};
+
+public:
+	/**
+	 * @brief Schedules a value.
+	 * @param tick Game tick the value is due. Ticks that already passed are due on the next advance().
+	 * @param value Value handed to the callback of advance().
+	 */
+	void schedule( quint64 tick, T value )
+	{
+		place( Entry { tick, m_seq++, std::move( value ) } );
+		++m_size;
+	}
+
+	/**
+	 * @brief Moves the wheel to @p now and calls @p fire for every value that is due.
+	 *
+	 * Values scheduled from within @p fire for a tick up to @p now are due on the next call.
+	 *
+	 * @param now Current game tick.
+	 * @param fire Callable taking a T&.
+	 */
+	template <class F>
+	void advance( quint64 now, F&& fire )
+	{
+		std::vector<Entry> due = std::move( m_due );
+		m_due.clear();
+
+		if ( now > m_now + numSlots )
+		{
+			// after loading a game or a long pause, sorting everything again is cheaper than turning the wheel
+			rebuild( now, due );
+		}
+		while ( m_now < now )
+		{
+			step( due );
+		}
+
+		if ( due.empty() )
+		{
+			return;
+		}
+		std::sort( due.begin(), due.end(), []( const Entry& a, const Entry& b ) {
+			return a.tick != b.tick ? a.tick < b.tick : a.seq < b.seq;
+		} );
+		m_size -= (int)due.size();
+		for ( auto& entry : due )
+		{
+			fire( entry.value );
+		}
+	}
+
+	/** @brief Number of scheduled values. */
+	int size() const
+	{
+		return m_size;
+	}
+
+	/** @brief Drops all values and moves the wheel back to tick 0. */
+	void clear()
+	{
+		for ( auto& level : m_slots )
+		{
+			for ( auto& slot : level )
+			{
+				slot.clear();
+			}
+		}
+		m_far.clear();
+		m_due.clear();
+		m_now  = 0;
+		m_size = 0;
+	}
+
+private:
+	void place( Entry&& entry )
+	{
+		if ( entry.tick <= m_now )
+		{
+			m_due.push_back( std::move( entry ) );
+			return;
+		}
+		for ( unsigned int level = 0; level < numLevels; ++level )
+		{
+			const unsigned int shift = slotBits * ( level + 1 );
+			if ( ( entry.tick >> shift ) == ( m_now >> shift ) )
+			{
+				m_slots[level][( entry.tick >> ( slotBits * level ) ) & slotMask].push_back( std::move( entry ) );
+				return;
+			}
+		}
+		m_far.push_back( std::move( entry ) );
+	}
+
+	void step( std::vector<Entry>& due )
+	{
+		++m_now;
+
+		// turning over into a new range of a level moves its entries down, highest level first
+		unsigned int top = 0;
+		while ( top + 1 < numLevels && ( m_now & ( ( 1ull << ( slotBits * ( top + 1 ) ) ) - 1 ) ) == 0 )
+		{
+			++top;
+		}
+		if ( top == numLevels - 1 && ( m_now & ( ( 1ull << ( slotBits * numLevels ) ) - 1 ) ) == 0 )
+		{
+			replace( m_far, due );
+		}
+		for ( unsigned int level = top; level > 0; --level )
+		{
+			replace( m_slots[level][( m_now >> ( slotBits * level ) ) & slotMask], due );
+		}
+
+		auto& slot = m_slots[0][m_now & slotMask];
+		for ( auto& entry : slot )
+		{
+			due.push_back( std::move( entry ) );
+		}
+		slot.clear();
+	}
+
+	void replace( std::vector<Entry>& entries, std::vector<Entry>& due )
+	{
+		std::vector<Entry> moved = std::move( entries );
+		entries.clear();
+		for ( auto& entry : moved )
+		{
+			if ( entry.tick == m_now )
+			{
+				due.push_back( std::move( entry ) );
+			}
+			else
+			{
+				place( std::move( entry ) );
+			}
+		}
+	}
+
+	void rebuild( quint64 now, std::vector<Entry>& due )
+	{
+		std::vector<Entry> all = std::move( m_far );
+		m_far.clear();
+		for ( auto& level : m_slots )
+		{
+			for ( auto& slot : level )
+			{
+				for ( auto& entry : slot )
+				{
+					all.push_back( std::move( entry ) );
+				}
+				slot.clear();
+			}
+		}
+		m_now = now;
+		for ( auto& entry : all )
+		{
+			if ( entry.tick <= now )
+			{
+				due.push_back( std::move( entry ) );
+			}
+			else
+			{
+				place( std::move( entry ) );
+			}
+		}
+	}
+
+	std::vector<Entry> m_slots[numLevels][numSlots];
+	std::vector<Entry> m_far; ///< Entries beyond the range of the top level.
+	std::vector<Entry> m_due; ///< Entries scheduled for a tick that already passed.
+	quint64 m_now = 0;       ///< Last tick the wheel was advanced to.
+	quint64 m_seq = 0;
+	int m_size    = 0;
+};
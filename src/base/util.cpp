@@ -30,6 +30,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/pathfinder.h"
+#include "../base/rng.h"
 #include "../game/game.h"
 #include "../game/inventory.h"
 #include "../game/object.h"
@@ -719,7 +720,7 @@ unsigned int Util::createRawMaterialItem( Position pos, unsigned int materialID
 int Util::ticksPerDayRandomized( int percentage )
 {
 	int maxOffset = qMax( 1, (int)( (float)Util::ticksPerDay / 100. ) * percentage );
-	return Util::ticksPerDay + ( ( rand() % ( maxOffset * 2 ) ) - maxOffset );
+	return Util::ticksPerDay + ( ( RNG::rand( RngStream::Events ) % ( maxOffset * 2 ) ) - maxOffset );
 }
 
 /** @brief Computes the inverse Fibonacci index for an XP value.
@@ -753,10 +754,10 @@ unsigned int Util::reverseFib( unsigned int number )
  */
 Position Util::reachableBorderPos( Position fromPos, bool& found )
 {
-	int randPos = qMax( 2, rand() % ( Global::dimX - 2 ) );
+	int randPos = qMax( 2, RNG::rand( RngStream::Events ) % ( Global::dimX - 2 ) );
 
 	Position pos( randPos, randPos, Global::dimZ - 1 );
-	int border = rand() % 4;
+	int border = RNG::rand( RngStream::Events ) % 4;
 	switch ( border )
 	{
 		case 0: //north
@@ -798,24 +799,24 @@ Position Util::reachableBorderPos( Position fromPos, bool& found )
 Position Util::borderPos( bool& found )
 {
 	Position pos;
-	int border = rand() % 4;
+	int border = RNG::rand( RngStream::Events ) % 4;
 	switch ( border )
 	{
 		case 0: //north
-			pos.x = qMax( 2, rand() % ( Global::dimX - 2 ) );
+			pos.x = qMax( 2, RNG::rand( RngStream::Events ) % ( Global::dimX - 2 ) );
 			pos.y = 1;
 			break;
 		case 1: //east
 			pos.x = Global::dimX - 2;
-			pos.y = qMax( 2, rand() % ( Global::dimY - 2 ) );
+			pos.y = qMax( 2, RNG::rand( RngStream::Events ) % ( Global::dimY - 2 ) );
 			break;
 		case 2: //south
-			pos.x = qMax( 2, rand() % ( Global::dimX - 2 ) );
+			pos.x = qMax( 2, RNG::rand( RngStream::Events ) % ( Global::dimX - 2 ) );
 			pos.y = Global::dimY - 2;
 			break;
 		case 3: // west
 			pos.x = 1;
-			pos.y = qMax( 2, rand() % ( Global::dimY - 2 ) );
+			pos.y = qMax( 2, RNG::rand( RngStream::Events ) % ( Global::dimY - 2 ) );
 			break;
 		default:
 			break;
@@ -932,7 +933,7 @@ QString Util::randomMetal()
 	QStringList metals = { "Copper", "Tin", "Malachite", "Iron", "Lead", "Silver", "Gold", "Platinum" };
 	if ( metals.size() > 0 )
 	{
-		return metals.at( rand() % metals.size() );
+		return metals.at( RNG::rand( RngStream::Items ) % metals.size() );
 	}
 	return "";
 }
@@ -949,7 +950,7 @@ QString Util::randomMetalSliver( QString sourceMaterial )
 {
 	auto row = DB::selectRow( "RandomMetals", sourceMaterial );
 
-	auto ra = rand() % 100;
+	auto ra = RNG::rand( RngStream::Items ) % 100;
 
 	QStringList metals = { "Copper", "Tin", "Malachite", "Iron", "Lead", "Silver", "Gold", "Platinum" };
 	int sum            = 0;
@@ -1006,7 +1007,6 @@ QToolButton* Util::createToolButton( QIcon icon, QString text, QString toolTip )
 QString Util::getRandomString( int length )
 {
 	const QString possibleCharacters( "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" );
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 	QString randomString;
 	for ( int i = 0; i < length; ++i )
 	{
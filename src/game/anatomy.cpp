@@ -23,6 +23,7 @@
 
 #include "../base/db.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../game/creature.h"
 
 #include <QDebug>
@@ -198,11 +199,11 @@ void Anatomy::damage( Equipment* eq, DamageType dt, AnatomyHeight da, AnatomySid
 		{ // hit foot or leg
 			if ( !left && !right )
 			{
-				ra    = rand() % 100;
+				ra    = RNG::rand( RngStream::Combat ) % 100;
 				left  = ( ra > 50 );
 				right = !left;
 			}
-			ra = rand() % 100;
+			ra = RNG::rand( RngStream::Combat ) % 100;
 			if ( left )
 			{
 				if ( ra > 75 )
@@ -216,7 +217,7 @@ void Anatomy::damage( Equipment* eq, DamageType dt, AnatomyHeight da, AnatomySid
 			}
 			else
 			{
-				ra = rand() % 100;
+				ra = RNG::rand( RngStream::Combat ) % 100;
 				if ( ra > 75 )
 				{
 					hitPart = CP_RIGHT_FOOT;
@@ -236,7 +237,7 @@ void Anatomy::damage( Equipment* eq, DamageType dt, AnatomyHeight da, AnatomySid
 			}
 			else
 			{
-				ra = rand() % 100;
+				ra = RNG::rand( RngStream::Combat ) % 100;
 				if ( left )
 				{
 					if ( ra > 50 )
@@ -245,7 +246,7 @@ void Anatomy::damage( Equipment* eq, DamageType dt, AnatomyHeight da, AnatomySid
 					}
 					else
 					{
-						ra = rand() % 100;
+						ra = RNG::rand( RngStream::Combat ) % 100;
 						if ( ra > 75 )
 						{
 							hitPart = CP_LEFT_HAND;
@@ -265,7 +266,7 @@ void Anatomy::damage( Equipment* eq, DamageType dt, AnatomyHeight da, AnatomySid
 						}
 						else
 						{
-							ra = rand() % 100;
+							ra = RNG::rand( RngStream::Combat ) % 100;
 							if ( ra > 75 )
 							{
 								hitPart = CP_RIGHT_HAND;
@@ -445,8 +446,7 @@ void Anatomy::setFluidLevelonTile( unsigned char fluidLevel )
  */
 AnatomyHeight Anatomy::randomAttackHeight() const
 {
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
-	auto ra = rand() % 100;
+	auto ra = RNG::rand( RngStream::Combat ) % 100;
 
 	if ( ra < 50 )
 		return AH_MIDDLE;
@@ -25,6 +25,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/game.h"
 #include "../game/creaturemanager.h"
@@ -65,7 +66,7 @@ Animal::Animal( QString species, Position& pos, Gender gender, bool adult, Game*
 
 	m_isMulti = avm.value( "IsMulti" ).toBool();
 
-	int hungerRand = ( rand() % 20 ) - 10;
+	int hungerRand = ( RNG::rand( RngStream::Creatures ) % 20 ) - 10;
 	m_hunger       = 100 + hungerRand;
 
 	if ( adult )
@@ -468,7 +469,7 @@ CreatureTickResult Animal::onTick( quint64 tickNumber, bool seasonChanged, bool
 		auto status = m_anatomy.status();
 		if ( status & AS_DEAD )
 		{
-			Global::logger().log( LogType::COMBAT, "The " + m_name + " died. Bummer!", m_id );
+			Global::logger().log( LogType::COMBAT, "The %1 died. Bummer!", m_id, { m_name } );
 			die();
 			// TODO check for other statuses
 		}
@@ -746,7 +747,7 @@ BT_RESULT Animal::actionLayEgg( bool halt )
 				}
 				else
 				{
-					g->cm()->addCreature( CreatureType::ANIMAL, def.value( "EggID" ).toString(), m_position, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, false, m_tame );
+					g->cm()->addCreature( CreatureType::ANIMAL, def.value( "EggID" ).toString(), m_position, RNG::rand( RngStream::Creatures ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, false, m_tame );
 					if ( g->cm()->count( m_species ) >= GameState::maxAnimalsPerType )
 					{
 						break;
@@ -891,7 +892,7 @@ BT_RESULT Animal::actionGiveBirth( bool halt )
 		{
 			// create baby
 			setPregnant( false );
-			unsigned int babyID = g->cm()->addCreature( CreatureType::ANIMAL, m_species, m_position, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, false, m_tame );
+			unsigned int babyID = g->cm()->addCreature( CreatureType::ANIMAL, m_species, m_position, RNG::rand( RngStream::Creatures ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, false, m_tame );
 			// if mother on pasture and space on pasture
 			Pasture* pasture = g->fm()->getPasture( m_pastureID );
 			if ( pasture )
@@ -1197,27 +1198,27 @@ BT_RESULT Animal::actionFindRetreat( bool halt )
 	{
 		return BT_RESULT::IDLE;
 	}
-	int randPos = qMax( 2, rand() % ( Global::dimX - 2 ) );
+	int randPos = qMax( 2, RNG::rand( RngStream::Creatures ) % ( Global::dimX - 2 ) );
 
 	Position pos( 0, 0, Global::dimZ - 1 );
-	int border = rand() % 4;
+	int border = RNG::rand( RngStream::Creatures ) % 4;
 	switch ( border )
 	{
 		case 0: //north
-			pos.x = qMax( 2, rand() % ( Global::dimX - 2 ) );
-			pos.y = qMax( 2, rand() % 10 );
+			pos.x = qMax( 2, RNG::rand( RngStream::Creatures ) % ( Global::dimX - 2 ) );
+			pos.y = qMax( 2, RNG::rand( RngStream::Creatures ) % 10 );
 			break;
 		case 1: //east
-			pos.x = Global::dimX - qMax( 2, rand() % 10 );
-			pos.y = qMax( 2, rand() % ( Global::dimX - 2 ) );
+			pos.x = Global::dimX - qMax( 2, RNG::rand( RngStream::Creatures ) % 10 );
+			pos.y = qMax( 2, RNG::rand( RngStream::Creatures ) % ( Global::dimX - 2 ) );
 			break;
 		case 2: //south
-			pos.x = qMax( 2, rand() % ( Global::dimX - 2 ) );
-			pos.y = Global::dimX - qMax( 2, rand() % 10 );
+			pos.x = qMax( 2, RNG::rand( RngStream::Creatures ) % ( Global::dimX - 2 ) );
+			pos.y = Global::dimX - qMax( 2, RNG::rand( RngStream::Creatures ) % 10 );
 			break;
 		case 3: // west
-			pos.x = qMax( 2, rand() % 10 );
-			pos.y = qMax( 2, rand() % ( Global::dimX - 2 ) );
+			pos.x = qMax( 2, RNG::rand( RngStream::Creatures ) % 10 );
+			pos.y = qMax( 2, RNG::rand( RngStream::Creatures ) % ( Global::dimX - 2 ) );
 			break;
 		default:
 			break;
@@ -1288,7 +1289,7 @@ BT_RESULT Animal::actionFindRandomPastureField( bool halt )
 		Pasture* pasture = g->fm()->getPasture( m_pastureID );
 		if ( pasture )
 		{
-			int random = rand() % pasture->countTiles();
+			int random = RNG::rand( RngStream::Creatures ) % pasture->countTiles();
 			setCurrentTarget( pasture->randomFieldPos() );
 			return BT_RESULT::SUCCESS;
 		}
@@ -1340,10 +1341,9 @@ BT_RESULT Animal::actionGetTarget( bool halt )
 
 BT_RESULT Animal::actionGuardDogGetTarget( bool halt )
 {
-	auto foxes = g->cm()->animalsByDistance( m_position, "Fox" );
-	if ( !foxes.empty() )
+	Animal* fox = g->cm()->getClosestAnimal( m_position, "Fox" );
+	if ( fox )
 	{
-		auto fox = foxes.get();
 		if ( m_position.distSquare( fox->getPos() ) < 40 )
 		{
 			//qDebug() << "fox alert";
@@ -1366,19 +1366,19 @@ BT_RESULT Animal::actionAttackTarget( bool halt )
 	{
 		m_facing = getFacing( m_position, creature->getPos() );
 
-		if ( m_globalCooldown <= 0 )
+		if ( m_globalCooldownEnd <= GameState::tick )
 		{
-			if ( m_biteCooldown <= 0 )
+			if ( m_biteCooldownEnd <= GameState::tick )
 			{
-				Global::logger().log( LogType::COMBAT, m_name + " attacks " + creature->name(), m_id );
+				Global::logger().log( LogType::COMBAT, "%1 attacks %2", m_id, { m_name, creature->name() } );
 				// attack with main hand
 
 				int attackSkill  = m_stateMap.value( "Attack" ).toInt();
 				int attackDamage = m_stateMap.value( "Damage" ).toInt();
 
 				creature->attack( DT_PIERCING, AH_LOW, attackSkill, attackDamage, m_position, m_id );
-				m_biteCooldown   = 10;
-				m_globalCooldown = 5;
+				m_biteCooldownEnd   = GameState::tick + 10;
+				m_globalCooldownEnd = GameState::tick + 5;
 			}
 		}
 
@@ -1458,20 +1458,19 @@ bool Animal::attack( DamageType dt, AnatomyHeight da, int skill, int strength, P
 	bool hit = skill >= dodge;
 	if ( dodge > skill )
 	{
-		srand( std::chrono::system_clock::now().time_since_epoch().count() );
 		int diff = dodge - skill;
 		diff     = qMax( 5, 20 - diff );
-		hit |= rand() % 100 > diff;
+		hit |= RNG::rand( RngStream::Combat ) % 100 > diff;
 	}
 
 	if ( hit )
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " took " + QString::number( strength ) + " damage.", m_id );
+		Global::logger().log( LogType::COMBAT, "%1 took %2 damage.", m_id, { m_name, strength } );
 		m_anatomy.damage( &m_equipment, dt, da, ds, strength );
 	}
 	else
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " dogded the attack. Skill:" + QString::number( skill ) + " Dodge: " + QString::number( dodge ), m_id );
+		Global::logger().log( LogType::COMBAT, "%1 dogded the attack. Skill:%2 Dodge: %3", m_id, { m_name, skill, dodge } );
 	}
 
 	bool aeExists = false;
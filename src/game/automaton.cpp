@@ -23,6 +23,8 @@
 
 #include "../base/db.h"
 #include "../base/global.h"
+#include "../base/rng.h"
+#include "../game/gnomemanager.h"
 #include "../game/inventory.h"
 #include "../gfx/spritefactory.h"
 
@@ -91,6 +93,8 @@ Automaton::~Automaton()
 ///        removes biological needs, and replaces them with a Fuel need.
 void Automaton::init()
 {
+	g->w()->insertCreatureAtPosition( m_position, m_id );
+
 	initTaskMap();
 
 	if ( m_core )
@@ -175,8 +179,7 @@ void Automaton::updateSprite()
 			bsa.remove( 0, 1 );
 			auto bsl = bsa.split( "|" );
 
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
-			int rn = rand() % bsl.size();
+			int rn = RNG::rand( RngStream::Gnomes ) % bsl.size();
 			randTemp.insert( pm.value( "Part" ).toString() + "Rand", rn );
 			pm.insert( "BaseSprite", bsl[rn] );
 		}
@@ -220,7 +223,6 @@ void Automaton::updateSprite()
 			bsa.remove( 0, 1 );
 			auto bsl = bsa.split( "|" );
 
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
 			int rn = randTemp.value( pm.value( "Part" ).toString() + "Rand" ).toInt();
 			pm.insert( "BaseSprite", bsl[rn] + "Back" );
 		}
@@ -272,6 +274,7 @@ CreatureTickResult Automaton::onTick( quint64 tickNumber, bool seasonChanged, bo
 	if ( m_fuel <= 0 )
 	{
 		updateSprite();
+		g->gm()->wakeAutomaton( m_id );
 	}
 
 	m_needs.insert( "Fuel", m_fuel );
@@ -355,6 +358,7 @@ void Automaton::installCore( unsigned int itemID )
 			}
 		}
 	}
+	g->gm()->wakeAutomaton( m_id );
 }
 
 /// @brief Returns the UID of the currently installed core item, or 0 if none.
@@ -376,6 +380,7 @@ bool Automaton::getRefuelFlag()
 void Automaton::setRefuelFlag( bool flag )
 {
 	m_refuel = flag;
+	g->gm()->wakeAutomaton( m_id );
 }
 
 /// @brief Sets the desired core type SID.  If the type is cleared while one was set,
@@ -389,6 +394,7 @@ void Automaton::setCoreType( QString coreSID )
 	}
 	m_coreType        = coreSID;
 	m_maintJobChanged = true;
+	g->gm()->wakeAutomaton( m_id );
 }
 
 /// @brief Returns the desired core type SID.
@@ -404,6 +410,7 @@ void Automaton::uninstallCore( bool uninstall )
 {
 	m_uninstallCore   = uninstall;
 	m_maintJobChanged = true;
+	g->gm()->wakeAutomaton( m_id );
 }
 
 /// @brief Returns whether a core uninstall has been requested.
@@ -25,6 +25,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/position.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/game.h"
 #include "../game/automaton.h"
@@ -1164,7 +1165,7 @@ bool CanWork::harvest()
 		offset = Position( m_currentTask.value( "Offset" ).toString() );
 	}
 	Position pos( m_job->pos() + offset );
-	QMap<unsigned int, Plant>& plants = g->w()->plants();
+	PlantStore& plants = g->w()->plants();
 	if ( plants.contains( pos.toInt() ) )
 	{
 		Plant& plant = plants[pos.toInt()];
@@ -1294,9 +1295,8 @@ bool CanWork::craft()
 
 	int qIndex = skillLevel / 20. * qSize;
 
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
-	int qRand = rand() % 100;
+	int qRand = RNG::rand( RngStream::Gnomes ) % 100;
 	if ( qRand < 20 )
 	{
 		qIndex = qMax( 0, qIndex - 1 );
@@ -1314,9 +1314,8 @@ bool CanWork::craft()
 		{
 			if ( resultMaterial == "RandomMetal" )
 			{
-				srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
-				if ( rand() % 100 > 50 )
+				if ( RNG::rand( RngStream::Gnomes ) % 100 > 50 )
 				{
 					if ( claimedItems().size() )
 					{
@@ -1439,7 +1438,7 @@ bool CanWork::fellTree()
 		offset = Position( m_currentTask.value( "Offset" ).toString() );
 	}
 	Position pos( m_job->pos() + offset );
-	QMap<unsigned int, Plant>& plants = g->w()->plants();
+	PlantStore& plants = g->w()->plants();
 	if ( plants.contains( pos.toInt() ) )
 	{
 		Plant& plant = plants[pos.toInt()];
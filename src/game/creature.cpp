@@ -27,6 +27,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/logger.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/creaturemanager.h"
 #include "../game/eventmanager.h"
@@ -38,6 +39,18 @@
 
 #include <QDebug>
 
+/** @brief Ticks left of a cooldown ending at @p endTick, as it is saved. */
+static int cooldownLeft( quint64 endTick )
+{
+	return endTick > GameState::tick ? endTick - GameState::tick : 0;
+}
+
+/** @brief End tick of a cooldown from the ticks left in a save. */
+static quint64 cooldownEnd( const QVariant& left )
+{
+	return GameState::tick + qMax( 0, left.toInt() );
+}
+
 /** @brief Construct a new creature at the given position.
  *  @param pos Starting world position.
  *  @param name Display name of the creature.
@@ -120,12 +133,12 @@ Creature::Creature( QVariantMap in, Game* game ) :
 
 	//combat variables
 	m_lastOnTick( in.value( "LastonTick" ).value<quint64>() ),
-	m_globalCooldown( in.value( "globalCooldown" ).toInt() ),
-	m_kickCooldown( in.value( "kickCooldown" ).toInt() ),
-	m_leftHandCooldown( in.value( "leftHandCooldown" ).toInt() ),
-	m_rightHandCooldown( in.value( "rightHandCooldown" ).toInt() ),
-	m_specialAttackCoolDown( in.value( "specialAttackCoolDown" ).toInt() ),
-	m_jobCooldown( in.value( "jobCoolDown" ).toInt() ),
+	m_globalCooldownEnd( cooldownEnd( in.value( "globalCooldown" ) ) ),
+	m_kickCooldownEnd( cooldownEnd( in.value( "kickCooldown" ) ) ),
+	m_leftHandCooldownEnd( cooldownEnd( in.value( "leftHandCooldown" ) ) ),
+	m_rightHandCooldownEnd( cooldownEnd( in.value( "rightHandCooldown" ) ) ),
+	m_specialAttackCoolDownEnd( cooldownEnd( in.value( "specialAttackCoolDown" ) ) ),
+	m_jobCooldownEnd( cooldownEnd( in.value( "jobCoolDown" ) ) ),
 
 	m_leftHandAttackValue( in.value( "leftHandAttackValue" ).toInt() ),
 	m_leftHandAttackSkill( in.value( "leftHandAttackSkill" ).toInt() ),
@@ -271,12 +284,12 @@ void Creature::serialize( QVariantMap& out ) const
 
 	//combat variables
 	out.insert( "LastOnTick", m_lastOnTick );
-	out.insert( "globalCooldown", m_globalCooldown );
-	out.insert( "kickCooldown", m_kickCooldown );
-	out.insert( "leftHandCooldown", m_leftHandCooldown );
-	out.insert( "rightHandCooldown", m_rightHandCooldown );
-	out.insert( "specialAttackCoolDown", m_specialAttackCoolDown );
-	out.insert( "jobCoolDown", m_jobCooldown );
+	out.insert( "globalCooldown", cooldownLeft( m_globalCooldownEnd ) );
+	out.insert( "kickCooldown", cooldownLeft( m_kickCooldownEnd ) );
+	out.insert( "leftHandCooldown", cooldownLeft( m_leftHandCooldownEnd ) );
+	out.insert( "rightHandCooldown", cooldownLeft( m_rightHandCooldownEnd ) );
+	out.insert( "specialAttackCoolDown", cooldownLeft( m_specialAttackCoolDownEnd ) );
+	out.insert( "jobCoolDown", cooldownLeft( m_jobCooldownEnd ) );
 
 	out.insert( "leftHandAttackValue", m_leftHandAttackValue );
 	out.insert( "leftHandAttackSkill", m_leftHandAttackSkill );
@@ -308,7 +321,10 @@ void Creature::setRole( unsigned int roleID )
 	m_roleID = roleID;
 }
 
-/** @brief Decrement all combat and movement cooldowns based on elapsed ticks.
+/** @brief Decrement the movement cooldown based on elapsed ticks.
+ *
+ *  Combat and job cooldowns store the tick they end and need no update.
+ *
  *  @param tickNumber Current game tick.
  */
 void Creature::processCooldowns( quint64 tickNumber )
@@ -316,14 +332,6 @@ void Creature::processCooldowns( quint64 tickNumber )
 	int diff = tickNumber - m_lastOnTick;
 
 	m_moveCooldown -= diff * m_moveSpeed;
-
-	m_globalCooldown -= diff;
-	m_kickCooldown -= diff;
-	m_biteCooldown -= diff;
-	m_leftHandCooldown -= diff;
-	m_rightHandCooldown -= diff;
-	m_specialAttackCoolDown -= diff;
-	m_jobCooldown -= diff;
 }
 
 /** @brief Load and initialize a behavior tree by ID from the BT_Factory.
@@ -415,6 +423,7 @@ void Creature::forceMove( const Position& to )
 	g->w()->removeCreatureFromPosition( m_position, m_id );
 	m_position = to;
 	g->w()->insertCreatureAtPosition( m_position, m_id );
+	g->cm()->onCreatureMoved( this );
 }
 
 /** @brief Attempt a random one-tile move, respecting cooldowns, walkability, and creature type restrictions. */
@@ -426,7 +435,7 @@ void Creature::randomMove()
 
 	if ( m_moveCooldown <= 0 )
 	{
-		bool move = !( rand() % 25 );
+		bool move = !( RNG::rand( RngStream::Creatures ) % 25 );
 		Position newPos;
 		Position testPos;
 		qint8 newFacing = -1;
@@ -434,7 +443,7 @@ void Creature::randomMove()
 		{
 			if ( m_aquatic )
 			{
-				int dir = rand() % 6;
+				int dir = RNG::rand( RngStream::Creatures ) % 6;
 
 				switch ( dir )
 				{
@@ -511,7 +520,7 @@ void Creature::randomMove()
 				auto neighbors = g->w()->connectedNeighbors( m_position );
 				if ( neighbors.size() > 0 )
 				{
-					int dir   = rand() % neighbors.size();
+					int dir   = RNG::rand( RngStream::Creatures ) % neighbors.size();
 					newPos    = neighbors[dir];
 					if ( !g->w()->isWalkableGnome( newPos ) )
 					{
@@ -817,6 +826,7 @@ void Creature::move( Position oldPos )
 	{
 		g->w()->removeCreatureFromPosition( oldPos, m_id );
 		g->w()->insertCreatureAtPosition( m_position, m_id );
+		g->cm()->onCreatureMoved( this );
 
 		if( m_hasTransparency )
 		{
@@ -382,14 +382,15 @@ class Creature : public Object
 
 	unsigned char m_lightIntensity = 0;
 
-	quint64 m_lastOnTick        = 0;
-	int m_globalCooldown        = 0;
-	int m_kickCooldown          = 0;
-	int m_biteCooldown          = 0;
-	int m_leftHandCooldown      = 0;
-	int m_rightHandCooldown     = 0;
-	int m_specialAttackCoolDown = 0;
-	int m_jobCooldown           = 0;
+	quint64 m_lastOnTick = 0;
+	// ticks the combat and job cooldowns end, saved as the ticks left
+	quint64 m_globalCooldownEnd        = 0;
+	quint64 m_kickCooldownEnd          = 0;
+	quint64 m_biteCooldownEnd          = 0;
+	quint64 m_leftHandCooldownEnd      = 0;
+	quint64 m_rightHandCooldownEnd     = 0;
+	quint64 m_specialAttackCoolDownEnd = 0;
+	quint64 m_jobCooldownEnd           = 0;
 
 	int m_leftHandAttackValue  = 0;
 	int m_leftHandAttackSkill  = 0;
@@ -24,6 +24,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../game/game.h"
 #include "../game/world.h"
 
@@ -54,16 +55,16 @@ Animal* CreatureFactory::createRandomAnimal( QStringList allowedAnimals )
 
 	int numTypes = allowedAnimals.size();
 
-	int randomType = rand() % ( numTypes );
+	int randomType = RNG::rand( RngStream::Creatures ) % ( numTypes );
 	QString type   = allowedAnimals[randomType];
 
-	int x = qMax( 2, ( rand() % dimx ) - 2 );
-	int y = qMax( 2, ( rand() % dimy ) - 2 );
+	int x = qMax( 2, ( RNG::rand( RngStream::Creatures ) % dimx ) - 2 );
+	int y = qMax( 2, ( RNG::rand( RngStream::Creatures ) % dimy ) - 2 );
 
 	Position pos( x, y, dimZ - 2 );
 	g->w()->getFloorLevelBelow( pos, false );
 
-	Animal* animal = new Animal( type, pos, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, g );
+	Animal* animal = new Animal( type, pos, RNG::rand( RngStream::Creatures ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, g );
 
 	animal->init();
 	return animal;
@@ -111,16 +112,16 @@ Monster* CreatureFactory::createRandomMonster( QStringList allowedMonsters )
 
 	int numTypes = allowedMonsters.size();
 
-	int randomType = rand() % ( numTypes );
+	int randomType = RNG::rand( RngStream::Creatures ) % ( numTypes );
 	QString type = allowedMonsters[randomType];
 
-	int x = qMax( 2, ( rand() % dimx ) - 2 );
-	int y = qMax( 2, ( rand() % dimy ) - 2 );
+	int x = qMax( 2, ( RNG::rand( RngStream::Creatures ) % dimx ) - 2 );
+	int y = qMax( 2, ( RNG::rand( RngStream::Creatures ) % dimy ) - 2 );
 
 	Position pos( x, y, dimZ - 2 );
 	m_world->getFloorLevelBelow( pos, false );
 
-	Monster* monster = new Monster( type, 1, pos, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE );
+	Monster* monster = new Monster( type, 1, pos, RNG::rand( RngStream::Creatures ) % 2 == 0 ? Gender::MALE : Gender::FEMALE );
 	
 	monster->init();
 	return monster;
@@ -147,7 +148,7 @@ Monster* CreatureFactory::createMonster( QString type, int level, Position pos,
 	{
 		QString attributeID = row.value( "ID" ).toString();
 
-		monster->addAttribute( attributeID, rand() % 10 + 1 );
+		monster->addAttribute( attributeID, RNG::rand( RngStream::Creatures ) % 10 + 1 );
 	}
 
 	auto skills = DB::selectRows( "Skills" );
@@ -159,7 +160,7 @@ Monster* CreatureFactory::createMonster( QString type, int level, Position pos,
 		auto group = skill.value( "SkillGroup" ).toString();
 		if ( group == "Combat" || group == "Defense" )
 		{
-			monster->addSkill( skillID, rand() % 500 );
+			monster->addSkill( skillID, RNG::rand( RngStream::Creatures ) % 500 );
 			//monster->setSkillActive( skillID, true );
 		}
 	}
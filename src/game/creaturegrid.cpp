@@ -0,0 +1,224 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file creaturegrid.cpp
+ *  Implementation of the CreatureGrid proximity index.
+ */
+#include "creaturegrid.h"
+
+#include "../base/global.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/** @brief Adds a creature to the cell of its position.
+ *  @param id Creature ID.
+ *  @param pos Current position of the creature.
+ */
+void CreatureGrid::insert( unsigned int id, const Position& pos )
+{
+	m_positions.insert( id, pos );
+	m_cells[cellKey( pos )].append( id );
+}
+
+/** @brief Removes a creature from the grid. Unknown IDs are ignored.
+ *  @param id Creature ID.
+ */
+void CreatureGrid::remove( unsigned int id )
+{
+	auto it = m_positions.find( id );
+	if ( it == m_positions.end() )
+	{
+		return;
+	}
+	const quint32 key = cellKey( it.value() );
+	m_positions.erase( it );
+
+	auto& cell = m_cells[key];
+	cell.removeOne( id );
+	if ( cell.isEmpty() )
+	{
+		m_cells.remove( key );
+	}
+}
+
+/** @brief Updates the position of a creature, switching cells if needed. Unknown IDs are ignored.
+ *  @param id Creature ID.
+ *  @param pos New position of the creature.
+ */
+void CreatureGrid::move( unsigned int id, const Position& pos )
+{
+	auto it = m_positions.find( id );
+	if ( it == m_positions.end() )
+	{
+		return;
+	}
+	const quint32 oldKey = cellKey( it.value() );
+	it.value()           = pos;
+
+	const quint32 newKey = cellKey( pos );
+	if ( oldKey != newKey )
+	{
+		auto& cell = m_cells[oldKey];
+		cell.removeOne( id );
+		if ( cell.isEmpty() )
+		{
+			m_cells.remove( oldKey );
+		}
+		m_cells[newKey].append( id );
+	}
+}
+
+/** @brief Finds the closest creatures that pass a filter.
+ *
+ *  Visits rings of cells around @p pos and stops once the next ring can't hold
+ *  anything closer than the current results or every creature was seen. The
+ *  filter is only asked for creatures that would make it into the result, so
+ *  expensive checks like region connectivity run for a handful of candidates.
+ *  Ties are broken by ID to keep replays deterministic.
+ *
+ *  @param pos Reference position.
+ *  @param count Maximum number of results.
+ *  @param accept Filter on creature IDs.
+ *  @return Up to @p count IDs, closest first.
+ */
+QList<unsigned int> CreatureGrid::nearest( const Position& pos, int count, const std::function<bool( unsigned int )>& accept ) const
+{
+	std::vector<std::pair<int, unsigned int>> best;
+	if ( count <= 0 )
+	{
+		return {};
+	}
+
+	const int cx      = pos.x >> cellShift;
+	const int cy      = pos.y >> cellShift;
+	const int maxRing = ( qMax( Global::dimX, Global::dimY ) >> cellShift ) + 1;
+	int seen          = 0;
+
+	for ( int r = 0; r <= maxRing && seen < m_positions.size(); ++r )
+	{
+		if ( r > 0 && (int)best.size() == count )
+		{
+			const int gap = ( r - 1 ) * cellSize;
+			if ( gap * gap > best.back().first )
+			{
+				break;
+			}
+		}
+		for ( int dy = -r; dy <= r; ++dy )
+		{
+			// inner rows of the ring only have their two end cells
+			const int step = ( dy == -r || dy == r ) ? 1 : 2 * r;
+			for ( int dx = -r; dx <= r; dx += qMax( 1, step ) )
+			{
+				const int x = cx + dx;
+				const int y = cy + dy;
+				if ( x < 0 || y < 0 )
+				{
+					continue;
+				}
+				auto cell = m_cells.constFind( cellKey( x, y ) );
+				if ( cell == m_cells.constEnd() )
+				{
+					continue;
+				}
+				for ( auto id : cell.value() )
+				{
+					++seen;
+					const std::pair<int, unsigned int> candidate( pos.distSquare( m_positions.value( id ) ), id );
+					if ( (int)best.size() == count && !( candidate < best.back() ) )
+					{
+						continue;
+					}
+					if ( !accept( id ) )
+					{
+						continue;
+					}
+					best.insert( std::upper_bound( best.begin(), best.end(), candidate ), candidate );
+					if ( (int)best.size() > count )
+					{
+						best.pop_back();
+					}
+				}
+			}
+		}
+	}
+
+	QList<unsigned int> out;
+	for ( const auto& entry : best )
+	{
+		out.append( entry.second );
+	}
+	return out;
+}
+
+/** @brief Finds all creatures closer than a distance.
+ *
+ *  Only visits the cells overlapping the square around @p pos that holds the
+ *  circle. Ties are broken by ID to keep replays deterministic.
+ *
+ *  @param pos Reference position.
+ *  @param distSquare Squared distance the creatures have to be closer than.
+ *  @return IDs of the creatures with a squared distance below @p distSquare, closest first.
+ */
+QList<unsigned int> CreatureGrid::within( const Position& pos, int distSquare ) const
+{
+	std::vector<std::pair<int, unsigned int>> found;
+	if ( distSquare <= 0 )
+	{
+		return {};
+	}
+
+	int radius = 0;
+	while ( radius * radius < distSquare )
+	{
+		++radius;
+	}
+	const int x0 = qMax( 0, pos.x - radius ) >> cellShift;
+	const int y0 = qMax( 0, pos.y - radius ) >> cellShift;
+	const int x1 = ( pos.x + radius ) >> cellShift;
+	const int y1 = ( pos.y + radius ) >> cellShift;
+
+	for ( int y = y0; y <= y1; ++y )
+	{
+		for ( int x = x0; x <= x1; ++x )
+		{
+			auto cell = m_cells.constFind( cellKey( x, y ) );
+			if ( cell == m_cells.constEnd() )
+			{
+				continue;
+			}
+			for ( auto id : cell.value() )
+			{
+				const int dist = pos.distSquare( m_positions.value( id ) );
+				if ( dist < distSquare )
+				{
+					found.emplace_back( dist, id );
+				}
+			}
+		}
+	}
+	std::sort( found.begin(), found.end() );
+
+	QList<unsigned int> out;
+	for ( const auto& entry : found )
+	{
+		out.append( entry.second );
+	}
+	return out;
+}
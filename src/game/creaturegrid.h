@@ -0,0 +1,67 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file creaturegrid.h
+ *  Uniform grid over the map columns for proximity queries on creatures.
+ */
+#pragma once
+
+#include "../base/position.h"
+
+#include <QHash>
+#include <QList>
+
+#include <functional>
+
+/**
+ * @brief Buckets creature IDs by the 16x16 tile column they stand in.
+ *
+ * Columns span all z-levels, distances still include z. The CreatureManager
+ * keeps one grid per species and moves creatures between cells whenever
+ * Creature::move() or Creature::forceMove() changes their position.
+ */
+class CreatureGrid
+{
+public:
+	static constexpr int cellShift = 4;
+	static constexpr int cellSize  = 1 << cellShift;
+
+	void insert( unsigned int id, const Position& pos );
+	void remove( unsigned int id );
+	void move( unsigned int id, const Position& pos );
+
+	bool isEmpty() const
+	{
+		return m_positions.isEmpty();
+	}
+
+	QList<unsigned int> nearest( const Position& pos, int count, const std::function<bool( unsigned int )>& accept ) const;
+	QList<unsigned int> within( const Position& pos, int distSquare ) const;
+
+private:
+	static quint32 cellKey( int cx, int cy )
+	{
+		return (quint32)cx | (quint32)cy << 16;
+	}
+	static quint32 cellKey( const Position& pos )
+	{
+		return cellKey( pos.x >> cellShift, pos.y >> cellShift );
+	}
+
+	QHash<quint32, QList<unsigned int>> m_cells;
+	QHash<unsigned int, Position> m_positions;
+};
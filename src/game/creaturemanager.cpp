@@ -119,17 +119,26 @@ void CreatureManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayCh
 }
 
 /** @brief Returns all creatures located at the given position.
+ *
+ *  Uses the world's per-tile creature list, gnomes on the tile are skipped.
+ *
  *  @param pos The world position to query.
  *  @return List of creature pointers at that position.
  */
 QList<Creature*> CreatureManager::creaturesAtPosition( Position& pos )
 {
 	QList<Creature*> out;
-	for ( int i = 0; i < m_creatures.size(); ++i )
+	const auto& positions = g->m_world->creaturePositions();
+	auto it               = positions.constFind( pos.toInt() );
+	if ( it != positions.constEnd() )
 	{
-		if ( m_creatures[i]->getPos() == pos )
+		for ( auto id : it.value() )
 		{
-			out.push_back( m_creatures[i] );
+			Creature* c = m_creaturesByID.value( id );
+			if ( c && c->getPos() == pos )
+			{
+				out.push_back( c );
+			}
 		}
 	}
 	return out;
@@ -142,11 +151,9 @@ QList<Creature*> CreatureManager::creaturesAtPosition( Position& pos )
 QList<Animal*> CreatureManager::animalsAtPosition( Position& pos )
 {
 	QList<Animal*> out;
-	for ( int i = 0; i < m_creatures.size(); ++i )
+	for ( auto c : creaturesAtPosition( pos ) )
 	{
-		auto c = m_creatures[i];
-
-		if ( c->isAnimal() && c->getPos() == pos )
+		if ( c->isAnimal() )
 		{
 			out.push_back( dynamic_cast<Animal*>( c ) );
 		}
@@ -161,11 +168,9 @@ QList<Animal*> CreatureManager::animalsAtPosition( Position& pos )
 QList<Monster*> CreatureManager::monstersAtPosition( Position& pos )
 {
 	QList<Monster*> out;
-	for ( int i = 0; i < m_creatures.size(); ++i )
+	for ( auto c : creaturesAtPosition( pos ) )
 	{
-		auto c = m_creatures[i];
-
-		if ( c->isMonster() && c->getPos() == pos )
+		if ( c->isMonster() )
 		{
 			out.push_back( dynamic_cast<Monster*>( c ) );
 		}
@@ -218,6 +223,7 @@ unsigned int CreatureManager::addCreature( CreatureType ct, QString type, Positi
 
 		auto& list = m_creaturesPerType[type];
 		list.append( id );
+		m_grids[type].insert( id, creature->getPos() );
 
 		m_dirty = true;
 
@@ -262,6 +268,7 @@ unsigned int CreatureManager::addCreature( CreatureType ct, QVariantMap vals )
 
 		auto& list = m_creaturesPerType[type];
 		list.append( id );
+		m_grids[type].insert( id, creature->getPos() );
 
 		m_dirty = true;
 
@@ -371,6 +378,7 @@ void CreatureManager::removeCreature( unsigned int id )
 
 		auto& perTypeList = m_creaturesPerType[creature->species()];
 		perTypeList.removeAll( id );
+		m_grids[creature->species()].remove( id );
 
 		m_creaturesByID.remove( id );
 		m_creatures.removeAll( creature );
@@ -387,47 +395,36 @@ void CreatureManager::removeCreature( unsigned int id )
 	}
 }
 
-/** @brief Finds the closest reachable animal of a given type to a position.
+/** @brief Finds the closest reachable, available animal of a given type to a position.
  *  @param pos Reference position to measure distance from.
  *  @param type Species/type ID to search for.
+ *  @param filter Optional additional condition the animal has to meet.
  *  @return Pointer to the closest Animal, or nullptr if none found.
  */
-Animal* CreatureManager::getClosestAnimal( Position pos, QString type )
+Animal* CreatureManager::getClosestAnimal( Position pos, QString type, const std::function<bool( Animal* )>& filter )
 {
-	auto distanceQueue = animalsByDistance( pos, type );
-
-	if ( !distanceQueue.empty() )
+	auto grid = m_grids.constFind( type );
+	if ( grid == m_grids.constEnd() )
 	{
-		return distanceQueue.get();
+		return nullptr;
 	}
-	return nullptr;
+	auto closest = grid->nearest( pos, 1, [this, &pos, &filter]( unsigned int id ) {
+		Animal* a = animal( id );
+		return a && !a->inJob() && !a->isDead() && !a->toDestroy() && g->m_pf->checkConnectedRegions( pos, a->getPos() ) && ( !filter || filter( a ) );
+	} );
+	return closest.isEmpty() ? nullptr : animal( closest.first() );
 }
 
-/** @brief Returns a priority queue of reachable, available animals of a type sorted by distance.
- *  @param pos Reference position to measure distance from.
- *  @param type Species/type ID to filter by.
- *  @return Priority queue of animals ordered by squared distance (closest first).
+/** @brief Keeps the proximity index in step with a creature's position. Gnomes are ignored.
+ *  @param creature The creature that moved.
  */
-PriorityQueue<Animal*, int> CreatureManager::animalsByDistance( Position pos, QString type )
+void CreatureManager::onCreatureMoved( Creature* creature )
 {
-	auto distanceQueue = PriorityQueue<Animal*, int>();
-	for ( auto id : m_creaturesPerType[type] )
+	auto grid = m_grids.find( creature->species() );
+	if ( grid != m_grids.end() )
 	{
-		Creature* creature = m_creaturesByID[id];
-		if( creature->isAnimal() )
-		{
-			Animal* a = dynamic_cast<Animal*>( creature );
-			if ( a && !a->inJob() && !a->isDead() && !a->toDestroy() )
-			{
-				Position targetPos = a->getPos();
-				if ( g->m_pf->checkConnectedRegions( pos, targetPos ) )
-				{
-					distanceQueue.put( a, pos.distSquare( targetPos ) );
-				}
-			}
-		}
+		grid->move( creature->id(), creature->getPos() );
 	}
-	return distanceQueue;
 }
 
 /** @brief Returns the list of creature IDs for a given species type.
@@ -439,21 +436,36 @@ QList<unsigned int> CreatureManager::animalsByType( QString type )
 	return m_creaturesPerType.value( type );
 }
 
+/** @brief Returns the creatures of a species near a position, using the proximity index.
+ *  @param pos Reference position.
+ *  @param type Species/type ID to query.
+ *  @param distSquare Squared distance the creatures have to be closer than.
+ *  @return List of creature IDs, closest first.
+ */
+QList<unsigned int> CreatureManager::animalsInRange( const Position& pos, QString type, int distSquare )
+{
+	auto grid = m_grids.constFind( type );
+	if ( grid == m_grids.constEnd() )
+	{
+		return {};
+	}
+	return grid->within( pos, distSquare );
+}
+
 /** @brief Forces all creatures at a given position to move to a new position.
  *  @param from The source position.
  *  @param to The destination position.
  */
 void CreatureManager::forceMoveAnimals( const Position& from, const Position& to )
 {
-	for ( auto& a : m_creatures )
+	// copy, forceMove() changes the tile lists
+	const QList<unsigned int> ids = g->m_world->creaturePositions().value( from.toInt() );
+	for ( auto id : ids )
 	{
-		// check gnome position
-		if ( a->getPos().toInt() == from.toInt() )
+		Creature* a = m_creaturesByID.value( id );
+		if ( a && a->getPos().toInt() == from.toInt() )
 		{
-			//qDebug() << "force move gnome from " << from.toString() << " to " << to.toString();
-			// move gnome
 			a->forceMove( to );
-			// abort job if he has one
 		}
 	}
 }
@@ -21,8 +21,11 @@
 #pragma once
 
 #include "../game/animal.h"
+#include "../game/creaturegrid.h"
 #include "../game/monster.h"
 
+#include <functional>
+
 class Game;
 
 /** @brief Manages all non-gnome creatures (animals, monsters). Handles tick updates, spawning, lookup, and removal. */
@@ -55,7 +58,7 @@ class CreatureManager : public QObject
 
 	int count();
 
-	Animal* getClosestAnimal( Position pos, QString type );
+	Animal* getClosestAnimal( Position pos, QString type, const std::function<bool( Animal* )>& filter = nullptr );
 
 	QList<Creature*>& creatures()
 	{
@@ -64,13 +67,14 @@ class CreatureManager : public QObject
 
 	QList<Animal*>& animals();
 	QList<Monster*>& monsters();
-	
-	PriorityQueue<Animal*, int> animalsByDistance( Position pos, QString type );
-	
+
+	void onCreatureMoved( Creature* creature );
+
 	void forceMoveAnimals( const Position& from, const Position& to );
 
 	QList<QString> types();
 	QList<unsigned int> animalsByType( QString type );
+	QList<unsigned int> animalsInRange( const Position& pos, QString type, int distSquare );
 
 	bool hasPathTo( const Position& pos, unsigned int creatureID );
 	bool hasLineOfSightTo( const Position& pos, unsigned int creatureID );
@@ -85,6 +89,7 @@ class CreatureManager : public QObject
 
 	QMap<QString, unsigned int> m_countPerType;
 	QMap<QString, QList<unsigned int>> m_creaturesPerType;
+	QHash<QString, CreatureGrid> m_grids; ///< Proximity index per species.
 
 	int m_startIndex = 0;
 
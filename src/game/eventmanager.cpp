@@ -26,6 +26,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/pathfinder.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/gnome.h"
 #include "../game/creaturemanager.h"
@@ -161,7 +162,7 @@ void EventManager::deserialize( QVariantMap in )
 	{
 		Event event;
 		event.deserialize( ve.toMap() );
-		m_eventList.append( event );
+		addEvent( event );
 	}
 
 	auto vml = in.value( "Missions" ).toList();
@@ -172,7 +173,7 @@ void EventManager::deserialize( QVariantMap in )
 	}
 }
 
-/** @brief Per-tick update: schedules migration events on season change, checks and fires pending events.
+/** @brief Per-tick update: sends mission updates and schedules migration events on season change.
  *  @param tickNumber Current game tick.
  *  @param seasonChanged True if the season just changed.
  *  @param dayChanged True if the day just changed.
@@ -192,32 +193,54 @@ void EventManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChang
 	if ( seasonChanged )
 	{
 		auto ev = createEvent( "EventMigration" );
-		srand( std::chrono::system_clock::now().time_since_epoch().count() );
 		ev.tick = GameState::tick + Global::util->ticksPerDayRandomized( 50 );
-		m_eventList.append( ev );
+		addEvent( ev );
 	}
+}
+
+/** @brief Adds an event to the pending list and wakes up the manager at the event's tick.
+ *  @param event The event to add.
+ */
+void EventManager::addEvent( const Event& event )
+{
+	m_eventList.append( event );
+	const unsigned int id = event.id;
+	g->schedule( event.tick, [this, id]() { onEventDue( id ); } );
+}
 
-	for ( auto it = m_eventList.begin(); it != m_eventList.end(); )
+/** @brief Fires a pending event once its tick has come and its requirements are met.
+ *
+ *  Events with unmet requirements are checked again on the next tick. Events that were
+ *  answered or dropped in the meantime are ignored.
+ *
+ *  @param id The event ID.
+ */
+void EventManager::onEventDue( unsigned int id )
+{
+	for ( int i = 0; i < m_eventList.size(); ++i )
 	{
-		auto& event = *it;
-		if ( GameState::tick >= event.tick && checkRequirements( event ) )
+		if ( m_eventList[i].id != id )
 		{
-			auto em     = event.data.toMap();
-			QString msg = em.value( "OnSuccess" ).toMap().value( "Message" ).toString();
-			if ( !msg.isEmpty() )
-			{
-				int amount = em.value( "Amount" ).toInt();
-				msg.replace( "$Num", QString::number( amount ) );
-				QString title = em.value( "OnSuccess" ).toMap().value( "Title" ).toString();
-				Global::eventConnector->onEvent( 0, title, msg, true, false );
-			}
-			executeEvent( event );
-			it = m_eventList.erase( it );
+			continue;
 		}
-		else
+		if ( !checkRequirements( m_eventList[i] ) )
 		{
-			++it;
+			g->schedule( GameState::tick + 1, [this, id]() { onEventDue( id ); } );
+			return;
 		}
+		Event event = m_eventList.takeAt( i );
+
+		auto em     = event.data.toMap();
+		QString msg = em.value( "OnSuccess" ).toMap().value( "Message" ).toString();
+		if ( !msg.isEmpty() )
+		{
+			int amount = em.value( "Amount" ).toInt();
+			msg.replace( "$Num", QString::number( amount ) );
+			QString title = em.value( "OnSuccess" ).toMap().value( "Title" ).toString();
+			Global::eventConnector->onEvent( 0, title, msg, true, false );
+		}
+		executeEvent( event );
+		return;
 	}
 }
 
@@ -247,8 +270,7 @@ Event EventManager::createEvent( QString eventID )
 	int num = min;
 	if ( min != max )
 	{
-		srand( std::chrono::system_clock::now().time_since_epoch().count() );
-		num = qMax( min, rand() % max + 1 );
+		num = qMax( min, RNG::rand( RngStream::Events ) % max + 1 );
 	}
 	em.insert( "Amount", num );
 
@@ -428,7 +450,7 @@ void EventManager::spawnTrader( Position location, unsigned int marketStall, QVa
 			auto types = DB::ids( "Traders" );
 			if ( types.size() )
 			{
-				type = types[rand() % types.size()];
+				type = types[RNG::rand( RngStream::Events ) % types.size()];
 			}
 		}
 		break;
@@ -564,7 +586,7 @@ void EventManager::onDebugEvent( EventType type, QVariantMap args )
 	}
 	em.insert( "Species", args.value( "Type" ).toString() );
 	e.data        = em;
-	m_eventList.append( e );
+	addEvent( e );
 }
 
 /** @brief Returns a reference to the list of active missions, updating elapsed time for each.
@@ -638,7 +660,7 @@ void EventManager::addTraderEvent( NeighborKingdom kingdom )
 
 	e.data = data;
 
-	m_eventList.append( e );
+	addEvent( e );
 }
 
 /** @brief Schedules a raid/invasion event from a neighbor kingdom. Skipped if peaceful mode.
@@ -665,7 +687,7 @@ void EventManager::addRaidEvent( NeighborKingdom kingdom )
 	data.insert( "Species", "Goblin" );
 	e.data = data;
 
-	m_eventList.append( e );
+	addEvent( e );
 }
 
 /** @brief Starts a new mission (spy, raid, emissary, etc.) targeting a neighbor kingdom.
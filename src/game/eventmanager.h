@@ -173,6 +173,9 @@ class EventManager : public QObject
 
 	Event createEvent( QString eventID );
 
+	void addEvent( const Event& event );
+	void onEventDue( unsigned int id );
+
 	bool checkRequirements( Event& event );
 
 	void executeEvent( Event& event );
@@ -26,6 +26,7 @@
 #include "../base/global.h"
 #include "../base/io.h"
 #include "../base/pathfinder.h"
+#include "../base/profiler.h"
 #include "../base/util.h"
 #include "../game/animal.h"
 
@@ -50,6 +51,7 @@
 #include "../game/itemhistory.h"
 #include "../game/object.h"
 #include "../game/plant.h"
+#include "../game/replay.h"
 #include "../game/techtree.h"
 #include "../game/world.h"
 #include "../game/worldgenerator.h"
@@ -74,6 +76,7 @@ Game::Game( QObject* parent ) :
 	qDebug() << "init game...";
 	
 	m_upsTimer.start();
+	Profiler::reset();
 
 	m_sf.reset( new SpriteFactory() );
 	
@@ -220,47 +223,7 @@ void Game::loop()
 		
 		if ( !m_paused )
 		{
-			
-			
-			emit sendOverlayMessage( 6, "tick " + QString::number( GameState::tick ) );
-			//printf("   game tick %d\n",GameState::tick );
-			
-			sendClock();
-
-			// process grass
-			m_world->processGrass();
-			// process plants
-			processPlants();
-
-			// process animals
-
-			m_creatureManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-
-			// process gnomes
-			QElapsedTimer timer2;
-			timer2.start();
-			m_gnomeManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-			ms2 = timer2.elapsed();
-			// process jobs
-			m_jobManager->onTick();
-			// process stockpiles
-			m_spm->onTick( GameState::tick );
-			m_farmingManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-			m_workshopManager->onTick( GameState::tick );
-			m_roomManager->onTick( GameState::tick );
-			m_inv->itemHistory()->onTick( GameState::dayChanged );
-			m_eventManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-			m_mechanismManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-			m_fluidManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-			m_neighborManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
-
-			m_soundManager->onTick( GameState::tick );
-			
-			m_world->processWater();
-
-			m_pf->findPaths();
-
-			++GameState::tick;
+			ms2 = simulateTick();
 		}
 
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -269,15 +232,18 @@ void Game::loop()
 		//
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	
-		auto updates = m_world->updatedTiles();
-		if ( !updates.empty() )
 		{
-			signalUpdateTileInfo( std::move( updates ) );
+			ProfileScope ps( ProfileSection::Aggregators );
+			auto updates = m_world->updatedTiles();
+			if ( !updates.empty() )
+			{
+				signalUpdateTileInfo( std::move( updates ) );
+			}
+			emit signalUpdateStockpile();
+
+			Global::eventConnector->aggregatorCreatureInfo()->update();
 		}
-		emit signalUpdateStockpile();
-	
-		Global::eventConnector->aggregatorCreatureInfo()->update();
+		Profiler::endTick();
 	
 		int ms        = timer.elapsed();
 		m_maxLoopTime = qMax( ms2, m_maxLoopTime );
@@ -306,6 +272,125 @@ void Game::loop()
 	
 }
 
+/**
+ * @brief Advances the simulation by one tick: clock, world and all managers.
+ * @return Time in milliseconds spent in the gnome manager.
+ */
+int Game::simulateTick()
+{
+	int ms2 = 0;
+	Profiler::beginTick( GameState::tick );
+	Replay::beforeTick();
+	
+	emit sendOverlayMessage( 6, "tick " + QString::number( GameState::tick ) );
+	//printf("   game tick %d\n",GameState::tick );
+	
+	sendClock();
+
+	// process grass
+	{
+		ProfileScope ps( ProfileSection::Grass );
+		m_world->processGrass();
+	}
+	// process plants
+	{
+		ProfileScope ps( ProfileSection::Plants );
+		m_world->processPlants();
+	}
+
+	// process animals
+	{
+		ProfileScope ps( ProfileSection::Creatures );
+		m_creatureManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+	}
+
+	// process gnomes
+	{
+		ProfileScope ps( ProfileSection::Gnomes );
+		QElapsedTimer timer2;
+		timer2.start();
+		m_gnomeManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+		ms2 = timer2.elapsed();
+	}
+	// process jobs
+	{
+		ProfileScope ps( ProfileSection::Jobs );
+		m_jobManager->onTick();
+	}
+	// process stockpiles
+	{
+		ProfileScope ps( ProfileSection::Stockpiles );
+		m_spm->onTick( GameState::tick );
+	}
+	{
+		ProfileScope ps( ProfileSection::Farming );
+		m_farmingManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+	}
+	{
+		ProfileScope ps( ProfileSection::Workshops );
+		m_workshopManager->onTick( GameState::tick );
+	}
+	{
+		ProfileScope ps( ProfileSection::Rooms );
+		m_roomManager->onTick( GameState::tick );
+	}
+	{
+		ProfileScope ps( ProfileSection::ItemHistory );
+		m_inv->itemHistory()->onTick( GameState::dayChanged );
+	}
+	{
+		ProfileScope ps( ProfileSection::Timers );
+		m_timers.advance( GameState::tick, []( std::function<void()>& callback ) { callback(); } );
+	}
+	{
+		ProfileScope ps( ProfileSection::Events );
+		m_eventManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+	}
+	{
+		ProfileScope ps( ProfileSection::Mechanisms );
+		m_mechanismManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+	}
+	{
+		ProfileScope ps( ProfileSection::Fluids );
+		m_fluidManager->onTick( GameState::tick, GameState::seasonChanged, GameState::dayChanged, GameState::hourChanged, GameState::minuteChanged );
+	}
+	{
+		ProfileScope ps( ProfileSection::Sound );
+		m_soundManager->onTick( GameState::tick );
+	}
+	{
+		ProfileScope ps( ProfileSection::Water );
+		m_world->processWater();
+	}
+	{
+		ProfileScope ps( ProfileSection::TileUpdates );
+		m_world->applyTileUpdates();
+	}
+	{
+		ProfileScope ps( ProfileSection::PathFinder );
+		m_pf->findPaths();
+	}
+
+	++GameState::tick;
+	Replay::afterTick( this );
+
+	return ms2;
+}
+
+/**
+ * @brief Runs a callback at game tick @p tick, right before the event manager ticks.
+ *
+ * Callbacks are not saved, subsystems schedule their wake-ups again when they
+ * deserialize. A callback has to check itself whether its target still exists.
+ *
+ * @param tick Game tick to run at. Ticks that already passed run on the next tick.
+ * @param callback Function to run.
+ */
+void Game::schedule( quint64 tick, std::function<void()> callback )
+{
+	m_timers.schedule( tick, std::move( callback ) );
+}
+
 /**
  * @brief Advances the in-game clock by one tick, updating minute/hour/day/season/year
  *        and emitting time-related signals.
@@ -460,35 +545,16 @@ QString Game::intToTime( int time )
 	return out;
 }
 
-/**
- * @brief Ticks all plants in the world, removing any that return DESTROY (e.g., dead/harvested plants).
- */
-void Game::processPlants()
-{
-	QList<Position> toRemove;
-	for ( auto& p : m_world->plants() )
-	{
-		switch ( p.onTick( GameState::tick, GameState::dayChanged, GameState::seasonChanged ) )
-		{
-			case OnTickReturn::DESTROY:
-				toRemove.push_back( p.getPos() );
-				break;
-			case OnTickReturn::UPDATE:
-				break;
-		}
-	}
-	for ( auto p : toRemove )
-	{
-		m_world->removePlant( p );
-	}
-}
-
 /**
  * @brief Performs auto-save if the day counter has reached zero, then resets the counter.
  *        Pauses the game during save and optionally resumes afterward based on config.
  */
 void Game::autoSave()
 {
+	if ( Replay::isReplaying() )
+	{
+		return;
+	}
 	int daysToNext = Global::cfg->get( "DaysToNextAutoSave" ).toInt();
 
 	if ( daysToNext == 0 )
@@ -22,9 +22,12 @@
 #define GAME_H_
 
 #include "../base/enums.h"
+#include "../base/timerwheel.h"
 
 #include <QObject>
 
+#include <functional>
+
 class Config;
 class NewGameSettings;
 
@@ -96,6 +99,10 @@ class Game : public QObject
 	void setPaused( bool value );
 	void setHeartbeatResponse( int value );
 
+	int simulateTick();
+
+	void schedule( quint64 tick, std::function<void()> callback );
+
 	void generateWorld( NewGameSettings* ngs );
 	void setWorld( int dimX, int dimY, int dimZ );
 	World* world();
@@ -125,6 +132,8 @@ class Game : public QObject
 	QScopedPointer<PathFinder> m_pf;
 
 	QPointer<QTimer> m_timer;
+
+	TimerWheel<std::function<void()>> m_timers;
 	
 	QElapsedTimer m_upsTimer;
 	int m_upsCounter;
@@ -138,8 +147,6 @@ class Game : public QObject
 	int m_guiHeartbeat = 0;
 	int m_guiHeartbeatResponse = 0;
 
-	void processPlants();
-
 	void sendClock();
 	void calcDaylight();
 	int timeToInt( QString time );
@@ -33,6 +33,7 @@
 #include "../game/mechanismmanager.h"
 #include "../game/militarymanager.h"
 #include "../game/newgamesettings.h"
+#include "../game/replay.h"
 #include "../game/world.h"
 #include "../gfx/spritefactory.h"
 #include "../gui/eventconnector.h"
@@ -229,6 +230,7 @@ void GameManager::loadGame( QString folder )
 		Global::sel = new Selection( m_game );
 
 		postCreationInit();
+		Replay::startRecording( folder );
 		m_eventConnector->sendLoadGameDone( true );
 	}
 	else
@@ -315,6 +317,7 @@ void GameManager::postCreationInit()
 	qRegisterMetaType<QSet<unsigned int>>();
 	connect( m_game, &Game::signalUpdateTileInfo,  m_eventConnector->aggregatorTileInfo(), &AggregatorTileInfo::onUpdateAnyTileInfo );
 	connect( m_game, &Game::signalUpdateStockpile, m_eventConnector->aggregatorStockpile(), &AggregatorStockpile::onUpdateAfterTick );
+	connect( m_game, &Game::signalUpdateStockpile, m_eventConnector->aggregatorInventory(), &AggregatorInventory::onUpdateAfterTick );
 	connect( m_game, &Game::signalUpdateTileInfo,  m_eventConnector->aggregatorRenderer(), &AggregatorRenderer::onUpdateAnyTileInfo );
 	connect( m_game, &Game::signalTimeAndDate,     m_eventConnector, &EventConnector::onTimeAndDate );
 	m_game->sendTime();
@@ -28,6 +28,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/inventory.h"
 #include "../game/militarymanager.h"
@@ -56,17 +57,17 @@ Gnome::Gnome( Position& pos, QString name, Gender gender, Game* game ) :
 {
 	m_ignoreNoPass = false;
 
-	int shirt         = rand() % 14 + 1;
+	int shirt         = RNG::rand( RngStream::Gnomes ) % 14 + 1;
 	m_equipment.shirt = "GnomeShirt" + QString::number( shirt );
-	int hair          = rand() % 14 + 1;
+	int hair          = RNG::rand( RngStream::Gnomes ) % 14 + 1;
 	m_equipment.hair  = "GnomeHair" + QString::number( hair );
 
 	auto numHairColors = DB::ids( "HairColors" ).size();
 
-	m_equipment.hairColor  = rand() % numHairColors;
-	m_equipment.shirtColor = rand() % 6;
+	m_equipment.hairColor  = RNG::rand( RngStream::Gnomes ) % numHairColors;
+	m_equipment.shirtColor = RNG::rand( RngStream::Gnomes ) % 6;
 
-	int fhair = rand() % 15;
+	int fhair = RNG::rand( RngStream::Gnomes ) % 15;
 	if ( m_gender == Gender::MALE )
 	{
 		m_equipment.facialHair = "GnomeFacialHair" + QString::number( fhair );
@@ -680,7 +681,7 @@ CreatureTickResult Gnome::onTick( quint64 tickNumber, bool seasonChanged, bool d
 		auto status = m_anatomy.status();
 		if ( status & AS_DEAD )
 		{
-			Global::logger().log( LogType::COMBAT, m_name + "died. Bummer!", m_id );
+			Global::logger().log( LogType::COMBAT, "%1 died. Bummer!", m_id, { m_name } );
 			die();
 			// TODO check for other statuses
 		}
@@ -1095,7 +1096,6 @@ void Gnome::updateAttackValues()
 /// @return Always true.
 bool Gnome::attack( DamageType dt, AnatomyHeight da, int skill, int strength, Position sourcePos, unsigned int attackerID )
 {
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 	// from which side is the attack coming
 	AnatomySide ds = AS_CENTER;
@@ -1155,7 +1155,7 @@ bool Gnome::attack( DamageType dt, AnatomyHeight da, int skill, int strength, Po
 	{
 		int diff = dodge - skill;
 		diff     = qMax( 5, 20 - diff );
-		hit |= rand() % 100 > diff;
+		hit |= RNG::rand( RngStream::Combat ) % 100 > diff;
 	}
 
 	if ( hit ) // check block
@@ -1164,12 +1164,12 @@ bool Gnome::attack( DamageType dt, AnatomyHeight da, int skill, int strength, Po
 
 	if ( hit )
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " took " + QString::number( strength ) + " damage.", m_id );
+		Global::logger().log( LogType::COMBAT, "%1 took %2 damage.", m_id, { m_name, strength } );
 		m_anatomy.damage( &m_equipment, dt, da, ds, strength );
 	}
 	else
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " dogded the attack. Skill:" + QString::number( skill ) + " Dodge: " + QString::number( dodge ), m_id );
+		Global::logger().log( LogType::COMBAT, "%1 dogded the attack. Skill:%2 Dodge: %3", m_id, { m_name, skill, dodge } );
 	}
 
 	bool aeExists = false;
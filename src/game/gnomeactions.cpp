@@ -580,7 +580,7 @@ BT_RESULT Gnome::actionGetJob( bool halt )
 	if ( Global::debugMode )
 		log( "actionGetJob" );
 
-	if ( m_jobCooldown > 0 )
+	if ( m_jobCooldownEnd > GameState::tick )
 	{
 		return BT_RESULT::FAILURE;
 	}
@@ -666,7 +666,7 @@ BT_RESULT Gnome::actionGetJob( bool halt )
 	else
 	{
 		// didn't get a suitable job, so wait some ticks before asking again
-		m_jobCooldown = 100;
+		m_jobCooldownEnd = GameState::tick + 100;
 		return BT_RESULT::FAILURE;
 	}
 
@@ -2280,47 +2280,47 @@ BT_RESULT Gnome::actionAttackTarget( bool halt )
 		m_facing = getFacing( m_position, creature->getPos() );
 
 		//do we have
-		if ( m_globalCooldown <= 0 )
+		if ( m_globalCooldownEnd <= GameState::tick )
 		{
 			if ( m_rightHandArmed || m_leftHandArmed )
 			{
-				if ( m_rightHandCooldown <= 0 )
+				if ( m_rightHandCooldownEnd <= GameState::tick )
 				{
-					Global::logger().log( LogType::COMBAT, m_name + " attacks " + creature->name(), m_id );
+					Global::logger().log( LogType::COMBAT, "%1 attacks %2", m_id, { m_name, creature->name() } );
 					// attack with main hand
 					creature->attack( DT_SLASH, m_anatomy.randomAttackHeight(), m_rightHandAttackSkill, m_rightHandAttackValue, m_position, m_id );
-					m_rightHandCooldown = qMax( 5, 20 - m_rightHandAttackSkill );
-					m_globalCooldown    = 5;
+					m_rightHandCooldownEnd = GameState::tick + qMax( 5, 20 - m_rightHandAttackSkill );
+					m_globalCooldownEnd    = GameState::tick + 5;
 				}
-				else if ( m_leftHandCooldown <= 0 )
+				else if ( m_leftHandCooldownEnd <= GameState::tick )
 				{
 					// wielding an offhand weapon?
 					if ( m_leftHandHasWeapon )
 					{
-						Global::logger().log( LogType::COMBAT, m_name + " attacks " + creature->name(), m_id );
+						Global::logger().log( LogType::COMBAT, "%1 attacks %2", m_id, { m_name, creature->name() } );
 						creature->attack( DT_SLASH, m_anatomy.randomAttackHeight(), m_leftHandAttackSkill, m_leftHandAttackValue, m_position, m_id );
-						m_leftHandCooldown = qMax( 5, 20 - m_leftHandAttackSkill );
-						m_globalCooldown   = 5;
+						m_leftHandCooldownEnd = GameState::tick + qMax( 5, 20 - m_leftHandAttackSkill );
+						m_globalCooldownEnd   = GameState::tick + 5;
 					}
 				}
 			}
 			else //unarmed combat
 			{
-				if ( m_rightHandCooldown <= 0 )
+				if ( m_rightHandCooldownEnd <= GameState::tick )
 				{
-					Global::logger().log( LogType::COMBAT, m_name + " punches " + creature->name(), m_id );
+					Global::logger().log( LogType::COMBAT, "%1 punches %2", m_id, { m_name, creature->name() } );
 					// attack with main hand
 					creature->attack( DT_BLUNT, m_anatomy.randomAttackHeight(), m_rightHandAttackSkill, m_rightHandAttackValue, m_position, m_id );
-					m_rightHandCooldown = qMax( 5, 20 - m_rightHandAttackSkill );
-					m_globalCooldown    = 5;
+					m_rightHandCooldownEnd = GameState::tick + qMax( 5, 20 - m_rightHandAttackSkill );
+					m_globalCooldownEnd    = GameState::tick + 5;
 				}
-				else if ( m_leftHandCooldown <= 0 )
+				else if ( m_leftHandCooldownEnd <= GameState::tick )
 				{
 					// wielding an offhand weapon?
-					Global::logger().log( LogType::COMBAT, m_name + " punches " + creature->name(), m_id );
+					Global::logger().log( LogType::COMBAT, "%1 punches %2", m_id, { m_name, creature->name() } );
 					creature->attack( DT_BLUNT, m_anatomy.randomAttackHeight(), m_leftHandAttackSkill, m_leftHandAttackValue, m_position, m_id );
-					m_leftHandCooldown = qMax( 5, 20 - m_leftHandAttackSkill );
-					m_globalCooldown   = 5;
+					m_leftHandCooldownEnd = GameState::tick + qMax( 5, 20 - m_leftHandAttackSkill );
+					m_globalCooldownEnd   = GameState::tick + 5;
 				}
 			}
 		}
@@ -2525,7 +2525,8 @@ BT_RESULT Gnome::actionGetTarget( bool halt )
 				{
 					if ( prio.attitude != MilAttitude::FLEE )
 					{
-						const auto& targetSet = g->cm()->animalsByType( prio.type );
+						// attack and defend only consider targets in sight range, the proximity index skips the rest
+						const auto& targetSet = prio.attitude == MilAttitude::HUNT ? g->cm()->animalsByType( prio.type ) : g->cm()->animalsInRange( m_position, prio.type, prio.attitude == MilAttitude::DEFEND ? 4 : 100 );
 						//!TODO Sort huntTargets into buckets by regionm so hasPathTo will never fail
 						for ( const auto& targetID : targetSet )
 						{
@@ -339,7 +339,8 @@ BT_RESULT Gnome::conditionHasHuntTarget( bool halt )
 		{
 			if ( prio.attitude != MilAttitude::FLEE )
 			{
-				const auto& targetSet = g->cm()->animalsByType( prio.type );
+				// attack and defend only consider targets in sight range, the proximity index skips the rest
+				const auto& targetSet = prio.attitude == MilAttitude::HUNT ? g->cm()->animalsByType( prio.type ) : g->cm()->animalsInRange( m_position, prio.type, prio.attitude == MilAttitude::DEFEND ? 4 : 100 );
 				for ( const auto& targetID : targetSet )
 				{
 					//!TODO Bucket targets by region cluster, so this can become amortized constant cost
@@ -23,6 +23,7 @@
 #include "../base/config.h"
 #include "../base/db.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../game/game.h"
 #include "../game/gnome.h"
 #include "../game/gnomemanager.h"
@@ -62,7 +63,7 @@ bool GnomeFactory::init()
 Gnome* GnomeFactory::createGnome( Position& pos )
 {
 	QString name  = "NotSet";
-	Gender gender = ( rand() % 2 == 0 ) ? Gender::MALE : Gender::FEMALE;
+	Gender gender = ( RNG::rand( RngStream::Gnomes ) % 2 == 0 ) ? Gender::MALE : Gender::FEMALE;
 
 	QList<QVariantMap> vnl;
 	if ( gender == Gender::MALE )
@@ -78,7 +79,7 @@ Gnome* GnomeFactory::createGnome( Position& pos )
 	while ( !foundName )
 	{
 		foundName = true;
-		name      = vnl.value( rand() % vnl.size() ).value( "ID" ).toString();
+		name      = vnl.value( RNG::rand( RngStream::Gnomes ) % vnl.size() ).value( "ID" ).toString();
 		name.replace( 0, 1, name[0].toUpper() );
 		for ( auto& gn : g->gm()->gnomes() )
 		{
@@ -99,7 +100,7 @@ Gnome* GnomeFactory::createGnome( Position& pos )
 	{
 		QString attributeID = row.value( "ID" ).toString();
 
-		gnome->addAttribute( attributeID, rand() % 10 + 1 );
+		gnome->addAttribute( attributeID, RNG::rand( RngStream::Gnomes ) % 10 + 1 );
 	}
 
 	auto needs = DB::selectRows( "Needs" );
@@ -110,7 +111,7 @@ Gnome* GnomeFactory::createGnome( Position& pos )
 		{
 			QString needID = row.value( "ID" ).toString();
 			int max        = row.value( "Max_" ).toInt();
-			gnome->addNeed( needID, max - ( rand() % 20 ) );
+			gnome->addNeed( needID, max - ( RNG::rand( RngStream::Gnomes ) % 20 ) );
 		}
 	}
 
@@ -120,7 +121,7 @@ Gnome* GnomeFactory::createGnome( Position& pos )
 	{
 		QString skillID = skill.value( "ID" ).toString();
 
-		gnome->addSkill( skillID, rand() % 2000 );
+		gnome->addSkill( skillID, RNG::rand( RngStream::Gnomes ) % 2000 );
 		gnome->setSkillActive( skillID, true );
 	}
 
@@ -137,7 +138,7 @@ Gnome* GnomeFactory::createGnome( Position& pos )
 GnomeTrader* GnomeFactory::createGnomeTrader( Position& pos )
 {
 	QString name  = "NotSet";
-	Gender gender = ( rand() % 2 == 0 ) ? Gender::MALE : Gender::FEMALE;
+	Gender gender = ( RNG::rand( RngStream::Gnomes ) % 2 == 0 ) ? Gender::MALE : Gender::FEMALE;
 
 	QList<QVariantMap> vnl;
 	if ( gender == Gender::MALE )
@@ -152,7 +153,7 @@ GnomeTrader* GnomeFactory::createGnomeTrader( Position& pos )
 	while ( !foundName )
 	{
 		foundName = true;
-		name      = vnl.value( rand() % vnl.size() ).value( "ID" ).toString();
+		name      = vnl.value( RNG::rand( RngStream::Gnomes ) % vnl.size() ).value( "ID" ).toString();
 		name.replace( 0, 1, name[0].toUpper() );
 		for ( auto& gn : g->gm()->gnomes() )
 		{
@@ -172,7 +173,7 @@ GnomeTrader* GnomeFactory::createGnomeTrader( Position& pos )
 	{
 		QString attributeID = row.value( "ID" ).toString();
 
-		gnome->addAttribute( attributeID, rand() % 10 + 1 );
+		gnome->addAttribute( attributeID, RNG::rand( RngStream::Gnomes ) % 10 + 1 );
 	}
 
 	auto needs = DB::selectRows( "Needs" );
@@ -181,7 +182,7 @@ GnomeTrader* GnomeFactory::createGnomeTrader( Position& pos )
 	{
 		QString needID = row.value( "ID" ).toString();
 		int max        = row.value( "Max_" ).toInt();
-		gnome->addNeed( needID, max - ( rand() % 20 ) );
+		gnome->addNeed( needID, max - ( RNG::rand( RngStream::Gnomes ) % 20 ) );
 	}
 
 	auto skills = DB::selectRows( "Skills" );
@@ -190,7 +191,7 @@ GnomeTrader* GnomeFactory::createGnomeTrader( Position& pos )
 	{
 		QString skillID = skill.value( "ID" ).toString();
 
-		gnome->addSkill( skillID, rand() % 2000 );
+		gnome->addSkill( skillID, RNG::rand( RngStream::Gnomes ) % 2000 );
 		gnome->setSkillActive( skillID, true );
 	}
 
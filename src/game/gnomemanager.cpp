@@ -26,12 +26,14 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/io.h"
+#include "../base/profiler.h"
 #include "../game/creature.h"
 #include "../game/gnomefactory.h"
 #include "../game/gnometrader.h"
 #include "../game/inventory.h"
 #include "../game/jobmanager.h"
 #include "../game/militarymanager.h"
+#include "../game/replay.h"
 #include "../game/world.h"
 #include "../gfx/spritefactory.h"
 
@@ -137,6 +139,7 @@ void GnomeManager::addAutomaton( Automaton* a )
 {
 	m_automatons.append( a );
 	m_gnomesByID.insert( a->id(), m_automatons.last() );
+	wakeAutomaton( a->id() );
 
 	//a->setSpriteID( Global::sf().setAutomatonSprite( a->id(), g->m_inv->spriteID( a->automatonItem() ) ) );
 	//a->updateSprite();
@@ -150,6 +153,7 @@ void GnomeManager::addAutomaton( QVariantMap values )
 	Automaton* a = new Automaton( values, g );
 	m_automatons.append( a );
 	m_gnomesByID.insert( a->id(), m_automatons.last() );
+	wakeAutomaton( a->id() );
 
 	//a->setSpriteID( Global::sf().setAutomatonSprite( a->id(), g->m_inv->spriteID( a->automatonItem() ) ) );
 	//a->updateSprite();
@@ -205,12 +209,12 @@ void GnomeManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChang
 		QElapsedTimer timer2;
 		timer2.start();
 
-		CreatureTickResult tr = g->onTick( tickNumber, seasonChanged, dayChanged, hourChanged, minuteChanged );
+		CreatureTickResult tr = gn->onTick( tickNumber, seasonChanged, dayChanged, hourChanged, minuteChanged );
 
 		auto elapsed = timer2.elapsed();
 		if ( elapsed > 100 )
 		{
-			qDebug() << g->name() << "just needed" << elapsed << "ms for tick";
+			qDebug() << gn->name() << "just needed" << elapsed << "ms for tick";
 			Global::cfg->set( "Pause", true );
 			return;
 		}
@@ -236,7 +240,7 @@ void GnomeManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChang
 				break;
 		}
 
-		if ( timer.elapsed() > 5 )
+		if ( timer.elapsed() > 5 && !Replay::active() )
 		{
 			break;
 		}
@@ -317,6 +321,7 @@ void GnomeManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChang
 			if ( dg->expires() < GameState::tick )
 			{
 				m_gnomesByID.remove( dg->id() );
+				g->m_world->removeCreatureFromPosition( dg->getPos(), dg->id() );
 				g->m_world->addToUpdateList( dg->getPos() );
 				m_deadGnomes.removeAt( i );
 				delete dg;
@@ -347,38 +352,26 @@ void GnomeManager::forceMoveGnomes( Position from, Position to )
 }
 
 /** @brief Returns all gnomes (living, special, automatons, dead) at a given position.
+ *
+ *  Uses the world's per-tile creature list, other creatures on the tile are skipped.
+ *
  *  @param pos The world position to query.
  *  @return List of Gnome pointers at that position.
  */
 QList<Gnome*> GnomeManager::gnomesAtPosition( Position pos )
 {
 	QList<Gnome*> out;
-	for ( int i = 0; i < m_gnomes.size(); ++i )
-	{
-		if ( m_gnomes[i]->getPos() == pos && !m_gnomes[i]->goneOffMap() )
-		{
-			out.push_back( m_gnomes[i] );
-		}
-	}
-	for ( int i = 0; i < m_specialGnomes.size(); ++i )
-	{
-		if ( m_specialGnomes[i]->getPos() == pos )
-		{
-			out.push_back( m_specialGnomes[i] );
-		}
-	}
-	for ( int i = 0; i < m_automatons.size(); ++i )
+	const auto& positions = g->m_world->creaturePositions();
+	auto it               = positions.constFind( pos.toInt() );
+	if ( it != positions.constEnd() )
 	{
-		if ( m_automatons[i]->getPos() == pos )
+		for ( auto id : it.value() )
 		{
-			out.push_back( m_automatons[i] );
-		}
-	}
-	for ( int i = 0; i < m_deadGnomes.size(); ++i )
-	{
-		if ( m_deadGnomes[i]->getPos() == pos )
-		{
-			out.push_back( m_deadGnomes[i] );
+			Gnome* gn = m_gnomesByID.value( id );
+			if ( gn && gn->getPos() == pos && !gn->goneOffMap() )
+			{
+				out.push_back( gn );
+			}
 		}
 	}
 	return out;
@@ -391,11 +384,11 @@ QList<Gnome*> GnomeManager::gnomesAtPosition( Position pos )
 QList<Gnome*> GnomeManager::deadGnomesAtPosition( Position pos )
 {
 	QList<Gnome*> out;
-	for ( int i = 0; i < m_deadGnomes.size(); ++i )
+	for ( auto gn : gnomesAtPosition( pos ) )
 	{
-		if ( m_deadGnomes[i]->getPos() == pos )
+		if ( gn->isDead() )
 		{
-			out.push_back( m_deadGnomes[i] );
+			out.push_back( gn );
 		}
 	}
 	return out;
@@ -620,10 +613,25 @@ bool GnomeManager::gnomeCanReach( unsigned int gnomeID, Position pos )
 /** @brief Creates maintenance jobs (refuel, install core, uninstall core) for automatons that need them. */
 void GnomeManager::createJobs()
 {
-	for ( auto a : m_automatons )
+	if ( m_wokenAutomatons.isEmpty() )
 	{
-		if ( a->maintenanceJobID() == 0 )
+		return;
+	}
+	Profiler::count( ProfileCounter::AutomatonsWoken, m_wokenAutomatons.size() );
+
+	QList<unsigned int> woken;
+	woken.swap( m_wokenAutomatons );
+	for ( auto id : woken )
+	{
+		Automaton* a = automaton( id );
+		if ( !a )
+		{
+			continue;
+		}
+		const unsigned int maintJobID = a->maintenanceJobID();
+		if ( maintJobID == 0 )
 		{
+			bool needsJob = true;
 			// has core
 			if ( a->coreItem() )
 			{
@@ -636,6 +644,10 @@ void GnomeManager::createJobs()
 				{
 					getRefuelJob( a );
 				}
+				else
+				{
+					needsJob = false;
+				}
 			}
 			else
 			{
@@ -644,8 +656,38 @@ void GnomeManager::createJobs()
 				{
 					getInstallJob( a );
 				}
+				else
+				{
+					needsJob = false;
+				}
+			}
+			if ( needsJob && a->maintenanceJobID() == 0 )
+			{
+				// the job could not be created, try again next tick
+				wakeAutomaton( id );
 			}
 		}
+		else if ( !g->jm()->getJob( maintJobID ) )
+		{
+			// the job manager dropped the job but a gnome still holds it, look again next tick
+			wakeAutomaton( id );
+		}
+	}
+}
+
+/** @brief Queues an automaton for a maintenance check on the next tick.
+ *
+ *  Automatons only need a maintenance job after their core, fuel or settings changed,
+ *  or after their last maintenance job ended. The places that change those call this
+ *  instead of createJobs() checking every automaton each tick.
+ *
+ *  @param automatonID ID of the automaton.
+ */
+void GnomeManager::wakeAutomaton( unsigned int automatonID )
+{
+	if ( !m_wokenAutomatons.contains( automatonID ) )
+	{
+		m_wokenAutomatons.append( automatonID );
 	}
 }
 
@@ -48,6 +48,8 @@ class GnomeManager : public QObject
 
 	QList<Gnome*> m_specialGnomes;
 	QList<Automaton*> m_automatons;
+	// automatons whose maintenance needs have to be checked on the next tick, in wake order
+	QList<unsigned int> m_wokenAutomatons;
 
 	int m_startIndex = 0;
 
@@ -105,6 +107,7 @@ class GnomeManager : public QObject
 
 	bool gnomeCanReach( unsigned int gnomeID, Position pos );
 
+	void wakeAutomaton( unsigned int automatonID );
 	void createJobs();
 
 	void setInMission( unsigned int gnomeID, unsigned int missionID );
@@ -26,6 +26,7 @@
 #include "../base/config.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/workshop.h"
 #include "../game/workshopmanager.h"
@@ -267,7 +268,6 @@ BT_RESULT GnomeTrader::actionTrade( bool halt )
  *  @param items List of variant maps describing available trade items with Min_/Max_ ranges. */
 void GnomeTrader::setInventory( QVariantList items )
 {
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 	m_traderDefinition.items.clear();
 
@@ -280,7 +280,7 @@ void GnomeTrader::setInventory( QVariantList items )
 		int amount        = 0;
 		if ( modVal > 0 )
 		{
-			amount = rand() % modVal;
+			amount = RNG::rand( RngStream::Gnomes ) % modVal;
 		}
 
 		if ( amount > 0 )
@@ -40,6 +40,12 @@
 #include <QJsonDocument>
 #include <QJsonValue>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
 /** @brief Construct the Inventory system, initialize category hierarchy and food/drink lookups.
  *  @param parent Owning Game instance.
  */
@@ -55,8 +61,10 @@ Inventory::Inventory( Game* parent ) :
 Inventory::~Inventory()
 {
 	m_items.clear();
+	m_itemHandles.clear();
 	m_positionHash.clear();
 	m_hash.clear();
+	m_catalog.clear();
 
 	m_categoriesSorted.clear();
 	m_groupsSorted.clear();
@@ -67,12 +75,9 @@ Inventory::~Inventory()
 	m_foodItems.clear();
 	m_drinkItems.clear();
 
-	for ( const auto& octtreeGroup : m_octrees )
+	for ( const auto& octree : m_octrees )
 	{
-		for (const auto& octree : octtreeGroup)
-		{
-			delete octree;
-		}
+		delete octree;
 	}
 }
 
@@ -106,11 +111,11 @@ void Inventory::init()
 			{
 				QString itemID = vItem.toString();
 				m_itemsSorted[categoryID][groupID].push_back( itemID );
-				m_hash[itemID];
+				m_catalog[itemID];
 
 				for ( auto materialID : Global::util->possibleMaterialsForItem( itemID ) )
 				{
-					m_hash[itemID].insert( materialID, QSet<unsigned int>() );
+					m_catalog[itemID].insert( materialID );
 				}
 			}
 		}
@@ -149,11 +154,11 @@ void Inventory::init()
 void Inventory::saveFilter()
 {
 	QVariantList filter;
-	for ( auto itemID : m_hash.keys() )
+	for ( auto it = m_catalog.constBegin(); it != m_catalog.constEnd(); ++it )
 	{
-		for ( auto materialID : m_hash[itemID].keys() )
+		for ( const auto& materialID : it.value() )
 		{
-			filter.append( itemID + "_" + materialID );
+			filter.append( it.key() + "_" + materialID );
 		}
 	}
 	GameState::itemFilter = filter;
@@ -169,12 +174,8 @@ void Inventory::loadFilter()
 		auto comp  = entry.split( "_" );
 		if ( comp.size() == 2 )
 		{
-			m_hash[comp[0]].insert( comp[1], QSet<unsigned int>() );
-
-			int x = Global::dimX / 2;
-			int y = Global::dimY / 2;
-			int z = Global::dimZ / 2;
-			m_octrees[comp[0]].insert( comp[1], new Octree( x, y, z, x, y, z ) );
+			m_catalog[comp[0]].insert( comp[1] );
+			octree( DBH::itemUID( comp[0] ), DBH::materialUID( comp[1] ) );
 		}
 	}
 }
@@ -185,12 +186,7 @@ void Inventory::loadFilter()
  */
 Item* Inventory::getItem( unsigned int itemUID )
 {
-	auto it = m_items.find( itemUID );
-	if ( it != m_items.end() )
-	{
-		return &(*it);
-	}
-	return nullptr;
+	return m_items.get( m_itemHandles.get( itemUID ) );
 }
 
 /** @brief Check whether an item with the given ID exists in the registry.
@@ -199,11 +195,7 @@ Item* Inventory::getItem( unsigned int itemUID )
  */
 bool Inventory::itemExists( unsigned int itemID )
 {
-	if ( m_items.contains( itemID ) )
-	{
-		return true;
-	}
-	return false;
+	return getItem( itemID ) != nullptr;
 }
 
 /** @brief Create a simple item at a position with a given type and material.
@@ -326,11 +318,143 @@ unsigned int Inventory::createItem( const QVariantMap& values )
 	//Item obj( pos, baseItem, material );
 	Item obj( values );
 
+	return loadItem( obj );
+}
+
+/** @brief Register an item read from a save game: creates its sprite and adds it to all indices.
+ *  @param obj Deserialized item, keeps its saved ID.
+ *  @return ID of the item, 0 if its item or material UID is unknown.
+ */
+unsigned int Inventory::loadItem( Item& obj )
+{
+	if ( !createLoadedSprite( obj ) )
+	{
+		return 0;
+	}
+	addObject( obj, obj.itemSID(), obj.materialSID() );
+
+	return obj.id();
+}
+
+/** @brief Morton code of a position, interleaves the bits of the three coordinates. */
+static quint64 mortonCode( const Position& pos )
+{
+	auto spread = []( quint64 v ) {
+		v = ( v | v << 32 ) & 0x001f00000000ffffull;
+		v = ( v | v << 16 ) & 0x001f0000ff0000ffull;
+		v = ( v | v << 8 ) & 0x100f00f00f00f00full;
+		v = ( v | v << 4 ) & 0x10c30c30c30c30c3ull;
+		v = ( v | v << 2 ) & 0x1249249249249249ull;
+		return v;
+	};
+	return spread( (quint16)pos.x ) << 2 | spread( (quint16)pos.y ) << 1 | spread( (quint16)pos.z );
+}
+
+/** @brief Register all items read from a save game at once.
+ *
+ *  Does what loadItem() does for each item but builds the indices in bulk. The
+ *  items are sorted by item/material key and by the Morton code of their position,
+ *  so items of one kind that lie close together also lie close together in the item
+ *  storage. Every kind is then one run: its octree is filled from the whole run in
+ *  one pass, and the octrees of all kinds are filled in parallel.
+ *
+ *  @param items Deserialized items, keep their saved IDs.
+ *  @return Number of items added.
+ */
+int Inventory::loadItems( std::vector<Item>& items )
+{
+	struct SortEntry
+	{
+		quint32 key;
+		quint64 morton;
+		Item* item;
+	};
+	std::vector<SortEntry> order;
+	order.reserve( items.size() );
+	for ( auto& obj : items )
+	{
+		// the sprite factory isn't thread safe, sprites are created here one by one
+		if ( createLoadedSprite( obj ) )
+		{
+			order.push_back( { itemKey( obj.itemUID(), obj.materialUID() ), mortonCode( obj.getPos() ), &obj } );
+		}
+	}
+	std::sort( order.begin(), order.end(), []( const SortEntry& a, const SortEntry& b ) {
+		if ( a.key != b.key )
+			return a.key < b.key;
+		if ( a.morton != b.morton )
+			return a.morton < b.morton;
+		return a.item->id() < b.item->id();
+	} );
+
+	m_positionHash.reserve( m_positionHash.size() + (qsizetype)order.size() );
+
+	std::vector<std::pair<Octree*, std::vector<Octree::Entry>>> octrees;
+	for ( size_t begin = 0, end = 0; begin < order.size(); begin = end )
+	{
+		const quint32 key = order[begin].key;
+		for ( end = begin; end < order.size() && order[end].key == key; ++end )
+		{
+		}
+		const Item& first        = *order[begin].item;
+		const QString itemID     = first.itemSID();
+		const QString materialID = first.materialSID();
+
+		m_hash[key].reserve( m_hash[key].size() + (qsizetype)( end - begin ) );
+		octrees.emplace_back( octree( first.itemUID(), first.materialUID() ), std::vector<Octree::Entry>() );
+		auto& entries = octrees.back().second;
+		entries.reserve( end - begin );
+
+		for ( size_t i = begin; i < end; ++i )
+		{
+			Item* item = storeObject( *order[i].item );
+			if ( !item->isHeldBy() )
+			{
+				const Position& pos = item->getPos();
+				entries.push_back( { pos.x, pos.y, pos.z, item->id() } );
+			}
+			indexObject( item, itemID, materialID );
+		}
+		// listeners only refresh the stock rows of the kind
+		emit signalAddItem( itemID, materialID );
+	}
+
+	std::atomic<size_t> next( 0 );
+	const int numWorkers = qBound( 1, (int)std::thread::hardware_concurrency(), qMax( 1, (int)octrees.size() ) );
+	std::vector<std::future<void>> tasks;
+	for ( int i = 0; i < numWorkers; ++i )
+	{
+		tasks.emplace_back( std::async( std::launch::async, [&next, &octrees]() {
+			for ( size_t t = next++; t < octrees.size(); t = next++ )
+			{
+				auto& entries = octrees[t].second;
+				octrees[t].first->insertItems( entries.data(), entries.data() + entries.size() );
+			}
+		} ) );
+	}
+	for ( auto& task : tasks )
+	{
+		task.get();
+	}
+
+	return (int)order.size();
+}
+
+/** @brief Checks the UIDs of an item read from a save game and creates its sprite.
+ *  @param obj Deserialized item, receives the sprite ID.
+ *  @return False if its item or material UID is unknown.
+ */
+bool Inventory::createLoadedSprite( Item& obj )
+{
+	if ( !GameState::itemID2SID.contains( obj.itemUID() ) || !GameState::materialID2SID.contains( obj.materialUID() ) )
+	{
+		qDebug() << "unknown item or material UID" << obj.itemUID() << obj.materialUID() << "of item" << obj.id() << "at" << obj.getPos().toString();
+		return false;
+	}
 	QString baseItem = obj.itemSID();
 	QString material = obj.materialSID();
 	//qDebug() << "inventory create item " << baseItem << material;
 
-	QString spr    = DBH::spriteID( baseItem );
 	Sprite* sprite = nullptr;
 	if ( obj.components().isEmpty() )
 	{
@@ -350,27 +474,91 @@ unsigned int Inventory::createItem( const QVariantMap& values )
 	{
 		obj.setSpriteID( sprite->uID );
 	}
-
-	addObject( obj, baseItem, material );
-
-	return obj.id();
+	return true;
 }
 
 /** @brief Get or create the octree for a given item+material combination.
- *  @param itemSID Item type string ID.
- *  @param materialSID Material string ID.
+ *  @param itemUID Item type UID.
+ *  @param materialUID Material UID.
  *  @return Pointer to the spatial octree for this item/material pair.
  */
-Octree* Inventory::octree( const QString& itemSID, const QString& materialSID )
+Octree* Inventory::octree( unsigned short itemUID, unsigned short materialUID )
 {
-	if ( !m_octrees.contains( itemSID ) || !m_octrees[itemSID].contains( materialSID ) )
+	const quint32 key = itemKey( itemUID, materialUID );
+	auto it           = m_octrees.constFind( key );
+	if ( it != m_octrees.constEnd() )
 	{
-		int x = Global::dimX / 2;
-		int y = Global::dimY / 2;
-		int z = Global::dimZ / 2;
-		m_octrees[itemSID].insert( materialSID, new Octree( x, y, z, x, y, z ) );
+		return it.value();
 	}
-	return m_octrees[itemSID][materialSID];
+	int x = Global::dimX / 2;
+	int y = Global::dimY / 2;
+	int z = Global::dimZ / 2;
+	Octree* ot = new Octree( x, y, z, x, y, z );
+	m_octrees.insert( key, ot );
+	m_materialsOfItem[itemUID].append( materialUID );
+	return ot;
+}
+
+/** @brief Translate string IDs into the UIDs used by the indices without registering new ones.
+ *  @param itemSID Item type string ID.
+ *  @param materialSID Material string ID or "any".
+ *  @param itemUID Receives the item UID.
+ *  @param materialUID Receives the material UID, anyMaterial for "any".
+ *  @return False if one of the IDs was never used by any item, no item can match then.
+ */
+bool Inventory::resolveUIDs( const QString& itemSID, const QString& materialSID, unsigned short& itemUID, unsigned short& materialUID )
+{
+	auto it = GameState::itemSID2ID.constFind( itemSID );
+	if ( it == GameState::itemSID2ID.constEnd() )
+	{
+		return false;
+	}
+	itemUID = it.value();
+
+	if ( materialSID == "any" )
+	{
+		materialUID = anyMaterial;
+		return true;
+	}
+	auto mt = GameState::materialSID2ID.constFind( materialSID );
+	if ( mt == GameState::materialSID2ID.constEnd() )
+	{
+		return false;
+	}
+	materialUID = mt.value();
+	return true;
+}
+
+/** @brief Index keys an item/material query covers.
+ *  @param itemUID Item type UID.
+ *  @param materialUID Material UID or anyMaterial for all materials that ever had an item.
+ *  @return The packed keys.
+ */
+QList<quint32> Inventory::keysFor( unsigned short itemUID, unsigned short materialUID ) const
+{
+	QList<quint32> out;
+	if ( materialUID != anyMaterial )
+	{
+		out.append( itemKey( itemUID, materialUID ) );
+		return out;
+	}
+	for ( auto mat : m_materialsOfItem.value( itemUID ) )
+	{
+		out.append( itemKey( itemUID, mat ) );
+	}
+	return out;
+}
+
+/** @brief Copy an item into the item storage, replacing an item with the same ID.
+ *  @param object The item to store.
+ *  @return The stored item.
+ */
+Item* Inventory::storeObject( const Item& object )
+{
+	m_items.erase( m_itemHandles.get( object.id() ) );
+	const SlabHandle handle = m_items.emplace( object );
+	m_itemHandles.set( object.id(), handle );
+	return m_items.get( handle );
 }
 
 /** @brief Register a newly created item in all indices (position hash, octree, type hash, history).
@@ -380,30 +568,34 @@ Octree* Inventory::octree( const QString& itemSID, const QString& materialSID )
  */
 void Inventory::addObject( Item& object, const QString& itemID, const QString& materialID )
 {
-	m_items.insert( object.id(), object );
-	Item* item = getItem( object.id() );
-	
-	Octree* ot = octree( itemID, materialID );
+	Item* item = storeObject( object );
 
 	if ( !item->isHeldBy() )
 	{
-		if ( m_positionHash.contains( item->getPos().toInt() ) )
-		{
-			m_positionHash[item->getPos().toInt()].insert( item->id() );
-		}
-		else
-		{
-			PositionEntry entry;
-			entry.insert( item->id() );
-			m_positionHash.insert( item->getPos().toInt(), entry );
-		}
-
 		Position pos = item->getPos();
-		ot->insertItem( pos.x, pos.y, pos.z, item->id() );
-		
+		octree( item->itemUID(), item->materialUID() )->insertItem( pos.x, pos.y, pos.z, item->id() );
+	}
+	indexObject( item, itemID, materialID );
+
+	emit signalAddItem( itemID, materialID );
+}
+
+/** @brief Register a stored item in every index except its octree.
+ *  @param item The stored item.
+ *  @param itemID Item type string ID.
+ *  @param materialID Material string ID.
+ */
+void Inventory::indexObject( Item* item, const QString& itemID, const QString& materialID )
+{
+	const quint32 key = itemKey( item->itemUID(), item->materialUID() );
+
+	if ( !item->isHeldBy() )
+	{
+		m_positionHash[item->getPos().toInt()].insert( item->id() );
+
 		if ( !item->isInContainer() )
 		{
-			g->m_world->setItemSprite( item->getPos(), object.spriteID() );
+			g->m_world->setItemSprite( item->getPos(), item->spriteID() );
 		}
 
 		if ( item->isInStockpile() )
@@ -412,35 +604,28 @@ void Inventory::addObject( Item& object, const QString& itemID, const QString& m
 		}
 	}
 
-	if ( object.nutritionalValue() != 0 )
+	if ( item->nutritionalValue() != 0 )
 	{
-		m_foodItems.insert( object.id(), object.nutritionalValue() );
+		m_foodItems.insert( item->id(), item->nutritionalValue() );
 	}
-	if ( object.drinkValue() != 0 )
+	if ( item->drinkValue() != 0 )
 	{
-		m_drinkItems.insert( object.id(), object.drinkValue() );
+		m_drinkItems.insert( item->id(), item->drinkValue() );
 	}
 
-	if ( m_hash[itemID].contains( materialID ) )
-	{
-		m_hash[itemID][materialID].insert( item->id() );
-	}
-	else
-	{
-		m_hash[itemID].insert( materialID, QSet<unsigned int>() );
-		m_hash[itemID][materialID].insert( item->id() );
-	}
+	m_hash[key].insert( item->id() );
+	m_catalog[itemID].insert( materialID );
+	updateLooseItem( item );
+	countItem( item, 1 );
 
 	m_itemHistory->plusItem( itemID, materialID );
 
 	m_itemsChanged = true;
-
-	emit signalAddItem( itemID, materialID );
 }
 
 void Inventory::destroyObject( unsigned int id )
 {
-	if ( m_items.contains( id ) )
+	if ( itemExists( id ) )
 	{
 		Item* item = getItem( id );
 		if ( item )
@@ -461,18 +646,23 @@ void Inventory::destroyObject( unsigned int id )
 
 			item->setInContainer( 0 );
 
-			QString materialSID = DBH::materialSID( item->materialUID() );
-			QString itemSID     = DBH::itemSID( item->itemUID() );
+			QString materialSID = item->materialSID();
+			QString itemSID     = item->itemSID();
 
-			Octree* ot = octree( itemSID, materialSID );
+			const quint32 key = itemKey( item->itemUID(), item->materialUID() );
+
+			Octree* ot = octree( item->itemUID(), item->materialUID() );
 			ot->removeItem( pos.x, pos.y, pos.z, id );
 
-			m_hash[itemSID][materialSID].remove( id );
+			countItem( item, -1 );
+			m_hash[key].remove( id );
+			m_looseItems[key].remove( id );
 
 			m_foodItems.remove( id );
 			m_drinkItems.remove( id );
 			// finally remove object
-			m_items.remove( id );
+			m_items.erase( m_itemHandles.get( id ) );
+			m_itemHandles.remove( id );
 
 			m_itemHistory->minusItem( itemSID, materialSID );
 
@@ -556,7 +746,18 @@ int Inventory::countItemsAtPos( Position& pos )
 
 unsigned int Inventory::getClosestItem( const Position& pos, bool allowInStockpile, QString itemSID, QString materialSID )
 {
-	auto out = getClosestItems( pos, allowInStockpile, itemSID, materialSID, 1 );
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return 0;
+	}
+	return getClosestItem( pos, allowInStockpile, itemUID, materialUID );
+}
+
+unsigned int Inventory::getClosestItem( const Position& pos, bool allowInStockpile, unsigned short itemUID, unsigned short materialUID )
+{
+	auto out = getClosestItems( pos, allowInStockpile, itemUID, materialUID, 1 );
 	if ( !out.isEmpty() )
 	{
 		return out.first();
@@ -582,16 +783,29 @@ unsigned int Inventory::getClosestItem2( const Position& pos, bool allowInStockp
 }
 
 bool Inventory::checkReachableItems( Position pos, bool allowInStockpile, int count, QString itemSID, QString materialSID )
+{
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return count <= 0;
+	}
+	return checkReachableItems( pos, allowInStockpile, count, itemUID, materialUID );
+}
+
+bool Inventory::checkReachableItems( const Position& pos, bool allowInStockpile, int count, unsigned short itemUID, unsigned short materialUID )
 {
 	int thisCount  = 0;
-	int partitions = 0;
 
-	auto predicate = [&thisCount, this, allowInStockpile, pos, count]( unsigned int itemID ) -> bool {
+	RegionMap& regionMap         = g->m_world->regionMap();
+	const unsigned int component = regionMap.componentID( pos );
+
+	auto predicate = [&thisCount, this, &regionMap, component, allowInStockpile, count]( unsigned int itemID ) -> bool {
 		auto item = getItem( itemID );
 
 		if ( item && ( allowInStockpile || !item->isInStockpile() ) && item->isFree() )
 		{
-			if ( g->m_world->regionMap().checkConnectedRegions( pos, item->getPos() ) && g->m_world->fluidLevel( item->getPos() ) < 6 )
+			if ( regionMap.componentID( item->getPos() ) == component && g->m_world->fluidLevel( item->getPos() ) < 6 )
 			{
 				++thisCount;
 			}
@@ -602,21 +816,13 @@ bool Inventory::checkReachableItems( Position pos, bool allowInStockpile, int co
 		}
 		return true;
 	};
-	
-	if ( materialSID == "any" )
-	{
-		for ( auto material : m_octrees[itemSID].keys() )
-		{
-			Octree* ot = octree( itemSID, material );
-			ot->visit( pos.x, pos.y, pos.z, predicate );
-			if ( thisCount >= count )
-				break;
-		}
-	}
-	else
+
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		Octree* ot = octree( itemSID, materialSID );
+		Octree* ot = octree( key >> 16, key & 0xffff );
 		ot->visit( pos.x, pos.y, pos.z, predicate );
+		if ( thisCount >= count )
+			break;
 	}
 
 	return thisCount >= count;
@@ -624,46 +830,32 @@ bool Inventory::checkReachableItems( Position pos, bool allowInStockpile, int co
 
 unsigned int Inventory::getItemAtPos( const Position& pos, bool allowInStockpile, QString itemSID, QString materialSID )
 {
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return 0;
+	}
+
 	if ( m_positionHash.contains( pos.toInt() ) )
 	{
 		auto itemIDs = m_positionHash[pos.toInt()];
 
-		if ( materialSID == "any" )
+		for ( auto itemID : itemIDs )
 		{
-			for ( auto itemID : itemIDs )
+			auto item = getItem( itemID );
+			if ( item )
 			{
-				auto item = getItem( itemID );
-				if ( item )
-				{
-					if ( itemSID == item->itemSID() && ( allowInStockpile || !item->isInStockpile() ) && item->isFree() )
-					{
-						return itemID;
-					}
-				}
-				else
+				if ( item->itemUID() == itemUID &&
+					 ( materialUID == anyMaterial || item->materialUID() == materialUID ) &&
+					 ( allowInStockpile || !item->isInStockpile() ) && item->isFree() )
 				{
-					m_positionHash[pos.toInt()].remove( itemID );
+					return itemID;
 				}
 			}
-		}
-		else
-		{
-			for ( auto itemID : itemIDs )
+			else
 			{
-				auto item = getItem( itemID );
-				if ( item )
-				{
-					if ( item->itemSID() == itemSID &&
-						 item->materialSID() == materialSID &&
-						 ( allowInStockpile || !item->isInStockpile() ) && item->isFree() )
-					{
-						return itemID;
-					}
-				}
-				else
-				{
-					m_positionHash[pos.toInt()].remove( itemID );
-				}
+				m_positionHash[pos.toInt()].remove( itemID );
 			}
 		}
 	}
@@ -671,15 +863,29 @@ unsigned int Inventory::getItemAtPos( const Position& pos, bool allowInStockpile
 }
 
 QList<unsigned int> Inventory::getClosestItems( const Position& pos, bool allowInStockpile, QString itemSID, QString materialSID, int count )
+{
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return QList<unsigned int>();
+	}
+	return getClosestItems( pos, allowInStockpile, itemUID, materialUID, count );
+}
+
+QList<unsigned int> Inventory::getClosestItems( const Position& pos, bool allowInStockpile, unsigned short itemUID, unsigned short materialUID, int count )
 {
 	QList<unsigned int> out;
 
-	auto predicate = [&out, this, allowInStockpile, pos, count]( unsigned int itemID ) -> bool {
+	RegionMap& regionMap         = g->m_world->regionMap();
+	const unsigned int component = regionMap.componentID( pos );
+
+	auto predicate = [&out, this, &regionMap, component, allowInStockpile, count]( unsigned int itemID ) -> bool {
 		auto item = getItem( itemID );
 
 		if ( item && ( allowInStockpile || !item->isInStockpile() ) && item->isFree() )
 		{
-			if ( g->m_world->regionMap().checkConnectedRegions( pos, item->getPos() ) && g->m_world->fluidLevel( item->getPos() ) < 6 )
+			if ( regionMap.componentID( item->getPos() ) == component && g->m_world->fluidLevel( item->getPos() ) < 6 )
 			{
 				out.append( itemID );
 				if ( out.size() == count )
@@ -691,17 +897,9 @@ QList<unsigned int> Inventory::getClosestItems( const Position& pos, bool allowI
 		return true;
 	};
 
-	if ( materialSID == "any" )
-	{
-		for ( auto material : m_octrees[itemSID].keys() )
-		{
-			Octree* ot = octree( itemSID, material );
-			ot->visit( pos.x, pos.y, pos.z, predicate );
-		}
-	}
-	else
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		Octree* ot = octree( itemSID, materialSID );
+		Octree* ot = octree( key >> 16, key & 0xffff );
 		ot->visit( pos.x, pos.y, pos.z, predicate );
 	}
 
@@ -722,64 +920,127 @@ QList<unsigned int> Inventory::getClosestItems( const Position& pos, bool allowI
 	return out;
 }
 
+/** @brief Collect the hauling candidates for a stockpile, closest first.
+ *
+ *  Loose items come from the loose item index, so items that already sit in a
+ *  stockpile are never scanned unless the stockpile pulls from others.
+ *
+ *  @param stockpileID Stockpile asking for items.
+ *  @param pos Position the distances are measured from.
+ *  @param allowInStockpile Also return items from stockpiles that have lower priority and allow pulling.
+ *  @param filter (itemSID, materialSID) pairs the stockpile accepts, materialSID may be "any".
+ *  @return Candidate item IDs.
+ */
 QList<unsigned int> Inventory::getClosestItemsForStockpile( unsigned int stockpileID, Position& pos, bool allowInStockpile, QSet<QPair<QString, QString>> filter )
 {
-	QString itemSID;
-	QString materialSID;
-
-	QList<unsigned int> out;
+	std::vector<QPair<int, unsigned int>> loose;
+	QList<unsigned int> pulled;
 	QSet<unsigned int> seen;
 
+	auto addLoose = [&]( const QSet<unsigned int>& items ) {
+		for ( auto itemID : items )
+		{
+			if ( seen.contains( itemID ) )
+				continue;
+			seen.insert( itemID );
+
+			auto item = getItem( itemID );
+			if ( item )
+			{
+				loose.push_back( { item->distanceSquare( pos ), itemID } );
+			}
+		}
+	};
+
 	for ( const auto& filterItem : filter )
 	{
-		itemSID     = filterItem.first;
-		materialSID = filterItem.second;
+		unsigned short itemUID     = 0;
+		unsigned short materialUID = 0;
+		if ( !resolveUIDs( filterItem.first, filterItem.second, itemUID, materialUID ) )
+		{
+			continue;
+		}
+		const auto keys = keysFor( itemUID, materialUID );
 
-		QList<unsigned int> items;
-		if ( materialSID == "any" )
+		for ( auto key : keys )
 		{
-			for ( auto material : m_octrees[itemSID].keys() )
+			auto looseIt = m_looseItems.constFind( key );
+			if ( looseIt != m_looseItems.constEnd() )
 			{
-				Octree* ot = octree( itemSID, material );
-				items += ot->query( pos.x, pos.y, pos.z );
+				addLoose( looseIt.value() );
 			}
 		}
-		else
+
+		if ( !allowInStockpile )
 		{
-			Octree* ot = octree( itemSID, materialSID );
+			continue;
+		}
+
+		QList<unsigned int> items;
+		for ( auto key : keys )
+		{
+			Octree* ot = octree( key >> 16, key & 0xffff );
 			items += ot->query( pos.x, pos.y, pos.z );
 		}
 
 		for ( auto itemID : items )
 		{
-			if ( seen.contains( itemID ) )
-				continue;
-			seen.insert( itemID );
-
 			auto item = getItem( itemID );
-
-			if ( item && item->isFree() )
+			// item is in another stockpile so we need to check if the source stockpile allows pulling from it
+			if ( item && item->isFree() && item->isInStockpile() && item->isInStockpile() != stockpileID && !seen.contains( itemID ) )
 			{
-				if ( item->isInStockpile() == stockpileID )
-				{
-					//item is in this stockpile
-				}
-				else if ( !item->isInStockpile() )
+				seen.insert( itemID );
+				if ( g->m_spm->hasPriority( stockpileID, item->isInStockpile() ) && g->m_spm->allowsPull( item->isInStockpile() ) )
 				{
-					//item isnt in stockpile
-					out.append( itemID );
-				}
-				else
-				{
-					// item is in stockpile so we need to check if we can pull from stockpiles and if the source stockpile allows it
-					if ( allowInStockpile && g->m_spm->hasPriority( stockpileID, item->isInStockpile() ) && g->m_spm->allowsPull( item->isInStockpile() ) )
-					{
-						out.append( itemID );
-					}
+					pulled.append( itemID );
 				}
 			}
 		}
 	}
+
+	std::sort( loose.begin(), loose.end() );
+
+	QList<unsigned int> out;
+	out.reserve( (int)loose.size() + pulled.size() );
+	for ( const auto& entry : loose )
+	{
+		out.append( entry.second );
+	}
+	out.append( pulled );
+	return out;
+}
+
+/** @brief Add or remove an item from the loose item index according to its current state.
+ *
+ *  An item is loose when it lies on the ground, is not claimed and is in no stockpile.
+ *  Items entering the index are also queued for takeNewLooseItems().
+ *
+ *  @param item The item whose state changed.
+ */
+void Inventory::updateLooseItem( Item* item )
+{
+	auto& items = m_looseItems[itemKey( item->itemUID(), item->materialUID() )];
+	if ( item->isFree() && !item->isInStockpile() )
+	{
+		if ( !items.contains( item->id() ) )
+		{
+			items.insert( item->id() );
+			m_newLooseItems.append( item->id() );
+		}
+	}
+	else
+	{
+		items.remove( item->id() );
+	}
+}
+
+/** @brief Return the items that became loose since the last call and clear the queue.
+ *  @return Item IDs, an item may already be gone or claimed again.
+ */
+QList<unsigned int> Inventory::takeNewLooseItems()
+{
+	QList<unsigned int> out;
+	out.swap( m_newLooseItems );
 	return out;
 }
 
@@ -787,17 +1048,20 @@ QList<unsigned int> Inventory::tradeInventory( QString itemSID, QString material
 {
 	QList<unsigned int> out;
 
-	if ( m_hash.contains( itemSID ) )
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
 	{
-		if ( !m_hash[itemSID].empty() )
+		return out;
+	}
+	for ( auto key : keysFor( itemUID, materialUID ) )
+	{
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto id : m_hash[itemSID][materialSID] )
+			auto item = getItem( id );
+			if ( item && item->isInStockpile() && item->isFree() )
 			{
-				auto item = getItem( id );
-				if ( item && item->isInStockpile() && item->isFree() )
-				{
-					out.append( id );
-				}
+				out.append( id );
 			}
 		}
 	}
@@ -809,17 +1073,20 @@ QList<unsigned int> Inventory::tradeInventory( QString itemSID, QString material
 {
 	QList<unsigned int> out;
 
-	if ( m_hash.contains( itemSID ) )
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return out;
+	}
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		if ( !m_hash[itemSID].empty() )
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto id : m_hash[itemSID][materialSID] )
+			auto item = getItem( id );
+			if ( item && item->isInStockpile() && item->isFree() && item->quality() == quality )
 			{
-				auto item = getItem( id );
-				if ( item && item->isInStockpile() && item->isFree() && item->quality() == quality )
-				{
-					out.append( id );
-				}
+				out.append( id );
 			}
 		}
 	}
@@ -877,6 +1144,7 @@ unsigned int Inventory::pickUpItem( unsigned int id, unsigned int creatureID )
 	auto item = getItem( id );
 	if ( item )
 	{
+		countItem( item, -1 );
 		item->setHeldBy( creatureID );
 		m_byLocationOwner[creatureID].insert( id );
 
@@ -890,6 +1158,8 @@ unsigned int Inventory::pickUpItem( unsigned int id, unsigned int creatureID )
 		}
 
 		item->setInContainer( 0 );
+		updateLooseItem( item );
+		countItem( item, 1 );
 
 		const Position& pos = item->getPos();
 		if ( m_positionHash.contains( pos.toInt() ) )
@@ -901,7 +1171,7 @@ unsigned int Inventory::pickUpItem( unsigned int id, unsigned int creatureID )
 			m_positionHash.remove( pos.toInt() );
 		}
 
-		Octree* ot = octree( item->itemSID(), item->materialSID() );
+		Octree* ot = octree( item->itemUID(), item->materialUID() );
 		ot->removeItem( pos.x, pos.y, pos.z, item->id() );
 
 		unsigned int nextItemID = getFirstObjectAtPosition( pos );
@@ -931,7 +1201,10 @@ unsigned int Inventory::putDownItem( unsigned int id, const Position& newPos )
 		{
 			m_byLocationOwner[oldOwner].remove( id );
 		}
+		countItem( item, -1 );
 		item->setHeldBy( 0 );
+		updateLooseItem( item );
+		countItem( item, 1 );
 		if ( m_positionHash.contains( newPos.toInt() ) )
 		{
 			m_positionHash[newPos.toInt()].insert( id );
@@ -943,7 +1216,7 @@ unsigned int Inventory::putDownItem( unsigned int id, const Position& newPos )
 			m_positionHash.insert( newPos.toInt(), entry );
 		}
 
-		Octree* ot = octree( item->itemSID(), item->materialSID() );
+		Octree* ot = octree( item->itemUID(), item->materialUID() );
 		ot->insertItem( newPos.x, newPos.y, newPos.z, item->id() );
 
 		// set new position
@@ -1001,9 +1274,10 @@ QList<QString> Inventory::items( QString category, QString group )
 
 QList<QString> Inventory::materials( QString category, QString group, QString item )
 {
-	if ( m_hash.contains( item ) )
+	auto it = m_catalog.constFind( item );
+	if ( it != m_catalog.constEnd() )
 	{
-		return m_hash[item].keys();
+		return it.value().values();
 	}
 	return QList<QString>();
 }
@@ -1031,267 +1305,243 @@ QMap<QString, int> Inventory::materialCountsForItem( QString itemSID, bool allow
 
 	mats.insert( "any", 0 );
 
-	if ( m_hash.contains( itemSID ) )
+	for ( const auto& mk : m_catalog.value( itemSID ) )
 	{
-		QList<QString> matKeys = m_hash[itemSID].keys();
-		for ( auto mk : matKeys )
-		{
-			mats.insert( mk, 0 );
-		}
-		if ( !m_hash[itemSID].empty() )
+		mats.insert( mk, 0 );
+	}
+
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, "any", itemUID, materialUID ) )
+	{
+		return mats;
+	}
+	for ( auto key : keysFor( itemUID, anyMaterial ) )
+	{
+		int count = 0;
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto it : m_hash[itemSID] )
+			auto item = getItem( id );
+			if ( item && ( !item->isInJob() || allowInJob ) && ( item->isHeldBy() == 0 ) )
 			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( item && ( !item->isInJob() || allowInJob ) && ( item->isHeldBy() == 0 ) )
-					{
-						mats["any"]++;
-						if ( mats.contains( item->materialSID() ) )
-						{
-							mats[item->materialSID()]++;
-						}
-						else
-						{
-							mats.insert( item->materialSID(), 1 );
-						}
-					}
-				}
+				++count;
 			}
 		}
+		if ( count )
+		{
+			mats["any"] += count;
+			mats[DBH::materialSID( key & 0xffff )] += count;
+		}
 	}
 	return mats;
 }
 
 unsigned int Inventory::itemCount( QString itemID, QString materialID )
 {
-	unsigned int result = 0;
-
-	if ( materialID == "any" )
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemID, materialID, itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) )
-		{
-			for ( auto it : m_hash[itemID] )
-			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( item && item->isFree() )
-					{
-						++result;
-					}
-				}
-			}
-		}
+		return 0;
 	}
-	else
+	return itemCount( itemUID, materialUID );
+}
+
+unsigned int Inventory::itemCount( unsigned short itemUID, unsigned short materialUID )
+{
+	unsigned int result = 0;
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) && m_hash[itemID].contains( materialID ) )
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto id : m_hash[itemID][materialID] )
+			auto item = getItem( id );
+			if ( item && item->isFree() )
 			{
-				auto item = getItem( id );
-				if ( item && item->isFree() )
-				{
-					++result;
-				}
+				++result;
 			}
 		}
 	}
-
 	return result;
 }
 
 unsigned int Inventory::itemCountWithInJob( QString itemID, QString materialID )
 {
-	unsigned int result = 0;
+	return itemCountDetailed( itemID, materialID ).total;
+}
 
-	if ( materialID == "any" )
+unsigned int Inventory::itemCountInStockpile( QString itemID, QString materialID )
+{
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemID, materialID, itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) )
-		{
-			for ( auto it : m_hash[itemID] )
-			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( item )
-					{
-						++result;
-					}
-				}
-			}
-		}
+		return 0;
 	}
-	else
+
+	unsigned int result = 0;
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) && m_hash[itemID].contains( materialID ) )
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto id : m_hash[itemID][materialID] )
+			auto item = getItem( id );
+			if ( item && item->isInStockpile() && item->isFree() )
 			{
-				auto item = getItem( id );
-				if ( item )
-				{
-					++result;
-				}
+				++result;
 			}
 		}
 	}
-
 	return result;
 }
 
-unsigned int Inventory::itemCountInStockpile( QString itemID, QString materialID )
+unsigned int Inventory::itemCountNotInStockpile( QString itemID, QString materialID )
 {
-	unsigned int result = 0;
-
-	if ( materialID == "any" )
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemID, materialID, itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) )
-		{
-			for ( auto it : m_hash[itemID] )
-			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( item && item->isInStockpile() && item->isFree() )
-					{
-						++result;
-					}
-				}
-			}
-		}
+		return 0;
 	}
-	else
+
+	unsigned int result = 0;
+	for ( auto key : keysFor( itemUID, materialUID ) )
 	{
-		if ( m_hash.contains( itemID ) && m_hash[itemID].contains( materialID ) )
+		for ( auto id : m_hash.value( key ) )
 		{
-			for ( auto id : m_hash[itemID][materialID] )
+			auto item = getItem( id );
+			if ( item && !item->isInStockpile() && item->isFree() )
 			{
-				auto item = getItem( id );
-				if ( item && item->isInStockpile() && item->isFree() )
-				{
-					result++;
-				}
+				++result;
 			}
 		}
 	}
-
 	return result;
 }
 
-unsigned int Inventory::itemCountNotInStockpile( QString itemID, QString materialID )
+/** @brief Stock counters of one item type, read from the incrementally maintained totals.
+ *  @param itemID Item type string ID.
+ *  @param materialID Material string ID or "any" for the sum over all materials.
+ *  @return The counters, all zero if no such item exists.
+ */
+Inventory::ItemCountDetailed Inventory::itemCountDetailed( QString itemID, QString materialID )
 {
-	unsigned int result = 0;
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemID, materialID, itemUID, materialUID ) )
+	{
+		return { 0, 0, 0, 0, 0, 0, 0 };
+	}
+	return itemCountDetailed( itemUID, materialUID );
+}
+
+Inventory::ItemCountDetailed Inventory::itemCountDetailed( unsigned short itemUID, unsigned short materialUID )
+{
+	ItemCountDetailed result = { 0, 0, 0, 0, 0, 0, 0 };
 
-	if ( materialID == "any" )
+	if ( materialUID != anyMaterial )
 	{
-		if ( m_hash.contains( itemID ) )
-		{
-			for ( auto it : m_hash[itemID] )
-			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( item && !item->isInStockpile() && item->isFree() )
-					{
-						++result;
-					}
-				}
-			}
-		}
+		return m_counts.value( itemKey( itemUID, materialUID ), result );
 	}
-	else
+	for ( auto key : keysFor( itemUID, anyMaterial ) )
 	{
-		if ( m_hash.contains( itemID ) && m_hash[itemID].contains( materialID ) )
+		auto it = m_counts.constFind( key );
+		if ( it == m_counts.constEnd() )
 		{
-			for ( auto id : m_hash[itemID][materialID] )
-			{
-				auto item = getItem( id );
-				if ( item && item->materialSID() == materialID && !item->isInStockpile() && item->isFree() )
-				{
-					result++;
-				}
-			}
+			continue;
 		}
+		const auto& count = it.value();
+		result.total += count.total;
+		result.inJob += count.inJob;
+		result.inStockpile += count.inStockpile;
+		result.equipped += count.equipped;
+		result.constructed += count.constructed;
+		result.loose += count.loose;
+		result.totalValue += count.totalValue;
 	}
-
 	return result;
 }
 
-Inventory::ItemCountDetailed Inventory::itemCountDetailed( QString itemID, QString materialID )
+/** @brief Add or remove the contribution of one item to the counters of its type and material.
+ *
+ *  Every state change of an item is wrapped in countItem( item, -1 ) and countItem( item, 1 ),
+ *  so the counters always match a full recount. The touched type is queued for takeChangedCounts().
+ *
+ *  @param item The item.
+ *  @param sign 1 to add the item, -1 to remove it.
+ */
+void Inventory::countItem( Item* item, int sign )
 {
-	ItemCountDetailed result = { 0, 0, 0, 0, 0, 0, 0 };
+	const quint32 key = itemKey( item->itemUID(), item->materialUID() );
 
-	if ( materialID == "any" )
+	auto& count = m_counts[key];
+	count.total += sign;
+	if ( item->isHeldBy() != 0 )
 	{
-		if ( m_hash.contains( itemID ) )
-		{
-			for ( auto it : m_hash[itemID] )
-			{
-				for ( auto id : it )
-				{
-					auto item = getItem( id );
-					if ( !item ) continue;
-
-					result.total++;
-
-					if ( item->isHeldBy() != 0 )
-					{
-						result.equipped++;
-					}
-
-					if ( item->isInStockpile() )
-						result.inStockpile++;
-					else
-						result.loose++;
-
-					if ( item->isInJob() )
-						result.inJob++;
-
-					result.totalValue += item->value();
-				}
-			}
-		}
+		count.equipped += sign;
+	}
+	if ( item->isInStockpile() )
+	{
+		count.inStockpile += sign;
 	}
 	else
 	{
-		if ( m_hash.contains( itemID ) && m_hash[itemID].contains( materialID ) )
-		{
-			for ( auto id : m_hash[itemID][materialID] )
-			{
-				auto item = getItem( id );
-				if ( !item ) continue;
-
-				result.total++;
+		count.loose += sign;
+	}
+	if ( item->isInJob() )
+	{
+		count.inJob += sign;
+	}
+	count.totalValue += sign * (int)item->value();
 
-				if ( item->isHeldBy() != 0 )
-				{
-					result.equipped++;
-				}
-				if ( false ) // isConstructed removed
-				{
-					result.constructed++;
-				}
-				else if ( item->isInStockpile() )
-					result.inStockpile++;
-				else
-					result.loose++;
+	m_changedCounts.insert( key );
 
-				if ( item->isInJob() )
-					result.inJob++;
+	++m_stockRevision;
+	m_itemRevisions[item->itemUID()] = m_stockRevision;
+	m_materialRevisions[key]         = m_stockRevision;
+}
 
-				result.totalValue += item->value();
-			}
-		}
+/** @brief Revision of the stock of an item type, changes whenever one of its items is added,
+ *         removed, claimed, released, picked up, put down or moved into or out of a stockpile.
+ *
+ *  Callers that derive something from the stock can keep the revision and skip their work
+ *  while it stays the same.
+ *
+ *  @param itemSID Item type string ID.
+ *  @param materialSID Material string ID or "any" for all materials of the item type.
+ *  @return The revision, 0 if no item of that kind ever existed.
+ */
+quint64 Inventory::stockRevision( const QString& itemSID, const QString& materialSID ) const
+{
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
+	if ( !resolveUIDs( itemSID, materialSID, itemUID, materialUID ) )
+	{
+		return 0;
 	}
+	return stockRevision( itemUID, materialUID );
+}
 
-	return result;
-
-	return ItemCountDetailed();
+quint64 Inventory::stockRevision( unsigned short itemUID, unsigned short materialUID ) const
+{
+	if ( materialUID == anyMaterial )
+	{
+		return m_itemRevisions.value( itemUID );
+	}
+	return m_materialRevisions.value( itemKey( itemUID, materialUID ) );
 }
 
+/** @brief Return the item type and material pairs whose counters changed since the last call.
+ *  @return The changed pairs, the internal set is cleared.
+ */
+QSet<QPair<QString, QString>> Inventory::takeChangedCounts()
+{
+	QSet<QPair<QString, QString>> out;
+	for ( auto key : m_changedCounts )
+	{
+		out.insert( QPair<QString, QString>( DBH::itemSID( key >> 16 ), DBH::materialSID( key & 0xffff ) ) );
+	}
+	m_changedCounts.clear();
+	return out;
+}
 
 unsigned int Inventory::isInStockpile( unsigned int id )
 {
@@ -1308,11 +1558,14 @@ void Inventory::setInStockpile( unsigned int id, unsigned int stockpile )
 	auto item = getItem( id );
 	if ( item )
 	{
+		countItem( item, -1 );
 		item->setInStockpile( stockpile );
 		if ( stockpile )
 		{
 			addToWealth( item );
 		}
+		updateLooseItem( item );
+		countItem( item, 1 );
 	}
 }
 
@@ -1337,11 +1590,14 @@ void Inventory::setInJob( unsigned int id, unsigned int job )
 		{
 			m_byClaimOwner[oldJob].remove( id );
 		}
+		countItem( item, -1 );
 		item->setInJob( job );
 		if ( job != 0 )
 		{
 			m_byClaimOwner[job].insert( id );
 		}
+		updateLooseItem( item );
+		countItem( item, 1 );
 	}
 }
 
@@ -1390,6 +1646,7 @@ void Inventory::setIsUsedBy( unsigned int id, unsigned int creatureID )
 		{
 			m_byClaimOwner[creatureID].insert( id );
 		}
+		updateLooseItem( item );
 	}
 }
 
@@ -1408,7 +1665,9 @@ void Inventory::setValue( unsigned int id, unsigned int value )
 	auto item = getItem( id );
 	if ( item )
 	{
+		countItem( item, -1 );
 		item->setValue( value );
+		countItem( item, 1 );
 	}
 }
 
@@ -1427,7 +1686,9 @@ void Inventory::setQuality( unsigned int id, unsigned char quality )
 	auto item = getItem( id );
 	if ( item )
 	{
+		countItem( item, -1 );
 		item->setQuality( quality );
+		countItem( item, 1 );
 	}
 }
 
@@ -1744,8 +2005,11 @@ void Inventory::freeAllClaimedBy( unsigned int ownerID )
 			auto item = getItem( itemID );
 			if ( item )
 			{
+				countItem( item, -1 );
 				item->setInJob( 0 );
 				item->setUsedBy( 0 );
+				updateLooseItem( item );
+				countItem( item, 1 );
 			}
 		}
 		m_byClaimOwner.remove( ownerID );
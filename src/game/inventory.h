@@ -24,6 +24,7 @@
 
 
 #include "../base/priorityqueue.h"
+#include "../base/slab.h"
 #include "../game/item.h"
 
 #include <QHash>
@@ -31,6 +32,8 @@
 #include <QMap>
 #include <QString>
 
+#include <vector>
+
 /** @brief Set of item IDs at a single tile position. */
 typedef QSet<unsigned int> PositionEntry;
 /** @brief Hash from tile position integer to the set of item IDs at that position. */
@@ -57,6 +60,15 @@ class Inventory : public QObject
 	Inventory( Game* parent );
 	~Inventory();
 
+	/// @brief Material UID that matches every material in the UID based queries, like "any" does for strings.
+	static constexpr unsigned short anyMaterial = 0xffff;
+
+	/// @brief Packs an item UID and a material UID into the key used by the item indices.
+	static quint32 itemKey( unsigned short itemUID, unsigned short materialUID )
+	{
+		return (quint32)itemUID << 16 | materialUID;
+	}
+
 	void saveFilter();
 	void loadFilter();
 
@@ -66,6 +78,8 @@ class Inventory : public QObject
 	unsigned int createItem( Position pos, QString itemSID, QList<unsigned int> components );
 	unsigned int createItem( Position pos, QString itemSID, QVariantList components );
 	unsigned int createItem( const QVariantMap& values );
+	unsigned int loadItem( Item& obj );
+	int loadItems( std::vector<Item>& items );
 
 	void destroyObject( unsigned int id );
 
@@ -73,6 +87,7 @@ class Inventory : public QObject
 	bool getObjectsAtPosition( const Position& pos, PositionEntry& pe );
 
 	unsigned int getClosestItem( const Position& pos, bool allowInStockpile, QString itemID, QString materialID = "any" );
+	unsigned int getClosestItem( const Position& pos, bool allowInStockpile, unsigned short itemUID, unsigned short materialUID );
 	//from construction dialog with materialTypes selected any
 	unsigned int getClosestItem2( const Position& pos, bool allowInStockpile, QString itemID, QSet<QString> materialTypes );
 	unsigned int getItemAtPos( const Position& pos, bool allowInStockpile, QString itemID, QString materialID = "any" );
@@ -83,8 +98,11 @@ class Inventory : public QObject
 	* get closest items with connected region check
 	*/
 	QList<unsigned int> getClosestItems( const Position& pos, bool allowInStockpile, QString itemSID, QString materialSID, int count );
+	QList<unsigned int> getClosestItems( const Position& pos, bool allowInStockpile, unsigned short itemUID, unsigned short materialUID, int count );
 	bool checkReachableItems( Position pos, bool allowInStockpile, int count, QString itemSID, QString materialSID = "any" );
+	bool checkReachableItems( const Position& pos, bool allowInStockpile, int count, unsigned short itemUID, unsigned short materialUID );
 	QList<unsigned int> getClosestItemsForStockpile( unsigned int stockpileID, Position& pos, bool allowInStockpile, QSet<QPair<QString, QString>> filter );
+	QList<unsigned int> takeNewLooseItems();
 
 	unsigned int getFoodItem( Position& pos );
 	unsigned int getDrinkItem( Position& pos );
@@ -108,6 +126,7 @@ class Inventory : public QObject
 
 	QMap<QString, int> materialCountsForItem( QString itemID, bool allowInJob = false );
 	unsigned int itemCount( QString itemID, QString materialID );
+	unsigned int itemCount( unsigned short itemUID, unsigned short materialUID );
 	unsigned int itemCountWithInJob( QString itemID, QString materialID );
 	unsigned int itemCountInStockpile( QString itemID, QString materialID );
 	unsigned int itemCountNotInStockpile( QString itemID, QString materialID );
@@ -124,6 +143,15 @@ class Inventory : public QObject
 		unsigned int totalValue;
 	};
 	ItemCountDetailed itemCountDetailed( QString itemID, QString materialID );
+	ItemCountDetailed itemCountDetailed( unsigned short itemUID, unsigned short materialUID );
+	QSet<QPair<QString, QString>> takeChangedCounts();
+	quint64 stockRevision( const QString& itemSID, const QString& materialSID ) const;
+	quint64 stockRevision( unsigned short itemUID, unsigned short materialUID ) const;
+	/** @brief Revision of the whole stock, changes whenever any item is counted differently. */
+	quint64 stockRevision() const
+	{
+		return m_stockRevision;
+	}
 
 
 
@@ -175,7 +203,7 @@ class Inventory : public QObject
 
 	int countItemsAtPos( Position& pos );
 
-	QHash<unsigned int, Item>& allItems()
+	Slab<Item>& allItems()
 	{
 		return m_items;
 	}
@@ -224,17 +252,35 @@ class Inventory : public QObject
 
 	QPointer<ItemHistory> m_itemHistory;
 
-	Octree* octree( const QString& itemSID, const QString& materialSID );
+	Octree* octree( unsigned short itemUID, unsigned short materialUID );
+	static bool resolveUIDs( const QString& itemSID, const QString& materialSID, unsigned short& itemUID, unsigned short& materialUID );
+	QList<quint32> keysFor( unsigned short itemUID, unsigned short materialUID ) const;
 
 	int m_dimX;
 	int m_dimY;
 	int m_dimZ;
 
-	QHash<unsigned int, Item> m_items;
+	Slab<Item> m_items;        // item storage, chunked so items don't move
+	SlabIndex m_itemHandles;   // item ID → handle into m_items
 
 	PositionHash m_positionHash;
-	QHash<QString, QHash<QString, QSet<unsigned int>>> m_hash;
-	QHash<QString, QHash<QString, Octree*>> m_octrees;
+	// All item indices are keyed by itemKey( itemUID, materialUID )
+	QHash<quint32, QSet<unsigned int>> m_hash;
+	// Material UIDs per item UID that have an octree, resolves "any" queries
+	QHash<unsigned short, QList<unsigned short>> m_materialsOfItem;
+	// itemSID → materialSIDs shown in the stock overview and saved as item filter
+	QHash<QString, QSet<QString>> m_catalog;
+	// Items on the ground that are in no stockpile and not claimed
+	QHash<quint32, QSet<unsigned int>> m_looseItems;
+	QList<unsigned int> m_newLooseItems; // items that became loose since the last takeNewLooseItems()
+	// Stock counters, kept in sync by countItem()
+	QHash<quint32, ItemCountDetailed> m_counts;
+	QSet<quint32> m_changedCounts; // counters changed since the last takeChangedCounts()
+	// Stock revisions for stockRevision(), all taken from one running counter
+	quint64 m_stockRevision = 0;
+	QHash<unsigned short, quint64> m_itemRevisions;
+	QHash<quint32, quint64> m_materialRevisions;
+	QHash<quint32, Octree*> m_octrees;
 
 	// Ownership indices for bulk cleanup
 	QHash<unsigned int, QSet<unsigned int>> m_byClaimOwner;    // jobID/creatureID → itemIDs
@@ -252,7 +298,12 @@ class Inventory : public QObject
 	QMap<unsigned int, unsigned char> m_foodItems;
 	QMap<unsigned int, unsigned char> m_drinkItems;
 
+	bool createLoadedSprite( Item& obj );
+	Item* storeObject( const Item& object );
 	void addObject( Item& object, const QString& itemID, const QString& materialID );
+	void indexObject( Item* item, const QString& itemID, const QString& materialID );
+	void updateLooseItem( Item* item );
+	void countItem( Item* item, int sign );
 	void init();
 
 	Item* getItem( unsigned int itemUID );
@@ -109,6 +109,81 @@ Item::Item( QVariantMap in ) :
 	}
 }
 
+/** @brief Tags of the binary item record fields that are not part of the schema. */
+enum ItemExtraTag : quint8
+{
+	IT_EXTRA      = 20,
+	IT_EATVALUE   = 21,
+	IT_DRINKVALUE = 22,
+	IT_COMPONENT  = 23 ///< Repeated, item UID in the low and material UID in the high 32 bits.
+};
+
+/** @brief Fields of the binary item record. Tags of dropped fields must not be reused. */
+auto Item::schema()
+{
+	return std::make_tuple(
+		Schema::field( 1, "ID", &Item::m_id ),
+		Schema::field( 2, "Position", &Item::m_position ),
+		Schema::field( 3, "SpriteID", &Item::m_spriteID ),
+		Schema::field( 4, "ItemUID", &Item::m_itemUID ),
+		Schema::field( 5, "MaterialUID", &Item::m_materialUID ),
+		Schema::field( 6, "StockpileID", &Item::m_stockpileID ),
+		Schema::field( 7, "ContainerID", &Item::m_containerID ),
+		Schema::field( 8, "Location", &Item::m_location ),
+		Schema::field( 9, "LocationOwner", &Item::m_locationOwner ),
+		Schema::field( 10, "Claim", &Item::m_claim ),
+		Schema::field( 11, "ClaimOwner", &Item::m_claimOwner ),
+		Schema::field( 12, "Value", &Item::m_value ),
+		Schema::field( 13, "MadeBy", &Item::m_madeBy ),
+		Schema::field( 14, "Quality", &Item::m_quality ) );
+}
+
+/** @brief Deserialize an item from a binary save record.
+ *
+ *  Item and material UIDs are stored as they are, the save game's own
+ *  UID tables are loaded before the items.
+ *
+ *  @param in Reader positioned at the first field of the record.
+ */
+Item::Item( Schema::Reader& in ) :
+	Object()
+{
+	m_id       = 0;
+	m_spriteID = 0;
+
+	while ( quint32 key = in.next() )
+	{
+		if ( in.field( key, *this, schema() ) )
+		{
+			continue;
+		}
+		if ( ( key & 1 ) != Schema::Varint )
+		{
+			in.skip( key );
+			continue;
+		}
+		const quint64 value = in.varint();
+		switch ( Schema::Reader::tag( key ) )
+		{
+			case IT_EXTRA:
+				extraData();
+				break;
+			case IT_EATVALUE:
+				extraData()->nutritionalValue = value;
+				break;
+			case IT_DRINKVALUE:
+				extraData()->drinkValue = value;
+				break;
+			case IT_COMPONENT:
+				extraData()->components.append( { (unsigned int)( value & 0xffffffff ), (unsigned int)( value >> 32 ) } );
+				break;
+			default:
+				// field of a newer version
+				break;
+		}
+	}
+}
+
 /** @brief Copy constructor. Deep-copies extra data if present.
  *  @param other Item to copy from.
  */
@@ -195,6 +270,36 @@ QVariant Item::serialize() const
 	return out;
 }
 
+/** @brief Write the item as a binary save record, see Item( Schema::Reader& ).
+ *  @param out Writer for the record.
+ */
+void Item::serialize( Schema::Writer& out ) const
+{
+	out.fields( *this, schema() );
+
+	if ( m_extraData != nullptr )
+	{
+		out.uint( IT_EXTRA, 1 );
+		out.uint( IT_EATVALUE, m_extraData->nutritionalValue );
+		out.uint( IT_DRINKVALUE, m_extraData->drinkValue );
+
+		for ( const auto& comp : m_extraData->components )
+		{
+			out.uint( IT_COMPONENT, comp.itemUID | (quint64)comp.materialUID << 32 );
+		}
+	}
+}
+
+/** @brief Extra data of the item, created on first use. */
+ItemExtraData* Item::extraData()
+{
+	if ( m_extraData == nullptr )
+	{
+		m_extraData = new ItemExtraData;
+	}
+	return m_extraData;
+}
+
 /** @brief Return the material database UID.
  *  @return Material UID.
  */
@@ -224,7 +329,7 @@ QString Item::getPixmapSID() const
  */
 QString Item::getDesignation() const
 {
-	return S::s( "$MaterialName_" + DBH::materialSID( m_materialUID ) ) + " " + S::s( "$ItemName_" + DBH::itemSID( m_itemUID ) );
+	return S::designation( m_itemUID, m_materialUID );
 }
 
 /** @brief Return the item type string ID (DB key).
@@ -23,6 +23,8 @@
 
 #include "object.h"
 
+#include "../base/schema.h"
+
 /** @brief Where the item physically exists in the world. */
 enum class ItemLocation : uint8_t
 {
@@ -71,10 +73,12 @@ class Item : public Object
 	Item();
 	Item( Position& pos, QString itemSID, QString materialSID );
 	Item( QVariantMap in );
+	Item( Schema::Reader& in );
 	Item( const Item& other );
 	~Item();
 
 	virtual QVariant serialize() const;
+	void serialize( Schema::Writer& out ) const;
 
 	unsigned short materialUID() const;
 	unsigned short itemUID() const;
@@ -129,6 +133,9 @@ class Item : public Object
 	void setColor( QString color );
 
 private:
+	static auto schema();
+	ItemExtraData* extraData();
+
 	unsigned short m_materialUID = 0;
 	unsigned short m_itemUID     = 0;
 
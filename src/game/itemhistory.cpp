@@ -22,6 +22,7 @@
 
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 
 #include <QDebug>
 
@@ -441,8 +442,8 @@ QMap<QString, QVector<IH_values>> ItemHistory::getRandomHistory( QString itemSID
 		int total = 0;
 		for ( int i = 0; i < 20; ++i )
 		{
-			int plus  = rand() % 20;
-			int minus = qMin( total, rand() % 20 );
+			int plus  = RNG::rand( RngStream::Items ) % 20;
+			int minus = qMin( total, RNG::rand( RngStream::Items ) % 20 );
 			total += plus - minus;
 
 			IH_values mv { total, plus, minus };
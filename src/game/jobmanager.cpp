@@ -31,6 +31,7 @@
 #include "../game/gnomemanager.h"
 #include "../game/inventory.h"
 #include "../game/mechanismmanager.h"
+#include "../game/replay.h"
 #include "../game/stockpilemanager.h"
 #include "../game/workshopmanager.h"
 #include "../game/world.h"
@@ -182,7 +183,7 @@ void JobManager::onTick()
 			}
 		}
 
-		if ( timer.elapsed() > 3 )
+		if ( timer.elapsed() > 3 && !Replay::active() )
 		{
 			break;
 		}
@@ -317,6 +318,17 @@ bool JobManager::insertIntoPositionHash( unsigned int jobID )
 	return true;
 }
 
+/** @brief Tells the owner of a job that was just removed from the job list, so it can
+ *         create a follow-up job. Only automaton maintenance jobs need that so far.
+ *  @param job The removed job. */
+void JobManager::onJobRemoved( const QSharedPointer<Job>& job )
+{
+	if ( job->automaton() )
+	{
+		g->gm()->wakeAutomaton( job->automaton() );
+	}
+}
+
 /** @brief Removes a job from the position lookup hash.
  *  @param jobID ID of the job to remove. */
 void JobManager::removeFromPositionHash( unsigned int jobID )
@@ -571,7 +583,8 @@ unsigned int JobManager::getJob( QStringList skills, unsigned int gnomeID, Posit
 				if ( m_jobsPerType.contains( "HaulToSite" ) )
 				{
 					auto& haulJobs = m_jobsPerType["HaulToSite"];
-					unsigned int regionID = g->w()->regionMap().regionID( gnomePos );
+					RegionMap& regionMap              = g->w()->regionMap();
+					const unsigned int gnomeComponent = regionMap.componentID( gnomePos );
 					for ( auto it = haulJobs.begin(); it != haulJobs.end(); ++it )
 					{
 						auto job = m_jobList.value( it.value() );
@@ -582,8 +595,7 @@ unsigned int JobManager::getJob( QStringList skills, unsigned int gnomeID, Posit
 							if ( !items.isEmpty() && g->inv()->itemExists( items.first() ) )
 							{
 								Position itemPos = g->inv()->getItemPos( items.first() );
-								unsigned int itemRegion = g->w()->regionMap().regionID( itemPos );
-								if ( g->w()->regionMap().checkConnectedRegions( regionID, itemRegion ) )
+								if ( regionMap.componentID( itemPos ) == gnomeComponent )
 								{
 									return job->id();
 								}
@@ -840,22 +852,30 @@ bool JobManager::isReachable( unsigned int jobID, unsigned int regionID )
 		// jobs on same tile
 		auto wpl = job->origWorkPosOffsets();
 		//qDebug() << "### get staging for " << pos.toString();
+		std::vector<Position> candidates;
 		for ( const auto& offset : wpl )
 		{
 			Position testPos( pos + offset );
 			if ( g->w()->isWalkable( testPos ) )
 			{
-				if ( regionID == 0 )
-				{
-					job->addPossibleWorkPosition( testPos );
-				}
-				else
+				candidates.push_back( testPos );
+			}
+		}
+		if ( regionID == 0 )
+		{
+			for ( const auto& testPos : candidates )
+			{
+				job->addPossibleWorkPosition( testPos );
+			}
+		}
+		else
+		{
+			const auto connected = g->w()->regionMap().checkConnectedRegions( regionID, candidates );
+			for ( size_t i = 0; i < candidates.size(); ++i )
+			{
+				if ( connected[i] )
 				{
-					unsigned int workRegionID = g->w()->regionMap().regionID( testPos );
-					if ( g->w()->regionMap().checkConnectedRegions( regionID, workRegionID ) )
-					{
-						job->addPossibleWorkPosition( testPos );
-					}
+					job->addPossibleWorkPosition( candidates[i] );
 				}
 			}
 		}
@@ -907,6 +927,7 @@ void JobManager::finishJob( unsigned int jobID )
 			mtype.remove( job->priority(), jobID );
 		}
 		m_jobList.remove( jobID );
+		onJobRemoved( job );
 	}
 
 	if ( g->spm()->finishJob( jobID ) )
@@ -1192,6 +1213,7 @@ void JobManager::cancelJob( const Position& pos )
 				type.remove( job->priority(), jobID );
 			}
 			m_jobList.remove( jobID );
+			onJobRemoved( job );
 		}
 	}
 }
@@ -1227,6 +1249,7 @@ void JobManager::deleteJob( unsigned int jobID )
 				type.remove( job->priority(), jobID );
 			}
 			m_jobList.remove( jobID );
+			onJobRemoved( job );
 		}
 	}
 }
@@ -69,6 +69,7 @@ class JobManager : public QObject
 
 	bool insertIntoPositionHash( unsigned int jobID );
 	void removeFromPositionHash( unsigned int jobID );
+	void onJobRemoved( const QSharedPointer<Job>& job );
 
 	void processJobPhases();
 	bool tryAtomicClaimItems( QSharedPointer<Job> job, QList<unsigned int>& claimedItemIDs );
@@ -35,6 +35,18 @@
 #include <QDebug>
 #include <QQueue>
 
+/** @brief Fuel the engine has left at the current tick.
+ *  @return Remaining fuel in ticks.
+ */
+int MechanismData::fuelLeft() const
+{
+	if ( fuelOutTick == 0 )
+	{
+		return fuel;
+	}
+	return fuelOutTick > GameState::tick ? fuelOutTick - GameState::tick : 0;
+}
+
 /** @brief Serializes this mechanism's data into a QVariantMap for save/load.
  *  @return QVariantMap containing all mechanism properties.
  */
@@ -54,7 +66,7 @@ QVariantMap MechanismData::serialize() const
 	out.insert( "ChangeActive", changeActive );
 	out.insert( "Produce", producePower );
 	out.insert( "Consume", consumePower );
-	out.insert( "Fuel", fuel );
+	out.insert( "Fuel", fuelLeft() );
 	out.insert( "MaxFuel", maxFuel );
 	out.insert( "RFThreshold", refuelThreshold );
 	out.insert( "ConnectsTo", Global::util->positionList2Variant( connectsTo ) );
@@ -115,6 +127,7 @@ MechanismManager::~MechanismManager()
 }
 
 /// @brief Deserialises and installs all mechanisms from saved data, then rebuilds power networks.
+///        Burning engines schedule the tick their fuel runs out again from the saved fuel.
 /// @param data List of QVariantMaps, each produced by MechanismData::serialize().
 void MechanismManager::loadMechanisms( QVariantList data )
 {
@@ -126,12 +139,13 @@ void MechanismManager::loadMechanisms( QVariantList data )
 		md.deserialize( vmd );
 
 		installItem( md );
+		updateBurn( m_mechanisms[md.itemID] );
 	}
 	updateNetWorks();
 }
 
-/// @brief Per-tick update: burns engine fuel, tallies network power balance, propagates hasPower to consumers,
-///        and creates SwitchMechanism/InvertMechanism/Refuel jobs as needed.
+/// @brief Per-tick update: tallies network power balance, propagates hasPower to consumers,
+///        and creates SwitchMechanism/InvertMechanism/Refuel jobs as needed. Fuel burns down on its own, see updateBurn().
 /// @param tickNumber     Current game tick.
 /// @param seasonChanged  Unused.
 /// @param dayChanged     Unused.
@@ -139,13 +153,6 @@ void MechanismManager::loadMechanisms( QVariantList data )
 /// @param minuteChanged  Unused.
 void MechanismManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChanged, bool hourChanged, bool minuteChanged )
 {
-	int tickDiff = 1;
-	if ( m_lastTick != 0 )
-	{
-		tickDiff = tickNumber - m_lastTick;
-	}
-	m_lastTick = tickNumber;
-
 	if ( m_needNetworkUpdate )
 	{
 		updateNetWorks();
@@ -160,18 +167,9 @@ void MechanismManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayC
 			if ( m_mechanisms.contains( itemID ) )
 			{
 				auto& md = m_mechanisms[itemID];
-				if ( md.active && md.fuel > 0 )
+				if ( md.active && md.fuelLeft() > 0 )
 				{
-					md.fuel -= tickDiff;
-					if ( md.fuel > 0 )
-					{
-						network.produce += md.producePower;
-					}
-					else
-					{
-						g->m_world->setWallSpriteAnim( m_mechanisms[itemID].pos, false );
-						m_needNetworkUpdate = true;
-					}
+					network.produce += md.producePower;
 				}
 			}
 		}
@@ -226,7 +224,7 @@ void MechanismManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayC
 					md.job = job;
 				}
 			}
-			else if ( md.active && md.fuel < ( md.maxFuel * md.refuelThreshold / 100 ) )
+			else if ( md.active && md.fuelLeft() < ( md.maxFuel * md.refuelThreshold / 100 ) )
 			{
 				auto jobID = g->jm()->addJob( "Refuel", md.pos, 0, false );
 				auto job = g->jm()->getJob( jobID );
@@ -602,12 +600,14 @@ void MechanismManager::uninstallItem( unsigned int itemID )
 
 /// @brief Returns a copy of the MechanismData for @p itemID, or a default-constructed instance if absent.
 /// @param itemID Mechanism item UID.
-/// @return Copy of the MechanismData.
+/// @return Copy of the MechanismData, with the fuel left at the current tick.
 MechanismData MechanismManager::mechanismData( unsigned int itemID )
 {
 	if ( m_mechanisms.contains( itemID ) )
 	{
-		return m_mechanisms[itemID];
+		MechanismData out = m_mechanisms[itemID];
+		out.fuel          = out.fuelLeft();
+		return out;
 	}
 	return MechanismData();
 }
@@ -640,6 +640,7 @@ void MechanismManager::setActive( unsigned int itemID, bool active )
 		md.active = active;
 
 		setConnectsTo( md );
+		updateBurn( md );
 
 		if( md.maxFuel > 0 )
 		{
@@ -752,11 +753,13 @@ void MechanismManager::refuel( unsigned int itemID, int burnValue )
 {
 	if ( m_mechanisms.contains( itemID ) )
 	{
-		int currentFuel = m_mechanisms[itemID].fuel;
+		int currentFuel = m_mechanisms[itemID].fuelLeft();
 
 		int newFuel = qMin( m_mechanisms[itemID].maxFuel, currentFuel + burnValue );
 
-		m_mechanisms[itemID].fuel = newFuel;
+		m_mechanisms[itemID].fuel        = newFuel;
+		m_mechanisms[itemID].fuelOutTick = 0;
+		updateBurn( m_mechanisms[itemID] );
 
 		if ( currentFuel == 0 )
 		{
@@ -770,6 +773,40 @@ void MechanismManager::refuel( unsigned int itemID, int burnValue )
 	}
 }
 
+/// @brief Starts or stops burning fuel after the active state or the fuel of an engine changed.
+///        A burning engine wakes up through Game::schedule() on the tick its fuel runs out.
+/// @param md Mechanism to update in-place.
+void MechanismManager::updateBurn( MechanismData& md )
+{
+	md.fuel        = md.fuelLeft();
+	md.fuelOutTick = 0;
+	if ( md.maxFuel > 0 && md.active && md.fuel > 0 )
+	{
+		md.fuelOutTick = GameState::tick + md.fuel;
+
+		const unsigned int itemID = md.itemID;
+		const quint64 fuelOutTick = md.fuelOutTick;
+		g->schedule( fuelOutTick, [this, itemID, fuelOutTick]() { onFuelOut( itemID, fuelOutTick ); } );
+	}
+}
+
+/// @brief Stops an engine whose fuel ran out. Wake-ups from before a refuel or a switch are ignored.
+/// @param itemID      Mechanism item UID of the engine.
+/// @param fuelOutTick The engine's fuelOutTick when the wake-up was scheduled.
+void MechanismManager::onFuelOut( unsigned int itemID, quint64 fuelOutTick )
+{
+	auto it = m_mechanisms.find( itemID );
+	if ( it == m_mechanisms.end() || it->fuelOutTick != fuelOutTick )
+	{
+		return;
+	}
+	it->fuel        = 0;
+	it->fuelOutTick = 0;
+
+	g->m_world->setWallSpriteAnim( it->pos, false );
+	m_needNetworkUpdate = true;
+}
+
 /// @brief Sets the fuel percentage at which a refuel job is automatically created.
 /// @param itemID  Mechanism item UID.
 /// @param percent Threshold percentage (0–100).
@@ -812,7 +849,7 @@ void MechanismManager::updateNetWorks()
 			while ( !workQueue.empty() )
 			{
 				auto md2 = workQueue.dequeue();
-				if ( md2.active && md2.fuel > 0 && md2.producePower > 0 )
+				if ( md2.active && md2.fuelLeft() > 0 && md2.producePower > 0 )
 				{
 					mn.produce += md2.producePower;
 					mn.producers.insert( md2.itemID );
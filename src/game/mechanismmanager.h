@@ -64,7 +64,8 @@ struct MechanismData
 
 	int producePower = 0;
 
-	int fuel            = 0;
+	int fuel            = 0; ///< Fuel left when the engine last started or stopped burning, see fuelLeft().
+	quint64 fuelOutTick = 0; ///< Tick the fuel runs out while the engine burns, 0 while it doesn't.
 	int maxFuel         = 0;
 	int refuelThreshold = 50;
 	int consumePower    = 0;
@@ -78,6 +79,8 @@ struct MechanismData
 
 	QList<Position> connectsTo;
 
+	int fuelLeft() const;
+
 	QVariantMap serialize() const;
 	void deserialize( QVariantMap in );
 
@@ -166,7 +169,9 @@ class MechanismManager : public QObject
 	void setInverted( unsigned int itemID, bool inv );
 	void setConnectsTo( MechanismData& md );
 
-	quint64 m_lastTick       = 0;
+	void updateBurn( MechanismData& md );
+	void onFuelOut( unsigned int itemID, quint64 fuelOutTick );
+
 	bool m_needNetworkUpdate = false;
 
 	QHash<unsigned int, MechanismData> m_mechanisms;
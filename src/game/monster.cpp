@@ -21,9 +21,11 @@
 #include "monster.h"
 
 #include "../base/db.h"
+#include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/logger.h"
 #include "../base/priorityqueue.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/game.h"
 #include "../game/creaturemanager.h"
@@ -126,8 +128,7 @@ void Monster::updateSprite()
 			bsa.remove( 0, 1 );
 			auto bsl = bsa.split( "|" );
 
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
-			int rn = rand() % bsl.size();
+			int rn = RNG::rand( RngStream::Creatures ) % bsl.size();
 			randTemp.insert( pm.value( "Part" ).toString() + "Rand", rn );
 			pm.insert( "BaseSprite", bsl[rn] );
 		}
@@ -152,7 +153,6 @@ void Monster::updateSprite()
 			bsa.remove( 0, 1 );
 			auto bsl = bsa.split( "|" );
 
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
 			int rn = randTemp.value( pm.value( "Part" ).toString() + "Rand" ).toInt();
 			pm.insert( "BaseSprite", bsl[rn] + "Back" );
 		}
@@ -194,12 +194,11 @@ void Monster::initTaskMap()
 void Monster::generateAggroList()
 {
 	m_aggroList.clear();
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 	for ( auto& gn : g->gm()->gnomes() )
 	{
 		if ( !gn->isOnMission() )
 		{
-			AggroEntry ae { rand() % 100, gn->id() };
+			AggroEntry ae { RNG::rand( RngStream::Creatures ) % 100, gn->id() };
 			m_aggroList.append( ae );
 		}
 	}
@@ -225,7 +224,7 @@ CreatureTickResult Monster::onTick( quint64 tickNumber, bool seasonChanged, bool
 		auto status = m_anatomy.status();
 		if ( status & AS_DEAD )
 		{
-			Global::logger().log( LogType::COMBAT, "The " + m_name + " died. Bummer!", m_id );
+			Global::logger().log( LogType::COMBAT, "The %1 died. Bummer!", m_id, { m_name } );
 			die();
 			// TODO check for other statuses
 		}
@@ -340,13 +339,13 @@ BT_RESULT Monster::actionAttackTarget( bool halt )
 	{
 		m_facing = getFacing( m_position, creature->getPos() );
 
-		if ( m_rightHandCooldown <= 0 )
+		if ( m_rightHandCooldownEnd <= GameState::tick )
 		{
-			Global::logger().log( LogType::COMBAT, "The goblin attacks " + creature->name(), m_id );
+			Global::logger().log( LogType::COMBAT, "The goblin attacks %1", m_id, { creature->name() } );
 			int skill    = getSkillLevel( "Unarmed" );
 			int strength = attribute( "Str" );
 			creature->attack( DT_BLUNT, m_anatomy.randomAttackHeight(), skill, qMin( 5, strength ), m_position, m_id );
-			m_rightHandCooldown = qMax( 5, 20 - m_rightHandAttackSkill );
+			m_rightHandCooldownEnd = GameState::tick + qMax( 5, 20 - m_rightHandAttackSkill );
 		}
 		return BT_RESULT::RUNNING;
 	}
@@ -473,20 +472,19 @@ bool Monster::attack( DamageType dt, AnatomyHeight da, int skill, int strength,
 	bool hit = skill >= dodge;
 	if ( dodge > skill )
 	{
-		srand( std::chrono::system_clock::now().time_since_epoch().count() );
 		int diff = dodge - skill;
 		diff     = qMax( 5, 20 - diff );
-		hit |= rand() % 100 > diff;
+		hit |= RNG::rand( RngStream::Combat ) % 100 > diff;
 	}
 
 	if ( hit )
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " took " + QString::number( strength ) + " damage.", m_id );
+		Global::logger().log( LogType::COMBAT, "%1 took %2 damage.", m_id, { m_name, strength } );
 		m_anatomy.damage( &m_equipment, dt, da, ds, strength );
 	}
 	else
 	{
-		Global::logger().log( LogType::COMBAT, m_name + " dogded the attack. Skill:" + QString::number( skill ) + " Dodge: " + QString::number( dodge ), m_id );
+		Global::logger().log( LogType::COMBAT, "%1 dogded the attack. Skill:%2 Dodge: %3", m_id, { m_name, skill, dodge } );
 	}
 
 	bool aeExists = false;
@@ -22,6 +22,7 @@
 #include "game.h"
 
 #include "../base/gamestate.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/eventmanager.h"
 #include "../gui/strings.h"
@@ -128,6 +129,7 @@ void NeighborManager::deserialize( QVariantList in )
 		NeighborKingdom nk;
 		nk.deserialize( vk.toMap() );
 		m_kingdoms.append( nk );
+		scheduleRaid( nk );
 	}
 }
 
@@ -137,7 +139,6 @@ void NeighborManager::deserialize( QVariantList in )
 /// @param type KingdomType::GNOME or KingdomType::GOBLIN.
 void NeighborManager::addRandomKingdom( KingdomType type )
 {
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 	NeighborKingdom nk;
 	nk.id = GameState::createID();
@@ -145,40 +146,54 @@ void NeighborManager::addRandomKingdom( KingdomType type )
 	nk.discovered = false;
 	nk.name       = S::gi().randomKingdomName();
 	nk.type       = type;
-	nk.distance   = rand() % 180 + 72;
-	nk.wealth     = ( KingdomWealth )( rand() % ( (int)KingdomWealth::VERYRICH + 1 ) );
-	nk.economy    = ( KingdomEconomy )( rand() % ( (int)KingdomEconomy::ANIMALBREEDING + 1 ) );
-	nk.military   = ( KingdomMilitary )( rand() % ( (int)KingdomMilitary::VERYSTRONG + 1 ) );
+	nk.distance   = RNG::rand( RngStream::Neighbors ) % 180 + 72;
+	nk.wealth     = ( KingdomWealth )( RNG::rand( RngStream::Neighbors ) % ( (int)KingdomWealth::VERYRICH + 1 ) );
+	nk.economy    = ( KingdomEconomy )( RNG::rand( RngStream::Neighbors ) % ( (int)KingdomEconomy::ANIMALBREEDING + 1 ) );
+	nk.military   = ( KingdomMilitary )( RNG::rand( RngStream::Neighbors ) % ( (int)KingdomMilitary::VERYSTRONG + 1 ) );
 
 	nk.attitude = 0;
 	switch ( type )
 	{
 		case KingdomType::GNOME:
-			nk.attitude = rand() % 100;
+			nk.attitude = RNG::rand( RngStream::Neighbors ) % 100;
 			break;
 		case KingdomType::GOBLIN:
-			nk.attitude = -( rand() % 60 + 40 );
+			nk.attitude = -( RNG::rand( RngStream::Neighbors ) % 60 + 40 );
 			nk.nextRaid = GameState::tick + 60 * Global::util->ticksPerDayRandomized( 10 );
 			break;
 	}
 
 	m_kingdoms.append( nk );
+	scheduleRaid( nk );
 }
 
-/// @brief Per-tick update: triggers raid events for goblin kingdoms whose nextRaid tick has passed.
-/// @param tickNumber    Current game tick.
-/// @param seasonChanged Unused.
-/// @param dayChanged    Unused.
-/// @param hourChanged   Unused.
-/// @param minuteChanged Unused.
-void NeighborManager::onTick( quint64 tickNumber, bool seasonChanged, bool dayChanged, bool hourChanged, bool minuteChanged )
+/// @brief Wakes up the manager at the next raid of a goblin kingdom. Other kingdoms don't raid.
+/// @param kingdom The kingdom to schedule.
+void NeighborManager::scheduleRaid( const NeighborKingdom& kingdom )
+{
+	if ( kingdom.type == KingdomType::GOBLIN )
+	{
+		const unsigned int id = kingdom.id;
+		g->schedule( kingdom.nextRaid, [this, id]() { onRaidDue( id ); } );
+	}
+}
+
+/// @brief Triggers the raid event of a goblin kingdom and schedules its next raid.
+///        If sabotage pushed the raid back since it was scheduled, waits for the new tick instead.
+/// @param kingdomID UID of the raiding kingdom.
+void NeighborManager::onRaidDue( unsigned int kingdomID )
 {
 	for ( auto& kingdom : m_kingdoms )
 	{
-		if ( kingdom.type == KingdomType::GOBLIN && GameState::tick >= kingdom.nextRaid )
+		if ( kingdom.id == kingdomID )
 		{
-			g->m_eventManager->addRaidEvent( kingdom );
-			kingdom.nextRaid = GameState::tick + Global::util->ticksPerDayRandomized( 10 ) * Global::util->daysPerSeason * 4;
+			if ( GameState::tick >= kingdom.nextRaid )
+			{
+				g->m_eventManager->addRaidEvent( kingdom );
+				kingdom.nextRaid = GameState::tick + Global::util->ticksPerDayRandomized( 10 ) * Global::util->daysPerSeason * 4;
+			}
+			scheduleRaid( kingdom );
+			break;
 		}
 	}
 }
@@ -243,9 +258,8 @@ void NeighborManager::spy( Mission* mission )
 	{
 		if ( k.id == kingdomID )
 		{
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
 			int chance   = 75;
-			bool success = ( rand() % 100 ) < chance;
+			bool success = ( RNG::rand( RngStream::Neighbors ) % 100 ) < chance;
 			if ( success )
 			{
 				qDebug() << "spy success";
@@ -273,17 +287,16 @@ void NeighborManager::sabotage( Mission* mission )
 	{
 		if ( k.id == kingdomID )
 		{
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 			int chance = 50;
 			chance += ( mission->gnomes.size() - 2 ) * 10;
-			bool success = ( rand() % 100 ) < chance;
+			bool success = ( RNG::rand( RngStream::Neighbors ) % 100 ) < chance;
 
 			if ( success )
 			{
 				qDebug() << "sabotage success";
 				mission->result.insert( "Success", true );
-				int delay = qMax( 2, rand() % 6 );
+				int delay = qMax( 2, RNG::rand( RngStream::Neighbors ) % 6 );
 				mission->result.insert( "Delay", delay );
 
 				k.nextRaid += delay * Global::util->ticksPerDay;
@@ -308,11 +321,10 @@ void NeighborManager::raid( Mission* mission )
 	{
 		if ( k.id == kingdomID )
 		{
-			srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 			int chance = 50;
 			chance += ( mission->gnomes.size() - 2 ) * 10;
-			bool success = ( rand() % 100 ) < chance;
+			bool success = ( RNG::rand( RngStream::Neighbors ) % 100 ) < chance;
 
 			if ( success )
 			{
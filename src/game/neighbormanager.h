@@ -107,8 +107,6 @@ class NeighborManager : public QObject
 	QVariantList serialize();
 	void deserialize( QVariantList in );
 
-	void onTick( quint64 tickNumber, bool seasonChanged, bool dayChanged, bool hourChanged, bool minuteChanged );
-
 	QList<NeighborKingdom>& kingdoms();
 
 	int countDiscovered();
@@ -130,6 +128,9 @@ class NeighborManager : public QObject
 
 	QList<NeighborKingdom> m_kingdoms;
 
+	void scheduleRaid( const NeighborKingdom& kingdom );
+	void onRaidDue( unsigned int kingdomID );
+
 signals:
 
 public slots:
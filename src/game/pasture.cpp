@@ -25,6 +25,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/game.h"
 #include "../game/creaturemanager.h"
@@ -306,7 +307,7 @@ void Pasture::onTick( quint64 tick, int& count )
 				}
 				if( freeFields.size() )
 				{
-					int random = rand() % freeFields.size();
+					int random = RNG::rand( RngStream::Creatures ) % freeFields.size();
 					auto targetPos = freeFields[random];
 
 					auto jobID = g->jm()->addJob( "LeadAnimalToPasture", animal->getPos(), 0, false );
@@ -469,7 +470,7 @@ void Pasture::addAnimal( unsigned int animalID )
 							++countFemale;
 						}
 					}
-					int random = rand() % m_fields.size();
+					int random = RNG::rand( RngStream::Creatures ) % m_fields.size();
 					Position fieldPos;
 					for ( auto field : m_fields )
 					{
@@ -481,24 +482,13 @@ void Pasture::addAnimal( unsigned int animalID )
 						--random;
 					}
 
-					auto animals = g->cm()->animalsByDistance( fieldPos, m_properties.animalType );
-					Animal* a    = nullptr;
-					while ( !animals.empty() )
-					{
-						a = animals.get();
-						if ( !a->isTame() && a->pastureID() == 0 && !a->toDestroy() && !a->isDead() )
+					Animal* a = g->cm()->getClosestAnimal( fieldPos, m_properties.animalType, [&]( Animal* a ) {
+						if ( a->isTame() || a->pastureID() != 0 )
 						{
-							if ( a->gender() == Gender::MALE && countMale < m_properties.maxMale )
-							{
-								break;
-							}
-							else if ( a->gender() == Gender::FEMALE && countFemale < m_properties.maxFemale )
-							{
-								break;
-							}
+							return false;
 						}
-						a = nullptr;
-					}
+						return ( a->gender() == Gender::MALE && countMale < m_properties.maxMale ) || ( a->gender() == Gender::FEMALE && countFemale < m_properties.maxFemale );
+					} );
 					if ( a )
 					{
 						QSharedPointer<Job> job( new Job() );
@@ -716,7 +706,7 @@ QString Pasture::utilSID( Position pos )
 /// @return Random field position.
 Position Pasture::randomFieldPos()
 {
-	int random = rand() % m_fields.size();
+	int random = RNG::rand( RngStream::Creatures ) % m_fields.size();
 	for ( auto field : m_fields )
 	{
 		if ( random == 0 )
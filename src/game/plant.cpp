@@ -24,6 +24,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/creaturemanager.h"
 #include "../game/game.h"
@@ -36,7 +37,6 @@
 
 #include <QDebug>
 #include <QPainter>
-#include <QRandomGenerator>
 
 #include <random>
 
@@ -69,6 +69,7 @@ Plant::Plant( Position& pos, QString ID, bool fullyGrown, Game* game ) :
 
 	m_producesHarvest = row.contains( "OnHarvest" );
 
+	m_species = g->w()->plantSpecies( m_plantID );
 	setGrowsThisSeason();
 
 	if ( fullyGrown )
@@ -107,6 +108,7 @@ Plant::Plant( Position& pos, QString ID, bool fullyGrown, Game* game ) :
 	}
 
 	setGrowTime();
+	scheduleGrowth();
 }
 
 /// @brief Deserialising constructor. Restores a plant from a previously serialised QVariant map.
@@ -139,6 +141,7 @@ Plant::Plant( QVariant values, Game* game ) :
 	m_numFruits          = in.value( "NumFruits" ).toInt();
 	m_hasAlpha           = in.value( "HasAlpha" ).toBool();
 	m_lightIntensity     = in.value( "LightIntensity" ).toInt();
+	m_species            = g->w()->plantSpecies( m_plantID );
 	setGrowsThisSeason();
 
 	QString growLight = in.value( "GrowsIn" ).toString();
@@ -156,6 +159,7 @@ Plant::Plant( QVariant values, Game* game ) :
 	}
 
 	updateState();
+	scheduleGrowth();
 }
 
 /// @brief Destructor.
@@ -174,7 +178,7 @@ QVariant Plant::serialize() const
 
 	out.insert( "PlantID", m_plantID );
 	out.insert( "State", m_state );
-	out.insert( "TTNS", m_ticksToNextState );
+	out.insert( "TTNS", pendingTicksToNextState() );
 	out.insert( "FullyGrown", m_fullyGrown );
 	out.insert( "MatureWood", m_matureWood );
 	out.insert( "Harvestable", m_harvestable );
@@ -202,22 +206,10 @@ QVariant Plant::serialize() const
 	return out;
 }
 
-/// @brief Updates m_growsThisSeason by checking whether the current season
-///        appears in the plant's GrowsInSeason pipe-delimited DB field.
+/// @brief Updates m_growsThisSeason from the precomputed season rules of the plant's species.
 void Plant::setGrowsThisSeason()
 {
-	QVariantMap row     = DB::selectRow( "Plants", m_plantID );
-	QString season      = GameState::seasonString;
-	auto growSeasonList = row.value( "GrowsInSeason" ).toString().split( "|" );
-	for ( auto gs : growSeasonList )
-	{
-		if ( gs == season )
-		{
-			m_growsThisSeason = true;
-			return;
-		}
-	}
-	m_growsThisSeason = false;
+	m_growsThisSeason = g->w()->plantSeasonRules( m_species ).growsNow;
 }
 
 /// @brief Returns whether this plant grows in the current season.
@@ -227,92 +219,120 @@ bool Plant::growsThisSeason()
 	return m_growsThisSeason;
 }
 
-/// @brief Per-tick update entry point. Delegates to liveOneTick().
-/// @param tickNumber    Current game tick (unused directly).
-/// @param dayChanged    True if the day boundary was crossed this tick.
-/// @param seasonChanged True if the season boundary was crossed this tick.
-/// @return OnTickReturn::UPDATE if the world tile needs a sprite refresh, NOOP otherwise.
-OnTickReturn Plant::onTick( quint64 tickNumber, bool dayChanged, bool seasonChanged )
-{
-	return liveOneTick( dayChanged, seasonChanged );
-}
-
-/// @brief Core growth tick. Handles seasonal events (kill/fruit-loss) and advances
-///        the growth state when the countdown reaches zero, respecting light requirements.
-/// @param dayChanged    True if the day boundary was crossed this tick.
-/// @param seasonChanged True if the season boundary was crossed this tick.
+/// @brief Applies the seasonal rules of the plant's species after a season change.
+///        Credits the growth made in the old season first, then handles kill and
+///        fruit loss and books the next growth check.
+/// @param rules Season rules of this plant's species, evaluated for the new season.
 /// @return OnTickReturn::UPDATE if the plant changed state, NOOP otherwise.
-OnTickReturn Plant::liveOneTick( bool dayChanged, bool seasonChanged )
+OnTickReturn Plant::onSeasonChanged( const PlantSeasonRules& rules )
 {
-	if ( m_fullyGrown && !seasonChanged )
-	{
-		return OnTickReturn::NOOP;
-	}
+	settleGrowth();
+	m_growsThisSeason = rules.growsNow;
 
-	if ( seasonChanged )
+	// if is killed in season and is that season
+	if ( rules.killedNow )
 	{
-		QVariantMap row = DB::selectRow( "Plants", m_plantID );
-		QString season  = GameState::seasonString;
-
-		setGrowsThisSeason();
-
-		// if is killed in season and is that season
-		QString isKilledInSeason = row.value( "IsKilledInSeason" ).toString();
-		if ( isKilledInSeason == season )
-		{
-			m_state       = 0;
-			m_harvestable = false;
-			m_fullyGrown  = false;
-			m_numFruits   = 0;
-			setGrowTime();
-			updateState();
-			return OnTickReturn::UPDATE;
-		}
-		// if loses fruit and has fruit
-		else if ( harvestable() )
-		{
-			QString losesFruitInSeason = row.value( "LosesFruitInSeason" ).toString();
-			if ( losesFruitInSeason == season )
-			{
-				m_harvestable = false;
-				m_fullyGrown  = false;
-				m_state       = qMax( 0, m_state - 1 );
-				m_numFruits   = 0;
-				setGrowTime();
-				updateState();
-				return OnTickReturn::UPDATE;
-			}
-		}
+		m_state       = 0;
+		m_harvestable = false;
+		m_fullyGrown  = false;
+		m_numFruits   = 0;
+		setGrowTime();
+		updateState();
+		scheduleGrowth();
+		return OnTickReturn::UPDATE;
 	}
-
-	if ( m_growsThisSeason )
+	// if loses fruit and has fruit
+	else if ( harvestable() && rules.losesFruitNow )
 	{
-		switch ( m_growLight )
-		{
-			case GrowLight::SUN:
-				if ( GameState::daylight && g->w()->hasSunlight( m_position ) )
-					--m_ticksToNextState;
-				break;
-			case GrowLight::DARK:
-				if ( !GameState::daylight )
-					--m_ticksToNextState;
-				break;
-			case GrowLight::SUN_AND_DARK:
-				--m_ticksToNextState;
-				break;
-		}
+		m_harvestable = false;
+		m_fullyGrown  = false;
+		m_state       = qMax( 0, m_state - 1 );
+		m_numFruits   = 0;
+		setGrowTime();
+		updateState();
+		scheduleGrowth();
+		return OnTickReturn::UPDATE;
 	}
+	scheduleGrowth();
+	return OnTickReturn::NOOP;
+}
+
+/// @brief Called by the world when the booked growth check is due. Credits the
+///        growth since the last visit and advances the growth state when the
+///        countdown has reached zero.
+/// @return OnTickReturn::UPDATE if the plant changed state, NOOP otherwise.
+OnTickReturn Plant::onGrowthDue()
+{
+	settleGrowth();
 
 	if ( m_ticksToNextState == 0 )
 	{
 		setGrowTime();
 		++m_state;
 		updateState();
+		scheduleGrowth();
 		return OnTickReturn::UPDATE;
 	}
+	scheduleGrowth();
 	return OnTickReturn::NOOP;
 }
 
+/// @brief Returns the growth countdown with the growth since the last visit subtracted.
+///        Only ticks that met the light requirement count. Sunlight on the tile is
+///        sampled now and assumed to have held since the last visit.
+/// @return Ticks left until the next growth state.
+unsigned int Plant::pendingTicksToNextState() const
+{
+	if ( !m_nextGrowthCheck )
+	{
+		return m_ticksToNextState;
+	}
+	const quint64 ticks    = g->w()->plantGrowthTicks() - m_growthTicks;
+	const quint64 daylight = g->w()->plantDaylightTicks() - m_daylightTicks;
+
+	quint64 grown = 0;
+	switch ( m_growLight )
+	{
+		case GrowLight::SUN:
+			if ( g->w()->hasSunlight( m_position ) )
+				grown = daylight;
+			break;
+		case GrowLight::DARK:
+			grown = ticks - daylight;
+			break;
+		case GrowLight::SUN_AND_DARK:
+			grown = ticks;
+			break;
+	}
+	return m_ticksToNextState - (unsigned int)qMin<quint64>( grown, m_ticksToNextState );
+}
+
+/// @brief Books the growth since the last visit into m_ticksToNextState.
+void Plant::settleGrowth()
+{
+	m_ticksToNextState = pendingTicksToNextState();
+	m_growthTicks      = g->w()->plantGrowthTicks();
+	m_daylightTicks    = g->w()->plantDaylightTicks();
+}
+
+/// @brief Books the next growth check on the world's plant timer wheel.
+///        The check is due after m_ticksToNextState ticks, the earliest tick the
+///        countdown can reach zero. Plants that are fully grown or do not grow this
+///        season are not booked, the next season change picks them up again.
+void Plant::scheduleGrowth()
+{
+	m_growthTicks   = g->w()->plantGrowthTicks();
+	m_daylightTicks = g->w()->plantDaylightTicks();
+
+	if ( m_fullyGrown || !m_growsThisSeason )
+	{
+		m_nextGrowthCheck = 0;
+		return;
+	}
+	m_nextGrowthCheck = GameState::tick + qMax( 1u, m_ticksToNextState );
+	g->w()->schedulePlant( m_position.toInt(), m_nextGrowthCheck );
+}
+
 /// @brief Sets m_ticksToNextState from the current state's DB GrowTime, randomised ±5%.
 void Plant::setGrowTime()
 {
@@ -323,7 +343,7 @@ void Plant::setGrowTime()
 		QVariantMap sm     = sl[m_state];
 		int ticks          = sm["GrowTime"].toFloat() * Global::util->ticksPerDay;
 		int dev            = ticks * 0.05;
-		int rand           = ( QRandomGenerator::global()->generate() % dev ) - ( dev / 2 );
+		int rand           = ( RNG::rand( RngStream::Plants ) % dev ) - ( dev / 2 );
 		m_ticksToNextState = ticks + rand;
 		//float stddev = mean*0.05;
 		//std::normal_distribution<float> dist( mean, stddev );
@@ -441,6 +461,7 @@ bool Plant::reduceOneGrowLevel()
 		{
 			return true;
 		}
+		scheduleGrowth();
 	}
 	return false;
 }
@@ -465,7 +486,7 @@ bool Plant::fell()
 			{
 				int random = row.value( "Random" ).toInt();
 
-				int randVal = ( rand() % random ) + 1;
+				int randVal = ( RNG::rand( RngStream::Plants ) % random ) + 1;
 				for ( int i = 0; i < randVal; ++i )
 				{
 					g->inv()->createItem( m_position, itemID, materialID );
@@ -541,7 +562,7 @@ bool Plant::harvest( Position& pos )
 				float chance = harvItem.value( "Chance" ).toFloat();
 				if ( chance > 0.0 )
 				{
-					int ra = rand() % 100;
+					int ra = RNG::rand( RngStream::Plants ) % 100;
 					if ( ra < chance * 100 )
 					{
 						g->inv()->createItem( pos, itemID, materialID );
@@ -582,6 +603,7 @@ bool Plant::harvest( Position& pos )
 				m_state       = qMax( 0, m_state - 1 );
 				setGrowTime();
 				updateState();
+				scheduleGrowth();
 				return false;
 			}
 		}
@@ -591,6 +613,7 @@ bool Plant::harvest( Position& pos )
 			m_state       = qMax( 0, m_state - 1 );
 			setGrowTime();
 			updateState();
+			scheduleGrowth();
 			return false;
 		}
 	}
@@ -646,7 +669,7 @@ void Plant::layoutMulti( QString layoutSID, bool withFruit )
 		{
 			if ( vm.value( "FruitPos" ).toBool() )
 			{
-				if ( rand() % 3 == 0 )
+				if ( RNG::rand( RngStream::Plants ) % 3 == 0 )
 					spriteID += "WithFruit";
 			}
 		}
@@ -715,6 +738,7 @@ bool Plant::testLayoutMulti( QString layoutSID, Position rootPos, Game* game )
 /// @param ticks Number of ticks to subtract from the current countdown.
 void Plant::speedUpGrowth( unsigned int ticks )
 {
+	settleGrowth();
 	if ( m_ticksToNextState > 1 )
 	{
 		ticks = qMin( ticks, m_ticksToNextState - 1 );
@@ -725,4 +749,5 @@ void Plant::speedUpGrowth( unsigned int ticks )
 	}
 
 	m_ticksToNextState = m_ticksToNextState - ticks;
+	scheduleGrowth();
 }
@@ -21,8 +21,10 @@
 #pragma once
 
 #include "object.h"
+#include "../base/slab.h"
 
 #include <QString>
+#include <QStringList>
 
 class Game;
 
@@ -42,11 +44,39 @@ enum class OnTickReturn : unsigned char
 	DESTROY
 };
 
+/** @brief Seasonal behaviour of one plant species, read from the Plants table once per game.
+ *
+ *  The "...Now" flags are evaluated for the current season once per species when the
+ *  season changes, so the sweep over all plants does not touch the database or compare
+ *  season strings.
+ */
+struct PlantSeasonRules
+{
+	QStringList growsInSeason;
+	QString killedInSeason;
+	QString losesFruitInSeason;
+
+	bool growsNow      = false;
+	bool killedNow     = false;
+	bool losesFruitNow = false;
+
+	void evaluate( const QString& season )
+	{
+		growsNow      = growsInSeason.contains( season );
+		killedNow     = ( killedInSeason == season );
+		losesFruitNow = ( losesFruitInSeason == season );
+	}
+};
+
 /** @brief Represents an individual plant or tree in the world.
  *
  *  Tracks growth state progression driven by ticks, seasonal changes, and light conditions.
  *  Supports multi-tile tree layouts, fruit production, harvesting, felling, and serialization.
  *  Growth advances only when light/season requirements are met.
+ *
+ *  A growing plant is not ticked. It books its next growth check on the world's plant
+ *  timer wheel and, when visited, credits the ticks that met its light requirement since
+ *  the last visit using the world's growth tick counters.
  */
 class Plant : public Object
 {
@@ -58,9 +88,17 @@ class Plant : public Object
 
 	virtual QVariant serialize() const;
 
-	OnTickReturn onTick( quint64 tickNumber, bool dayChanged, bool seasonChanged );
+	OnTickReturn onGrowthDue();
+	OnTickReturn onSeasonChanged( const PlantSeasonRules& rules );
 
-	OnTickReturn liveOneTick( bool dayChanged = false, bool seasonChanged = false );
+	unsigned short species() const
+	{
+		return m_species;
+	}
+	quint64 nextGrowthCheck() const
+	{
+		return m_nextGrowthCheck;
+	}
 
 	QString getDesignation();
 
@@ -129,11 +167,15 @@ class Plant : public Object
 	QPointer<Game> g;
 
 	QString m_plantID;
+	unsigned short m_species = 0;
 
 	Sprite* m_sprite = 0;
 
 	qint8 m_state                   = 0;
 	unsigned int m_ticksToNextState = 0;
+	quint64 m_nextGrowthCheck       = 0;
+	quint64 m_growthTicks           = 0;
+	quint64 m_daylightTicks         = 0;
 	bool m_fullyGrown               = false;
 	bool m_matureWood               = false;
 	bool m_harvestable              = false;
@@ -155,6 +197,84 @@ class Plant : public Object
 	int m_numFruits = 0;
 
 	void setGrowTime();
+	unsigned int pendingTicksToNextState() const;
+	void settleGrowth();
+	void scheduleGrowth();
 	void updateState();
 	void layoutMulti( QString layoutSID, bool withFruit = false );
 };
+
+/**
+ * @brief The plants of the world, keyed by the tile ID of their root tile.
+ *
+ * Plants live in a Slab, so the season sweep walks them in memory order and a
+ * Plant& stays valid until that plant is removed. The tile ID lookup goes through
+ * a SlabIndex. The interface is the part of QMap the callers used before.
+ */
+class PlantStore
+{
+public:
+	bool contains( unsigned int tileID ) const
+	{
+		return m_plants.get( m_handles.get( tileID ) ) != nullptr;
+	}
+
+	/** @brief The plant on a tile, nullptr if there is none. */
+	Plant* find( unsigned int tileID )
+	{
+		return m_plants.get( m_handles.get( tileID ) );
+	}
+
+	/** @brief The plant on a tile, which has to exist, see contains(). */
+	Plant& operator[]( unsigned int tileID )
+	{
+		Plant* plant = find( tileID );
+		Q_ASSERT( plant );
+		return *plant;
+	}
+
+	/** @brief Adds a plant, replacing the plant on the tile if there is one. */
+	void insert( unsigned int tileID, const Plant& plant )
+	{
+		m_plants.erase( m_handles.get( tileID ) );
+		m_handles.set( tileID, m_plants.emplace( plant ) );
+	}
+
+	void remove( unsigned int tileID )
+	{
+		m_plants.erase( m_handles.get( tileID ) );
+		m_handles.remove( tileID );
+	}
+
+	int size() const
+	{
+		return m_plants.size();
+	}
+
+	void clear()
+	{
+		m_plants.clear();
+		m_handles.clear();
+	}
+
+	Slab<Plant>::iterator begin()
+	{
+		return m_plants.begin();
+	}
+	Slab<Plant>::iterator end()
+	{
+		return m_plants.end();
+	}
+	Slab<Plant>::const_iterator begin() const
+	{
+		return m_plants.begin();
+	}
+	Slab<Plant>::const_iterator end() const
+	{
+		return m_plants.end();
+	}
+
+private:
+	Slab<Plant> m_plants;
+	SlabIndex m_handles; ///< Tile ID → handle into m_plants.
+};
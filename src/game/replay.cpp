@@ -0,0 +1,359 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file replay.cpp
+ *  @brief Implementation of the replay recorder: command log, checkpoints, state hash and headless runner.
+ */
+
+#include "replay.h"
+
+#include "../base/gamestate.h"
+#include "../base/global.h"
+#include "../base/profiler.h"
+#include "../base/rng.h"
+#include "../base/selection.h"
+#include "../game/creaturemanager.h"
+#include "../game/game.h"
+#include "../game/gamemanager.h"
+#include "../game/gnome.h"
+#include "../game/gnomemanager.h"
+#include "../game/inventory.h"
+#include "../game/world.h"
+#include "../gui/aggregatorstockpile.h"
+#include "../gui/aggregatorworkshop.h"
+#include "../gui/eventconnector.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+
+bool Replay::m_recording = false;
+bool Replay::m_replaying = false;
+QString Replay::m_path;
+QString Replay::m_saveFolder;
+quint64 Replay::m_startTick = 0;
+quint64 Replay::m_endTick   = 0;
+
+QVariantList Replay::m_commands;
+QVariantList Replay::m_checkpoints;
+int Replay::m_nextCommand    = 0;
+int Replay::m_nextCheckpoint = 0;
+int Replay::m_desyncs        = 0;
+
+namespace
+{
+constexpr quint64 fnvOffset = 14695981039346656037ull;
+constexpr quint64 fnvPrime  = 1099511628211ull;
+
+inline void mix( quint64& hash, quint64 value )
+{
+	hash ^= value;
+	hash *= fnvPrime;
+}
+}
+
+/** @brief Arms the recorder, the recording itself starts with the next loaded save game.
+ *  @param path Replay file to write.
+ */
+void Replay::setRecordFile( QString path )
+{
+	m_path = path;
+}
+
+/** @brief Starts recording from a freshly loaded save game. Does nothing unless armed with setRecordFile().
+ *  @param saveFolder Folder of the save game the recording starts from.
+ */
+void Replay::startRecording( QString saveFolder )
+{
+	if ( m_path.isEmpty() || m_replaying )
+	{
+		return;
+	}
+	m_recording  = true;
+	m_saveFolder = saveFolder;
+	m_startTick  = GameState::tick;
+	m_commands.clear();
+	m_checkpoints.clear();
+
+	qDebug() << "Replay: recording" << saveFolder << "from tick" << m_startTick << "to" << m_path;
+}
+
+/** @brief Logs a player command for the tick that is processed next.
+ *  @param type Command type, see execute() for the known types.
+ *  @param args Command arguments in the order of the handling slot.
+ */
+void Replay::record( QString type, QVariantList args )
+{
+	if ( !m_recording )
+	{
+		return;
+	}
+	QVariantMap command;
+	command.insert( "Tick", GameState::tick );
+	command.insert( "Type", type );
+	command.insert( "Args", args );
+	m_commands.append( command );
+}
+
+/** @brief Feeds all recorded commands for the current tick back into the game while replaying. */
+void Replay::beforeTick()
+{
+	if ( !m_replaying )
+	{
+		return;
+	}
+	while ( m_nextCommand < m_commands.size() )
+	{
+		const QVariantMap command = m_commands[m_nextCommand].toMap();
+		if ( command.value( "Tick" ).value<quint64>() > GameState::tick )
+		{
+			break;
+		}
+		execute( command );
+		++m_nextCommand;
+	}
+}
+
+/** @brief Stores or verifies the state hash on checkpoint ticks. Called after the tick counter advanced.
+ *  @param game The running game.
+ */
+void Replay::afterTick( Game* game )
+{
+	if ( !active() || ( GameState::tick - m_startTick ) % checkpointInterval != 0 )
+	{
+		return;
+	}
+	const QString hash = QString::number( stateHash( game ), 16 );
+
+	if ( m_recording )
+	{
+		QVariantMap checkpoint;
+		checkpoint.insert( "Tick", GameState::tick );
+		checkpoint.insert( "Hash", hash );
+		m_checkpoints.append( checkpoint );
+		// Rewrite the file on every checkpoint, the game thread is terminated without cleanup on exit
+		flush();
+		return;
+	}
+
+	while ( m_nextCheckpoint < m_checkpoints.size() )
+	{
+		const QVariantMap checkpoint = m_checkpoints[m_nextCheckpoint].toMap();
+		const quint64 tick           = checkpoint.value( "Tick" ).value<quint64>();
+		if ( tick > GameState::tick )
+		{
+			break;
+		}
+		++m_nextCheckpoint;
+		if ( tick == GameState::tick && checkpoint.value( "Hash" ).toString() != hash )
+		{
+			++m_desyncs;
+			qWarning() << "Replay: desync at tick" << tick << "expected" << checkpoint.value( "Hash" ).toString() << "got" << hash;
+		}
+	}
+}
+
+/** @brief Hashes the simulation state that player visible behaviour depends on.
+ *
+ *  Covers the tick, the random streams, all tiles, gnome and creature positions
+ *  and the item table. Render only data (sprites, light, mouse over) is left out.
+ *
+ *  @param game The running game.
+ *  @return 64 bit FNV-1a style hash.
+ */
+quint64 Replay::stateHash( Game* game )
+{
+	quint64 hash = fnvOffset;
+	mix( hash, GameState::tick );
+	mix( hash, RNG::stateHash() );
+
+	for ( const auto& tile : game->w()->world() )
+	{
+		mix( hash, (quint64)( tile.flags - TileFlag::TF_MOUSEOVER ) );
+		mix( hash, (quint64)tile.floorType | (quint64)tile.floorMaterial << 8 | (quint64)tile.wallType << 24 | (quint64)tile.wallMaterial << 40 );
+		mix( hash, (quint64)tile.embeddedMaterial | (quint64)tile.fluidLevel << 16 | (quint64)tile.pressure << 24 | (quint64)tile.flow << 32 | (quint64)tile.vegetationLevel << 40 | (quint64)tile.floorRotation << 48 | (quint64)tile.wallRotation << 56 );
+	}
+	for ( const auto& gnome : game->gm()->gnomes() )
+	{
+		mix( hash, gnome->id() );
+		mix( hash, gnome->getPos().toInt() );
+	}
+	for ( const auto& creature : game->cm()->creatures() )
+	{
+		mix( hash, creature->id() );
+		mix( hash, creature->getPos().toInt() );
+	}
+	// Item slots are reused in a different order after loading, combine the entries independent of their order
+	quint64 items = 0;
+	for ( const auto& item : game->inv()->allItems() )
+	{
+		quint64 entry = fnvOffset;
+		mix( entry, item.id() );
+		mix( entry, item.getPos().toInt() );
+		mix( entry, (quint64)item.isInStockpile() << 32 | item.isInJob() );
+		items += entry;
+	}
+	mix( hash, items );
+	mix( hash, game->inv()->allItems().size() );
+
+	return hash;
+}
+
+/** @brief Writes the recording to the replay file.
+ *  @return True on success.
+ */
+bool Replay::flush()
+{
+	QVariantMap out;
+	out.insert( "Version", 1 );
+	out.insert( "Save", m_saveFolder );
+	out.insert( "StartTick", m_startTick );
+	out.insert( "EndTick", GameState::tick );
+	out.insert( "CheckpointInterval", checkpointInterval );
+	out.insert( "Commands", m_commands );
+	out.insert( "Checkpoints", m_checkpoints );
+
+	QFile file( m_path );
+	if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+	{
+		qWarning() << "Replay: failed to open" << m_path;
+		return false;
+	}
+	file.write( QJsonDocument::fromVariant( out ).toJson( QJsonDocument::Compact ) );
+	return true;
+}
+
+/** @brief Reads a replay file written by flush().
+ *  @param path Replay file.
+ *  @return True if the file could be parsed.
+ */
+bool Replay::load( QString path )
+{
+	QFile file( path );
+	if ( !file.open( QIODevice::ReadOnly ) )
+	{
+		qWarning() << "Replay: failed to open" << path;
+		return false;
+	}
+	const QVariantMap in = QJsonDocument::fromJson( file.readAll() ).toVariant().toMap();
+	if ( in.value( "Version" ).toInt() != 1 || in.value( "CheckpointInterval" ).toInt() != checkpointInterval )
+	{
+		qWarning() << "Replay: unsupported file" << path;
+		return false;
+	}
+	m_saveFolder     = in.value( "Save" ).toString();
+	m_startTick      = in.value( "StartTick" ).value<quint64>();
+	m_endTick        = in.value( "EndTick" ).value<quint64>();
+	m_commands       = in.value( "Commands" ).toList();
+	m_checkpoints    = in.value( "Checkpoints" ).toList();
+	m_nextCommand    = 0;
+	m_nextCheckpoint = 0;
+	m_desyncs        = 0;
+	return true;
+}
+
+/** @brief Applies one recorded command through the same code path the GUI used.
+ *  @param command Command map with "Type" and "Args".
+ */
+void Replay::execute( const QVariantMap& command )
+{
+	const QString type      = command.value( "Type" ).toString();
+	const QVariantList args = command.value( "Args" ).toList();
+
+	if ( type == "Selection" )
+	{
+		Global::sel->execute( args.value( 0 ).toMap() );
+	}
+	else if ( type == "StockpileOptions" )
+	{
+		Global::eventConnector->aggregatorStockpile()->onSetBasicOptions( args.value( 0 ).toUInt(), args.value( 1 ).toString(), args.value( 2 ).toInt(), args.value( 3 ).toBool(), args.value( 4 ).toBool(), args.value( 5 ).toBool() );
+	}
+	else if ( type == "StockpileFilter" )
+	{
+		Global::eventConnector->aggregatorStockpile()->onSetActive( args.value( 0 ).toUInt(), args.value( 1 ).toBool(), args.value( 2 ).toString(), args.value( 3 ).toString(), args.value( 4 ).toString(), args.value( 5 ).toString() );
+	}
+	else if ( type == "WorkshopOptions" )
+	{
+		Global::eventConnector->aggregatorWorkshop()->onSetBasicOptions( args.value( 0 ).toUInt(), args.value( 1 ).toString(), args.value( 2 ).toInt(), args.value( 3 ).toBool(), args.value( 4 ).toBool(), args.value( 5 ).toBool(), args.value( 6 ).toBool() );
+	}
+	else if ( type == "CraftItem" )
+	{
+		Global::eventConnector->aggregatorWorkshop()->onCraftItem( args.value( 0 ).toUInt(), args.value( 1 ).toString(), args.value( 2 ).toInt(), args.value( 3 ).toInt(), args.value( 4 ).toStringList() );
+	}
+	else if ( type == "CraftJobCommand" )
+	{
+		Global::eventConnector->aggregatorWorkshop()->onCraftJobCommand( args.value( 0 ).toUInt(), args.value( 1 ).toUInt(), args.value( 2 ).toString() );
+	}
+	else if ( type == "CraftJobParams" )
+	{
+		Global::eventConnector->aggregatorWorkshop()->onCraftJobParams( args.value( 0 ).toUInt(), args.value( 1 ).toUInt(), args.value( 2 ).toInt(), args.value( 3 ).toInt(), args.value( 4 ).toBool(), args.value( 5 ).toBool() );
+	}
+	else
+	{
+		qWarning() << "Replay: unknown command" << type << "at tick" << GameState::tick;
+	}
+}
+
+/** @brief Replays a recording without a window and reports the timings.
+ *  @param path Replay file written by a "-record" session.
+ *  @return Process exit code: 0 on success, 1 if the replay could not start, 2 on desync.
+ */
+int Replay::runHeadless( QString path )
+{
+	if ( !load( path ) )
+	{
+		return 1;
+	}
+	GameManager gm;
+	gm.loadGame( m_saveFolder );
+	Game* game = gm.game();
+	if ( !game || GameState::tick != m_startTick )
+	{
+		qWarning() << "Replay: failed to load" << m_saveFolder << "at tick" << m_startTick;
+		return 1;
+	}
+
+	m_replaying = true;
+	QElapsedTimer timer;
+	timer.start();
+	while ( GameState::tick < m_endTick )
+	{
+		game->simulateTick();
+		Profiler::endTick();
+		// Nothing renders or listens, drop the per tick GUI traffic
+		game->w()->updatedTiles();
+		QCoreApplication::removePostedEvents( nullptr );
+	}
+	const qint64 ms   = qMax( 1LL, timer.elapsed() );
+	const quint64 num = m_endTick - m_startTick;
+	m_replaying       = false;
+
+	qInfo() << "Replay:" << num << "ticks in" << ms << "ms," << num * 1000.0 / ms << "ticks/s," << m_desyncs << "desyncs";
+	for ( const auto& entry : Profiler::percentiles() )
+	{
+		const QVariantMap section = entry.toMap();
+		qInfo() << "  " << section.value( "Section" ).toString() << "P50" << section.value( "P50" ).toDouble() << "P99" << section.value( "P99" ).toDouble() << "Max" << section.value( "Max" ).toDouble();
+	}
+	for ( const auto& entry : Profiler::counters() )
+	{
+		const QVariantMap counter = entry.toMap();
+		qInfo() << "  " << counter.value( "Counter" ).toString() << "avg" << counter.value( "Average" ).toDouble() << "Max" << counter.value( "Max" ).toInt();
+	}
+	return m_desyncs ? 2 : 0;
+}
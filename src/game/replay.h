@@ -0,0 +1,90 @@
+/*
+	This file is part of Ingnomia https://github.com/rschurade/Ingnomia
+    Copyright (C) 2017-2020  Ralph Schurade, Ingnomia Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/** @file replay.h
+ *  @brief Lockstep replay recorder: player command log, state-hash checkpoints and headless playback.
+ */
+#pragma once
+
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+
+class Game;
+
+/**
+ * @brief Static-only recorder and player for deterministic replays.
+ *
+ * A recording starts when a save game is loaded with the "-record" command line
+ * option. Every player command that changes the simulation is logged with the tick
+ * it takes effect on, and every checkpointInterval ticks a hash of the game state
+ * is stored. Running the game with "-replay" loads the same save without a window,
+ * feeds the commands back tick for tick, compares the hashes and reports the tick
+ * rate and per-subsystem timings. Identical hashes between two builds mean both ran
+ * exactly the same workload, a mismatch points at the first tick that diverged.
+ */
+class Replay
+{
+public:
+	Replay()  = delete;
+	~Replay() = delete;
+
+	static constexpr int checkpointInterval = 500; ///< Ticks between two state hashes.
+
+	static void setRecordFile( QString path );
+	static void startRecording( QString saveFolder );
+	static void record( QString type, QVariantList args );
+
+	/** @brief True while the simulation has to run in lockstep, i.e. while recording or replaying. */
+	static bool active()
+	{
+		return m_recording || m_replaying;
+	}
+	static bool isRecording()
+	{
+		return m_recording;
+	}
+	static bool isReplaying()
+	{
+		return m_replaying;
+	}
+
+	static void beforeTick();
+	static void afterTick( Game* game );
+
+	static quint64 stateHash( Game* game );
+
+	static int runHeadless( QString path );
+
+private:
+	static bool flush();
+	static bool load( QString path );
+	static void execute( const QVariantMap& command );
+
+	static bool m_recording;
+	static bool m_replaying;
+	static QString m_path;
+	static QString m_saveFolder;
+	static quint64 m_startTick;
+	static quint64 m_endTick;
+
+	static QVariantList m_commands;
+	static QVariantList m_checkpoints;
+	static int m_nextCommand;
+	static int m_nextCheckpoint;
+	static int m_desyncs;
+};
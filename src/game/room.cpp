@@ -24,6 +24,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../game/inventory.h"
 #include "../game/jobmanager.h"
@@ -532,7 +533,7 @@ Position Room::randomTilePos() const
 {
 	if ( m_fields.size() )
 	{
-		auto id = rand() % m_fields.size();
+		auto id = RNG::rand( RngStream::Gnomes ) % m_fields.size();
 		for ( auto rt : m_fields )
 		{
 			if ( id == 0 )
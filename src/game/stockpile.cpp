@@ -297,6 +297,17 @@ bool Stockpile::onTick( quint64 tick )
 	return false;
 }
 
+/// @brief Appends a newly loosened item to the candidate list. Skipped while a full
+///        refresh is pending, the refresh will find the item on its own.
+/// @param item UID of the item.
+void Stockpile::addPossibleItem( unsigned int item )
+{
+	if ( m_active && !m_filterChanged )
+	{
+		m_possibleItems.append( item );
+	}
+}
+
 /// @brief Returns the set of (itemSID, materialSID) pairs that could still be accepted
 ///        by at least one non-full field. "Any" wildcards are used for empty plain fields.
 /// @return Set of (itemSID, materialSID) pairs with available capacity.
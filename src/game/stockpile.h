@@ -96,6 +96,7 @@ class Stockpile : public WorldObject
 	bool onTick( quint64 tick );
 
 	QSet<QPair<QString, QString>> freeSlots() const;
+	void addPossibleItem( unsigned int item );
 
 	Filter filter()
 	{
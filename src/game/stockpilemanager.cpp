@@ -24,8 +24,10 @@
 
 #include "../base/config.h"
 #include "../base/global.h"
+#include "../game/inventory.h"
 #include "../game/job.h"
 #include "../game/stockpile.h"
+#include "../game/workshopmanager.h"
 #include "../game/world.h"
 
 #include <QDebug>
@@ -69,6 +71,71 @@ void StockpileManager::onTick( quint64 tick )
 			break;
 		}
 	}
+
+	distributeLooseItems();
+}
+
+/// @brief Rebuilds the inverted filter index if a stockpile was added, removed, reordered
+///        or had its filter changed since the last build.
+void StockpileManager::updateFilterIndex()
+{
+	bool stale = ( m_indexedOrder != m_stockpilesOrdered );
+	if ( !stale )
+	{
+		for ( auto stockpileID : m_stockpilesOrdered )
+		{
+			if ( m_indexedRevisions.value( stockpileID ) != m_stockpiles[stockpileID]->pFilter()->revision() )
+			{
+				stale = true;
+				break;
+			}
+		}
+	}
+	if ( !stale )
+	{
+		return;
+	}
+
+	m_stockpilesByFilter.clear();
+	m_indexedRevisions.clear();
+	for ( auto stockpileID : m_stockpilesOrdered )
+	{
+		Filter* filter = m_stockpiles[stockpileID]->pFilter();
+		for ( const auto& entry : filter->getActive() )
+		{
+			m_stockpilesByFilter[entry].append( stockpileID );
+		}
+		m_indexedRevisions.insert( stockpileID, filter->revision() );
+	}
+	m_indexedOrder = m_stockpilesOrdered;
+}
+
+/// @brief Hands items that became loose since the last tick to the stockpiles whose filter
+///        accepts them, so stockpiles don't have to search the inventory again for new items.
+void StockpileManager::distributeLooseItems()
+{
+	const auto items = g->inv()->takeNewLooseItems();
+	if ( items.isEmpty() )
+	{
+		return;
+	}
+	updateFilterIndex();
+
+	for ( auto itemID : items )
+	{
+		if ( !g->inv()->itemExists( itemID ) )
+		{
+			continue;
+		}
+		auto it = m_stockpilesByFilter.constFind( { g->inv()->itemSID( itemID ), g->inv()->materialSID( itemID ) } );
+		if ( it != m_stockpilesByFilter.constEnd() )
+		{
+			for ( auto stockpileID : it.value() )
+			{
+				m_stockpiles[stockpileID]->addPossibleItem( itemID );
+			}
+		}
+	}
 }
 
 /// @brief Creates a new stockpile from @p fields, or extends an existing one if @p firstClick
@@ -90,6 +157,7 @@ void StockpileManager::addStockpile( Position& firstClick, QList<QPair<Position,
 			}
 		}
 		m_lastAdded = spID;
+		g->wsm()->onStockpileChanged( spID );
 	}
 	else
 	{
@@ -137,6 +205,7 @@ void StockpileManager::removeStockpile( unsigned int id )
 	}
 	m_stockpiles.remove( id );
 	m_stockpilesOrdered.removeAll( id );
+	g->wsm()->onStockpileChanged( id );
 	emit signalStockpileDeleted( id );
 }
 
@@ -100,6 +100,15 @@ class StockpileManager : public QObject
 	QList<unsigned int> m_stockpilesOrdered;
 	QHash<unsigned int, unsigned int> m_allStockpileTiles;
 
+	// Inverted filter index: (itemSID, materialSID) → stockpiles accepting it, in priority order
+	QHash<QPair<QString, QString>, QList<unsigned int>> m_stockpilesByFilter;
+	// Stockpile order and filter revisions the index was built from
+	QList<unsigned int> m_indexedOrder;
+	QHash<unsigned int, unsigned int> m_indexedRevisions;
+
+	void updateFilterIndex();
+	void distributeLooseItems();
+
 	unsigned int m_lastAdded = 0;
 
 signals:
@@ -23,6 +23,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/global.h"
+#include "../base/profiler.h"
 #include "../base/util.h"
 
 #include "../game/game.h"
@@ -397,6 +398,13 @@ void Workshop::onTick( quint64 tick )
 			g->jm()->deleteJob( spJob->id() );
 			m_currentCraftJobID = 0;
 		}
+		// look at the queue again once the workshop is switched back on
+		m_wake = true;
+		return;
+	}
+
+	if ( !needsPass( tick ) )
+	{
 		return;
 	}
 
@@ -498,6 +506,76 @@ void Workshop::onTick( quint64 tick )
 	}
 }
 
+/**
+ * @brief Decides whether onTick() has to evaluate the craft queue this tick.
+ *
+ * The queue only needs another look when it was edited, when the stock of an item
+ * type it uses or makes changed, when the current job ended, or when the last look is
+ * older than recheckInterval, since reachability of ingredients can change without
+ * touching the stock. Butchers and fisheries also wait for animals and water, which
+ * have no such signal, and are always evaluated.
+ *
+ * @param tick Current game tick number.
+ * @return True if the queue has to be evaluated, the wake state is reset in that case.
+ */
+bool Workshop::needsPass( quint64 tick )
+{
+	const bool hasJob      = !m_job.isNull();
+	const quint64 revision = queueStockRevision();
+	const bool pollsAlways = m_properties.type == "Butcher" || m_properties.type == "Fishery";
+
+	if ( !m_wake && !pollsAlways && hasJob == m_hadJob && revision == m_seenStockRevision && tick < m_nextRecheck )
+	{
+		return false;
+	}
+	m_wake              = false;
+	m_hadJob            = hasJob;
+	m_seenStockRevision = revision;
+	m_nextRecheck       = tick + recheckInterval;
+	Profiler::count( ProfileCounter::WorkshopsWoken );
+	return true;
+}
+
+/**
+ * @brief Returns the latest stock revision of the item types the craft queue depends on.
+ *
+ * Covers the ingredients and the products of every queued craft job. All revisions come
+ * from one running counter, so the maximum moves whenever one of them does. While the
+ * output tile is full any item moved off it can free it, so the whole stock counts then.
+ *
+ * @return The revision to compare with the one seen at the last pass.
+ */
+quint64 Workshop::queueStockRevision()
+{
+	quint64 revision = m_outputBlocked ? g->inv()->stockRevision() : 0;
+
+	const auto track = [this, &revision]( CraftJob& cj ) {
+		if ( !cj.itemUID )
+		{
+			cj.itemUID = DBH::itemUID( cj.itemSID );
+		}
+		revision = qMax( revision, g->inv()->stockRevision( cj.itemUID, Inventory::anyMaterial ) );
+		for ( auto& ri : cj.requiredItems )
+		{
+			if ( !ri.itemUID )
+			{
+				ri.itemUID     = DBH::itemUID( ri.itemSID );
+				ri.materialUID = ri.materialSID == "any" ? Inventory::anyMaterial : DBH::materialUID( ri.materialSID );
+			}
+			revision = qMax( revision, g->inv()->stockRevision( ri.itemUID, ri.materialUID ) );
+		}
+	};
+	for ( auto& cj : m_jobList )
+	{
+		track( cj );
+	}
+	for ( auto& cj : m_autoCraftList )
+	{
+		track( cj );
+	}
+	return revision;
+}
+
 /**
  * @brief Checks whether the given position is one of this workshop's tiles.
  * @param pos Position to test.
@@ -517,6 +595,7 @@ bool Workshop::isOnTile( const Position& pos )
  */
 void Workshop::addJob( QString craftID, int mode, int number, QStringList mats )
 {
+	m_wake = true;
 	CraftJob cj;
 	cj.id              = GameState::createID();
 	cj.craftID         = craftID;
@@ -583,6 +662,7 @@ void Workshop::checkAutoGenerate( CraftJob cj )
  */
 bool Workshop::moveJob( unsigned int jobDefID, QString moveCmd )
 {
+	m_wake = true;
 	for ( int i = 0; i < m_jobList.size(); ++i )
 	{
 		if ( m_jobList[i].id == jobDefID )
@@ -633,6 +713,7 @@ bool Workshop::moveJob( unsigned int jobDefID, QString moveCmd )
  */
 void Workshop::moveJob( int pos, int newPos )
 {
+	m_wake = true;
 	m_jobList.move( pos, newPos );
 }
 
@@ -647,6 +728,7 @@ void Workshop::moveJob( int pos, int newPos )
  */
 bool Workshop::setJobParams( unsigned int craftJobID, int mode, int numToCraft, bool suspended, bool moveBack )
 {
+	m_wake = true;
 	for ( auto& cj : m_jobList )
 	{
 		if ( cj.id == craftJobID )
@@ -668,6 +750,7 @@ bool Workshop::setJobParams( unsigned int craftJobID, int mode, int numToCraft,
  */
 void Workshop::setJobSuspended( unsigned int jobDefID, bool suspended )
 {
+	m_wake = true;
 	for ( auto& cj : m_jobList )
 	{
 		if ( cj.id == jobDefID )
@@ -684,6 +767,7 @@ void Workshop::setJobSuspended( unsigned int jobDefID, bool suspended )
  */
 void Workshop::cancelJob( unsigned int jobDefID )
 {
+	m_wake = true;
 	for ( int i = 0; i < m_jobList.size(); ++i )
 	{
 		if ( m_jobList[i].id == jobDefID )
@@ -824,6 +908,7 @@ bool Workshop::autoCraft( QString itemSID, QString materialSID, int amount )
 	checkAutoGenerate( cj );
 
 	m_autoCraftList.push_back( cj );
+	m_wake = true;
 
 	return true;
 }
@@ -1122,8 +1207,14 @@ QSharedPointer<Job> Workshop::createFishButcherJob()
  */
 bool Workshop::checkItemsAvailable( CraftJob& cj )
 {
+	if ( availabilityCurrent( cj ) )
+	{
+		return cj.itemsAvailable;
+	}
+
 	// restrictions are already determined at CraftJob creation
-	//
+	// only the existence of enough reachable items is checked here, which items are used
+	// is decided when a gnome takes the job
 	bool allFound = true;
 	for ( int i = 0; i < cj.requiredItems.size(); ++i )
 	{
@@ -1134,7 +1225,9 @@ bool Workshop::checkItemsAvailable( CraftJob& cj )
 		QString materialID      = ri.materialSID;
 		bool requireSame        = ri.requireSame;
 
-		QList<unsigned int> items;
+		ri.itemUID       = DBH::itemUID( itemID );
+		ri.materialUID   = materialID == "any" ? Inventory::anyMaterial : DBH::materialUID( materialID );
+		ri.stockRevision = g->inv()->stockRevision( ri.itemUID, ri.materialUID );
 
 		if( materialID == "any" && requireSame )
 		{
@@ -1143,19 +1236,16 @@ bool Workshop::checkItemsAvailable( CraftJob& cj )
 			QList<QString> materials = g->inv()->materialsForItem( itemID, count );
 			for ( auto mat : materials )
 			{
-				items = g->inv()->getClosestItems( m_properties.posIn, true, itemID, mat, count );
-				if ( items.size() < count )
+				if ( g->inv()->checkReachableItems( m_properties.posIn, true, count, itemID, mat ) )
 				{
-					continue;
+					ri.avail = count;
+					break;
 				}
-				ri.avail = items.size();
-				break;
 			}
 		}
 		else
 		{
-			items = g->inv()->getClosestItems( m_properties.posIn, true, itemID, materialID, count );
-			ri.avail = items.size();
+			ri.avail = g->inv()->checkReachableItems( m_properties.posIn, true, count, ri.itemUID, ri.materialUID ) ? count : 0;
 		}
 
 		if( ri.avail < ri.amount )
@@ -1163,13 +1253,44 @@ bool Workshop::checkItemsAvailable( CraftJob& cj )
 			allFound = false;
 			if( Global::craftable.contains( itemID ) )
 			{
-				g->wsm()->autoGenCraftJob( itemID, materialID, count - items.size() );
+				g->wsm()->autoGenCraftJob( itemID, materialID, count - ri.avail );
 			}
 		}
 	}
+
+	cj.availabilityChecked = true;
+	cj.itemsAvailable      = allFound;
+	cj.availabilityTick    = GameState::tick;
+
 	return allFound;
 }
 
+/**
+ * @brief Checks whether the cached availability of a craft job is still valid.
+ *
+ * The result stays valid as long as the stock revision of every required item is unchanged.
+ * Reachability can change without touching the stock, so the result also expires after
+ * a while.
+ *
+ * @param cj The craft job.
+ * @return True if checkItemsAvailable() can return the cached result.
+ */
+bool Workshop::availabilityCurrent( const CraftJob& cj )
+{
+	if ( !cj.availabilityChecked || GameState::tick - cj.availabilityTick >= recheckInterval )
+	{
+		return false;
+	}
+	for ( const auto& ri : cj.requiredItems )
+	{
+		if ( g->inv()->stockRevision( ri.itemUID, ri.materialUID ) != ri.stockRevision )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 /**
  * @brief Handles completion of a craft job: updates crafted count, re-queues if repeating or not yet done, and triggers auto-generate for ingredients.
  * @param craftJobID Unique ID of the completed craft job.
@@ -1270,6 +1391,7 @@ bool Workshop::canDelete()
 
 void Workshop::setLinkedStockpile( bool link )
 {
+	m_wake = true;
 	if ( link )
 	{
 		m_properties.linkedStockpile = getPossibleStockpile();
@@ -1340,6 +1462,7 @@ bool Workshop::outputTileFree()
 	//TODO make number configurable
 
 	bool isFree = g->inv()->countItemsAtPos( pos ) < 20;
+	m_outputBlocked = !isFree;
 
 	if ( !isFree )
 	{
@@ -47,6 +47,10 @@ struct InputItem
 	int amount = 0;
 	bool requireSame = false;
 	int avail = 0;
+	// Inventory::stockRevision() at the last availability check and the UIDs it was read for, not saved
+	quint64 stockRevision      = 0;
+	unsigned short itemUID     = 0;
+	unsigned short materialUID = 0;
 };
 
 /** @brief Defines a single entry in a workshop's crafting queue, including recipe, mode, and required materials. */
@@ -74,6 +78,12 @@ struct CraftJob
 	bool moveToBackWhenDone = false; //move this job to the back of the queue when one item is finished
 	bool paused             = false;
 
+	// cached result of Workshop::checkItemsAvailable(), not saved
+	bool availabilityChecked = false;
+	bool itemsAvailable      = false;
+	quint64 availabilityTick = 0;
+	unsigned short itemUID   = 0; // UID of itemSID for Workshop::queueStockRevision(), not saved
+
 	CraftJob() {};
 	CraftJob( QVariantMap& in );
 	void serialize( QVariantMap& out );
@@ -281,6 +291,12 @@ class Workshop : public WorldObject
 
 	int numJobs() { return m_jobList.size(); }
 
+	/** @brief Makes the next onTick() do a full pass over the craft queue. */
+	void wake()
+	{
+		m_wake = true;
+	}
+
 private:
 	//only access through workshop manager
 	bool finishJob( unsigned int craftJobID );
@@ -297,9 +313,20 @@ class Workshop : public WorldObject
 	
 	QWeakPointer<Job> m_fishingJob;
 
+	// Craft queue evaluation is skipped while nothing it depends on has changed, not saved
+	static constexpr quint64 recheckInterval = 500; // ticks until reachability is checked again
+	bool m_wake                 = true;
+	bool m_hadJob               = false;
+	bool m_outputBlocked        = false;
+	quint64 m_seenStockRevision = 0;
+	quint64 m_nextRecheck       = 0;
+	bool needsPass( quint64 tick );
+	quint64 queueStockRevision();
+
 	QVariantList m_spriteComposition;
 
 	bool checkItemsAvailable( CraftJob& cj );
+	bool availabilityCurrent( const CraftJob& cj );
 
 	QList<QPair<unsigned int, QString>> m_toDye;
 };
@@ -80,6 +80,20 @@ void WorkshopManager::onTick( quint64 tick )
 	}
 }
 
+/// @brief Wakes the workshops linked to a stockpile that was resized or removed, so they
+///        check on their next tick whether the link is still valid.
+/// @param stockpileID ID of the changed stockpile.
+void WorkshopManager::onStockpileChanged( unsigned int stockpileID )
+{
+	for ( auto& w : m_workshops )
+	{
+		if ( w->linkedStockpile() == stockpileID )
+		{
+			w->wake();
+		}
+	}
+}
+
 /// @brief Creates and registers a new workshop of the given type.
 /// @param type     Workshop type string (DB key).
 /// @param pos      World position of the workshop's anchor tile.
@@ -76,6 +76,8 @@ class WorkshopManager : public QObject
 
 	void emitJobListChanged( unsigned int workshopID );
 
+	void onStockpileChanged( unsigned int stockpileID );
+
 private:
 	QPointer<Game> g;
 
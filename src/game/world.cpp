@@ -29,6 +29,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/position.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 #include "../base/vptr.h"
 #include "../game/game.h"
@@ -49,6 +50,7 @@
 #include <QJsonDocument>
 #include <QVector3D>
 
+#include <cmath>
 #include <random>
 #include <time.h>
 
@@ -66,6 +68,8 @@ World::World( int dimX, int dimY, int dimZ, Game* game ) :
 	m_dimZ( dimZ ),
 	m_regionMap( this )
 {
+	m_plantWheel.resize( plantWheelSize );
+
 	m_constructionSID2ENUM.insert( "Wall", CID_WALL );
 	m_constructionSID2ENUM.insert( "FancyWall", CID_FANCYWALL );
 	m_constructionSID2ENUM.insert( "Fence", CID_FENCE );
@@ -709,6 +713,104 @@ void World::removePlant( Plant plant )
 	m_plants.remove( plant.getPos().toInt() );
 }
 
+/**
+ * @brief Advances the plants whose growth check is due this tick and applies the season rules on season change.
+ *
+ * Only the wheel bucket of the current tick is visited. On a season change the rules of
+ * every species are evaluated once and then all plants are swept with them.
+ */
+void World::processPlants()
+{
+	++m_plantGrowthTicks;
+	if ( GameState::daylight )
+	{
+		++m_plantDaylightTicks;
+	}
+
+	QList<Position> toRemove;
+	if ( GameState::seasonChanged )
+	{
+		for ( auto& rules : m_plantSeasonRules )
+		{
+			rules.evaluate( GameState::seasonString );
+		}
+		for ( auto& p : m_plants )
+		{
+			if ( p.onSeasonChanged( m_plantSeasonRules[p.species()] ) == OnTickReturn::DESTROY )
+			{
+				toRemove.push_back( p.getPos() );
+			}
+		}
+	}
+
+	const quint64 tick = GameState::tick;
+	auto& bucket       = m_plantWheel[tick % plantWheelSize];
+	if ( !bucket.empty() )
+	{
+		m_plantsDue.clear();
+		m_plantsDue.swap( bucket );
+
+		for ( const auto& event : m_plantsDue )
+		{
+			if ( event.tick > tick )
+			{
+				bucket.push_back( event );
+				continue;
+			}
+			Plant* plant = m_plants.find( event.tileID );
+			if ( !plant || plant->nextGrowthCheck() != event.tick )
+			{
+				continue;
+			}
+			if ( plant->onGrowthDue() == OnTickReturn::DESTROY )
+			{
+				toRemove.push_back( plant->getPos() );
+			}
+		}
+	}
+
+	for ( auto p : toRemove )
+	{
+		removePlant( p );
+	}
+}
+
+/**
+ * @brief Books a growth check for the plant on a tile.
+ * @param tileID Flat index of the plant's root tile.
+ * @param tick Tick the check is due on.
+ */
+void World::schedulePlant( unsigned int tileID, quint64 tick )
+{
+	m_plantWheel[tick % plantWheelSize].push_back( { tileID, tick } );
+}
+
+/**
+ * @brief Returns the index of a plant species, reading its season rules from the database on first use.
+ * @param plantID Plant type string ID from the Plants database.
+ * @return Index into the season rules table.
+ */
+unsigned short World::plantSpecies( QString plantID )
+{
+	auto it = m_plantSpecies.constFind( plantID );
+	if ( it != m_plantSpecies.constEnd() )
+	{
+		return it.value();
+	}
+
+	QVariantMap row = DB::selectRow( "Plants", plantID );
+	PlantSeasonRules rules;
+	rules.growsInSeason      = row.value( "GrowsInSeason" ).toString().split( "|" );
+	rules.killedInSeason     = row.value( "IsKilledInSeason" ).toString();
+	rules.losesFruitInSeason = row.value( "LosesFruitInSeason" ).toString();
+	rules.evaluate( GameState::seasonString );
+
+	const unsigned short species = (unsigned short)m_plantSeasonRules.size();
+	m_plantSeasonRules.push_back( rules );
+	m_plantSpecies.insert( plantID, species );
+	return species;
+}
+
 /**
  * @brief Reduces the growth level of the plant at the given position by one step.
  * @param pos World position of the plant.
@@ -773,70 +875,97 @@ void World::insertCreatureAtPosition( Position pos, unsigned int creatureID )
 }
 
 /**
- * @brief Tick-based grass growth simulation: randomly grows grass on candidate dirt tiles near existing grass.
+ * @brief Tick-based grass growth simulation: grows grass on the candidate dirt tiles whose growth attempt is due this tick.
+ *
+ * Only the wheel bucket of the current tick is visited. Events that share the bucket
+ * but belong to a later turn of the wheel are put back.
  */
 void World::processGrass()
 {
-	QList<Position> toRemove;
+	const quint64 tick = GameState::tick;
+	auto& bucket       = m_grassWheel[tick % grassWheelSize];
+	if ( bucket.empty() )
+	{
+		return;
+	}
+	m_grassDue.clear();
+	m_grassDue.swap( bucket );
+
 	unsigned short dirtUID = Global::dirtUID;
-	for ( auto pi : m_grassCandidatePositions )
+	for ( const auto& event : m_grassDue )
 	{
-		if ( m_grass.contains( pi ) )
+		if ( event.tick > tick )
 		{
-			toRemove.append( pi );
+			bucket.push_back( event );
+			continue;
 		}
-		else
+		m_grassCandidates.reset( event.tileID );
+		if ( m_grass.test( event.tileID ) )
 		{
-			Position p( pi );
+			continue;
+		}
+		Position p( event.tileID );
 
-			if ( rand() % 300 > 298 )
+		Tile& tile = getTile( p );
+		if ( tile.floorMaterial == dirtUID && tile.floorType & FT_SOLIDFLOOR && tile.flags & TileFlag::TF_SUNLIGHT )
+		{
+			if ( tile.wallType & WT_RAMP && tile.wallMaterial == dirtUID )
 			{
-				Tile& tile = getTile( p );
-				if ( tile.floorMaterial == dirtUID && tile.floorType & FT_SOLIDFLOOR && tile.flags & TileFlag::TF_SUNLIGHT )
-				{
-					if ( tile.wallType & WT_RAMP && tile.wallMaterial == dirtUID )
-					{
-						setTileFlag( p, TileFlag::TF_GRASS );
-						createRamp( p );
-						addToUpdateList( p );
+				setTileFlag( p, TileFlag::TF_GRASS );
+				createRamp( p );
+				addToUpdateList( p );
 
-						auto pa = p.aboveOf();
-						addToUpdateList( pa );
+				auto pa = p.aboveOf();
+				addToUpdateList( pa );
 
-						isGrassCandidate( pa.northOf() );
-						isGrassCandidate( pa.eastOf() );
-						isGrassCandidate( pa.southOf() );
-						isGrassCandidate( pa.westOf() );
-					}
-					else
-					{
-						createGrass( p );
-						addToUpdateList( p );
-					}
-				}
-				toRemove.append( p );
-
-				isGrassCandidate( p.northOf() );
-				isGrassCandidate( p.eastOf() );
-				isGrassCandidate( p.southOf() );
-				isGrassCandidate( p.westOf() );
+				isGrassCandidate( pa.northOf() );
+				isGrassCandidate( pa.eastOf() );
+				isGrassCandidate( pa.southOf() );
+				isGrassCandidate( pa.westOf() );
+			}
+			else
+			{
+				createGrass( p );
+				addToUpdateList( p );
 			}
 		}
+
+		isGrassCandidate( p.northOf() );
+		isGrassCandidate( p.eastOf() );
+		isGrassCandidate( p.southOf() );
+		isGrassCandidate( p.westOf() );
 	}
-	for ( auto p : toRemove )
-	{
-		m_grassCandidatePositions.remove( p.toInt() );
-	}
 }
 
 /**
- * @brief Scans all tiles to build the initial grass set and candidate positions for grass growth.
+ * @brief Puts the next growth attempt of a candidate tile on the timer wheel.
+ *
+ * A candidate used to roll a 1 in 300 chance every tick. The number of ticks until
+ * the first success of that roll is geometrically distributed, so it is drawn once
+ * here instead. The distribution has no memory, which is why the wheel is not part
+ * of the save game: rescheduling all candidates on load gives the same odds.
+ *
+ * @param tileID Flat index of the candidate tile.
+ */
+void World::scheduleGrass( unsigned int tileID )
+{
+	static const double logMiss = std::log( 1.0 - 1.0 / 300.0 );
+
+	const double u    = ( RNG::rand( RngStream::Grass ) + 1.0 ) / ( RNG::max + 1.0 );
+	const quint64 due = GameState::tick + 1 + (quint64)( std::log( u ) / logMiss );
+	m_grassWheel[due % grassWheelSize].push_back( { tileID, due } );
+}
+
+/**
+ * @brief Scans all tiles to build the initial grass set and schedules the candidate positions for grass growth.
  */
 void World::initGrassUpdateList()
 {
-	m_grass.clear();
-	m_grassCandidatePositions.clear();
+	m_grass.resize( m_world.size() );
+	m_grassCandidates.resize( m_world.size() );
+	m_grassWheel.assign( grassWheelSize, {} );
 
+	std::vector<unsigned int> grassTiles;
 	for ( int z = m_dimZ - 2; z >= 0; --z )
 	{
 		for ( int y = 0; y < m_dimY; ++y )
@@ -847,14 +976,16 @@ void World::initGrassUpdateList()
 				if ( (bool)( here.flags & TileFlag::TF_GRASS ) )
 				{
 					Position pos( x, y, z );
-					m_grass.insert( pos );
+					m_grass.set( pos.toInt() );
+					grassTiles.push_back( pos.toInt() );
 				}
 			}
 		}
 	}
 
-	for ( auto p : m_grass )
+	for ( auto id : grassTiles )
 	{
+		Position p( id );
 		isGrassCandidate( p.northOf() );
 		isGrassCandidate( p.eastOf() );
 		isGrassCandidate( p.southOf() );
@@ -863,16 +994,19 @@ void World::initGrassUpdateList()
 }
 
 /**
- * @brief Evaluates whether a tile is a valid candidate for grass growth and adds it to the candidate set.
+ * @brief Evaluates whether a tile is a valid candidate for grass growth and schedules it if it is not scheduled yet.
  * @param pos World position to evaluate.
  */
 void World::isGrassCandidate( Position pos )
 {
 	Tile& tile = getTile( pos );
 
-	if ( ( tile.floorType & FT_SOLIDFLOOR ) && ( tile.floorMaterial == Global::dirtUID ) && ( ( tile.wallType == WT_NOWALL ) || ( tile.wallType == WT_RAMP ) ) && !m_grass.contains( pos.toInt() ) )
+	if ( ( tile.floorType & FT_SOLIDFLOOR ) && ( tile.floorMaterial == Global::dirtUID ) && ( ( tile.wallType == WT_NOWALL ) || ( tile.wallType == WT_RAMP ) ) && !m_grass.test( pos.toInt() ) )
 	{
-		m_grassCandidatePositions.insert( pos.toInt() );
+		if ( m_grassCandidates.set( pos.toInt() ) )
+		{
+			scheduleGrass( pos.toInt() );
+		}
 	}
 }
 
@@ -893,10 +1027,8 @@ void World::removeGrass( Position pos )
 {
 	clearTileFlag( pos, TileFlag::TF_GRASS );
 
-	if ( m_grass.contains( pos.toInt() ) )
+	if ( m_grass.reset( pos.toInt() ) )
 	{
-		m_grass.remove( pos.toInt() );
-
 		Tile& tile           = getTile( pos );
 		tile.vegetationLevel = 0;
 		QString materialSID  = DBH::materialSID( tile.floorMaterial );
@@ -905,7 +1037,10 @@ void World::removeGrass( Position pos )
 		{
 			//if( Global::debugMode ) qDebug() << "add grass candidate at " << pos.toString();
 			tile.floorSpriteUID = g->sf()->createSprite( "RoughFloor", { "Dirt" } )->uID;
-			m_grassCandidatePositions.insert( pos.toInt() );
+			if ( m_grassCandidates.set( pos.toInt() ) )
+			{
+				scheduleGrass( pos.toInt() );
+			}
 		}
 	}
 
@@ -927,7 +1062,7 @@ void World::createGrass( Position pos )
 	Tile& tile          = getTile( pos );
 	tile.floorSpriteUID = g->sf()->createSprite( "GrassWithDetail", { "Grass", "None" } )->uID;
 
-	m_grass.insert( pos );
+	m_grass.set( pos.toInt() );
 	setTileFlag( pos, TileFlag::TF_GRASS );
 	tile.vegetationLevel = 100;
 }
@@ -1087,8 +1222,8 @@ void World::processWaterFlow()
 	QVector<unsigned int> drain;
 	QVector<unsigned int> flood;
 
-	// Random numbers are expensive, and rand() only delivers 15bit of entropy per call
-	auto seedBase = rand() ^ rand() << 10 ^ rand() << 20;
+	// One draw per pass, the per-tile seeds are derived from it
+	auto seedBase = RNG::rand( RngStream::Water );
 	for ( const auto& currentPos : m_water )
 	{
 		Tile& here = getTile( currentPos );
@@ -2079,7 +2214,7 @@ void World::setDoorLocked( unsigned int tileUID, bool lockGnome, bool lockMonste
 	{
 		setTileFlag( pos, TileFlag::TF_WALKABLEANIMALS );
 	}
-	m_regionMap.updateConnectedRegions( pos );
+	m_regionMap.updatePosition( pos );
 }
 
 /**
@@ -2147,14 +2282,35 @@ void World::moveLight( unsigned int id, Position pos, int intensity )
 }
 
 /**
- * @brief Recalculates all lights that may be affected by a change at the given position.
+ * @brief Queues the lights that may be affected by a change at the given position for recalculation.
+ *
+ * Light levels only matter for rendering, so the lights are recalculated once per
+ * tick in applyTileUpdates(), after all changes of the tick are done.
+ *
  * @param pos World position that changed (e.g., a wall was added or removed).
  */
 void World::updateLightsInRange( Position pos )
 {
-	QSet<unsigned int> ul;
-	m_lightMap.updateLight( ul, m_world, pos );
-	addToUpdateList( ul );
+	m_lightUpdates.push_back( pos );
+}
+
+/**
+ * @brief Applies the tile changes buffered during the tick in one batch.
+ *
+ * Recalculates every light touched by a changed tile once and applies the queued
+ * region map updates. Called at the end of every tick and before the changed tiles
+ * are handed to the renderer, so changes made while the game is paused show up too.
+ */
+void World::applyTileUpdates()
+{
+	if ( !m_lightUpdates.empty() )
+	{
+		QSet<unsigned int> ul;
+		m_lightMap.updateLights( ul, m_world, m_lightUpdates );
+		m_lightUpdates.clear();
+		addToUpdateList( ul );
+	}
+	m_regionMap.applyUpdates();
 }
 
 /**
@@ -32,7 +32,10 @@
 #include "../base/lightmap.h"
 #include "../base/regionmap.h"
 #include "../base/tile.h"
+#include "../base/tilebitset.h"
+#include "plant.h"
 
+#include <QHash>
 #include <QMutex>
 #include <QPixmap>
 #include <QSet>
@@ -40,7 +43,6 @@
 #include <set>
 #include <vector>
 
-class Plant;
 class Animal;
 class Creature;
 class Game;
@@ -105,20 +107,44 @@ class World
 
 	bool m_grassChanged = false;
 
+	// dense, uniform levels of world.dat are expanded on load because callers hold Tile& into it
 	std::vector<Tile> m_world;
 
-	QMap<unsigned int, Plant> m_plants;
+	PlantStore m_plants;
 	QMap<unsigned int, QList<unsigned int>> m_creaturePositions;
 	QMap<unsigned int, QVariantMap> m_wallConstructions;
 	QMap<unsigned int, QVariantMap> m_floorConstructions;
-	QSet<Position> m_grass;
-	QSet<unsigned int> m_grassCandidatePositions;
+	TileBitset m_grass;
+	TileBitset m_grassCandidates;
+
+	/// A tile and the tick something is due on it
+	struct TileEvent
+	{
+		unsigned int tileID;
+		quint64 tick;
+	};
+	/// Timer wheel of grass growth attempts, bucket index is the tick modulo the wheel size
+	static constexpr unsigned int grassWheelSize = 2048;
+	std::vector<std::vector<TileEvent>> m_grassWheel;
+	std::vector<TileEvent> m_grassDue;
+
+	/// Timer wheel of plant growth checks, an entry is stale when its plant has booked another tick since
+	static constexpr unsigned int plantWheelSize = 4096;
+	std::vector<std::vector<TileEvent>> m_plantWheel;
+	std::vector<TileEvent> m_plantsDue;
+	/// Ticks processed and ticks with daylight, plants credit their growth from the difference between visits
+	quint64 m_plantGrowthTicks   = 0;
+	quint64 m_plantDaylightTicks = 0;
+	std::vector<PlantSeasonRules> m_plantSeasonRules;
+	QHash<QString, unsigned short> m_plantSpecies;
 	QMap<unsigned int, QVariantMap> m_jobSprites;
 	std::set<unsigned int> m_water;
 	QList<Position> m_aquifiers;
 	QList<Position> m_deaquifiers;
 
 	QSet<unsigned int> m_updatedTiles;
+	/// Tiles whose lights need to be recalculated, applied by applyTileUpdates()
+	std::vector<Position> m_lightUpdates;
 
 	QMap<QString, CONSTRUCTION_ID> m_constructionSID2ENUM;
 	QMap<QString, CONSTR_ITEM_ID> m_constrItemSID2ENUM;
@@ -133,6 +159,8 @@ class World
 	bool constructPipe( QString type, Position pos, unsigned int itemUID );
 	bool deconstructPipe( QVariantMap constr, Position pos, Position workPos );
 
+	void scheduleGrass( unsigned int tileID );
+
 	
 
 public:
@@ -218,7 +246,7 @@ class World
 	int walkableNeighbors( Position pos );
 	QList<Position> connectedNeighbors( Position pos );
 
-	QMap<unsigned int, Plant>& plants()
+	PlantStore& plants()
 	{
 		return m_plants;
 	}
@@ -240,6 +268,22 @@ class World
 	void expelTileInhabitants( Position pos, Position& to );
 	void expelTileItems( Position pos, Position& to );
 
+	void processPlants();
+	void schedulePlant( unsigned int tileID, quint64 tick );
+	unsigned short plantSpecies( QString plantID );
+	const PlantSeasonRules& plantSeasonRules( unsigned short species ) const
+	{
+		return m_plantSeasonRules[species];
+	}
+	quint64 plantGrowthTicks() const
+	{
+		return m_plantGrowthTicks;
+	}
+	quint64 plantDaylightTicks() const
+	{
+		return m_plantDaylightTicks;
+	}
+
 	void plantTree( Position pos, QString type, bool fullyGrown = false );
 	void plantMushroom( Position pos, QString type, bool fullyGrown = false );
 	void plant( Position pos, unsigned int baseItem );
@@ -310,6 +354,7 @@ class World
 	bool noShroom( const Position pos, const int xRange, const int yRange );
 
 	QSet<unsigned int> updatedTiles();
+	void applyTileUpdates();
 	void addToUpdateList( const unsigned int uID );
 	void addToUpdateList( const Position pos );
 	void addToUpdateList( const unsigned short x, const unsigned short y, const unsigned short z );
@@ -1260,7 +1260,7 @@ bool World::constructItem( QString itemSID, Position pos, int rotation, QList<un
 }
 
 /**
- * @brief Expels inhabitants and items from modified tiles, then updates region map connectivity.
+ * @brief Expels inhabitants and items from modified tiles, then queues the region map updates.
  * @param coords List of positions that were modified by a construction or deconstruction.
  * @param extractTo Position where expelled items and creatures are moved to.
  */
@@ -1272,14 +1272,11 @@ void World::updateNavigation( QList<Position>& coords, Position extractTo )
 		expelTileItems( p, extractTo );
 	}
 
+	// walkability and vertical connections of all tiles are applied together
 	for ( auto p : coords )
 	{
 		m_regionMap.updatePosition( p );
 	}
-	for ( auto p : coords )
-	{
-		m_regionMap.updateConnectedRegions( p );
-	}
 }
 
 /**
@@ -27,6 +27,7 @@
 #include "../base/gamestate.h"
 #include "../base/global.h"
 #include "../base/position.h"
+#include "../base/rng.h"
 #include "../game/game.h"
 #include "../game/creaturefactory.h"
 #include "../game/creaturemanager.h"
@@ -91,6 +92,9 @@ World* WorldGenerator::generateTopology()
 
 	m_seed = ngs->seed().toInt();
 	m_random.SetSeed( m_seed );
+	// the same seed gives the same world, and the session streams start from it
+	GameState::seed = ngs->seed();
+	RNG::seed( m_seed );
 	m_random.SetFrequency( (FN_DECIMAL)0.02 );
 	m_random.SetFractalOctaves( 1 );
 	m_random.SetFractalLacunarity( 2 );
@@ -397,10 +401,10 @@ void WorldGenerator::addPlantsAndTrees()
 				Position pos( x_, y_, m_mushroomLevel + 5 );
 				w->getFloorLevelBelow( pos, false );
 
-				int random = rand();
+				int random = RNG::rand( RngStream::World );
 				if ( random % treeDensity == 0 || shroomRejected )
 				{
-					int ra = rand() % largeShrooms.size();
+					int ra = RNG::rand( RngStream::World ) % largeShrooms.size();
 					if ( w->getTile( pos ).wallType == WallType::WT_NOWALL && Plant::testLayoutMulti( largeShrooms[ra], pos, g ) && !( w->getTileFlag( pos ) & TileFlag::TF_WATER ) )
 					{
 						w->plantMushroom( pos, largeShrooms[ra], true );
@@ -420,10 +424,10 @@ void WorldGenerator::addPlantsAndTrees()
 				Position pos( x_, y_, m_mushroomLevel + 5 );
 				w->getFloorLevelBelow( pos, false );
 
-				int random = rand();
+				int random = RNG::rand( RngStream::World );
 				if ( random % treeDensity == 0 || shroomRejected )
 				{
-					int ra = rand() % smallShrooms.size();
+					int ra = RNG::rand( RngStream::World ) % smallShrooms.size();
 					if ( w->getTile( pos ).wallType == WallType::WT_NOWALL && w->noShroom( pos, 2, 2 ) && !( w->getTileFlag( pos ) & TileFlag::TF_WATER ) )
 					{
 						w->plantMushroom( pos, smallShrooms[ra], true );
@@ -457,12 +461,12 @@ void WorldGenerator::addPlantsAndTrees()
 				Position pos( x_, y_, m_dimZ - 2 );
 				w->getFloorLevelBelow( pos, false );
 
-				int random = rand();
+				int random = RNG::rand( RngStream::World );
 				if ( random % treeDensity == 0 || treeRejected )
 				{
 					if ( trees.size() )
 					{
-						int ra = rand() % trees.size();
+						int ra = RNG::rand( RngStream::World ) % trees.size();
 						if ( w->getTile( pos ).wallType == WallType::WT_NOWALL && Plant::testLayoutMulti( trees[ra], pos, g ) && !( w->getTileFlag( pos ) & TileFlag::TF_WATER ) )
 						{
 							w->plantTree( pos, trees[ra], true );
@@ -492,12 +496,12 @@ void WorldGenerator::addPlantsAndTrees()
 				Position pos( x_, y_, m_dimZ - 2 );
 				w->getFloorLevelBelow( pos, false );
 
-				int random = rand();
+				int random = RNG::rand( RngStream::World );
 				if ( random % plantDensity == 0 )
 				{
 					if ( plants.size() )
 					{
-						int ra = rand() % plants.size();
+						int ra = RNG::rand( RngStream::World ) % plants.size();
 						if ( w->getTile( pos ).wallType == WallType::WT_NOWALL && w->noTree( pos, 0, 0 ) && !( w->getTileFlag( pos ) & TileFlag::TF_WATER ) )
 						{
 							Plant plant( pos, plants[ra], true, g );
@@ -566,8 +570,8 @@ void WorldGenerator::addAnimals()
 		int numFoxes  = 0;
 		while ( i < numAnimals )
 		{
-			int x = qMax( 2, ( rand() % m_dimX ) - 2 );
-			int y = qMax( 2, ( rand() % m_dimY ) - 2 );
+			int x = qMax( 2, ( RNG::rand( RngStream::World ) % m_dimX ) - 2 );
+			int y = qMax( 2, ( RNG::rand( RngStream::World ) % m_dimY ) - 2 );
 
 			Position pos( x, y, m_dimZ - 2 );
 			w->getFloorLevelBelow( pos, false );
@@ -582,27 +586,27 @@ void WorldGenerator::addAnimals()
 				{
 					if ( numWaterTypes > 0 )
 					{
-						int randomType = rand() % ( numWaterTypes );
+						int randomType = RNG::rand( RngStream::World ) % ( numWaterTypes );
 						QString type   = waterKeys[randomType];
 
 						int count = countPerType.value( type );
 						if ( count < ngs->globalMaxPerType() && count < ngs->maxAnimalsPerType( type ) )
 						{
-							g->cm()->addCreature( CreatureType::ANIMAL, type, pos, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
+							g->cm()->addCreature( CreatureType::ANIMAL, type, pos, RNG::rand( RngStream::World ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
 							countPerType.insert( type, count + 1 );
 						}
 					}
 				}
 				else
 				{
-					int randomType = rand() % ( numTypes );
+					int randomType = RNG::rand( RngStream::World ) % ( numTypes );
 					QString type   = keys[randomType];
 
 					int count = countPerType.value( type );
 
 					if ( count < ngs->globalMaxPerType() && count < ngs->maxAnimalsPerType( type ) )
 					{
-						g->cm()->addCreature( CreatureType::ANIMAL, type, pos, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
+						g->cm()->addCreature( CreatureType::ANIMAL, type, pos, RNG::rand( RngStream::World ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
 						countPerType.insert( type, count + 1 );
 					}
 				}
@@ -619,15 +623,15 @@ void WorldGenerator::addAnimals()
 			Position pos( x_, y_, m_mushroomLevel + 5 );
 			w->getFloorLevelBelow( pos, false );
 
-			int random = rand();
+			int random = RNG::rand( RngStream::World );
 			if ( random % 100 > 96 )
 			{
 				if ( w->isWalkable( pos ) )
 				{
-					int randomType = rand() % ( mushroomKeys.size() );
+					int randomType = RNG::rand( RngStream::World ) % ( mushroomKeys.size() );
 					QString type   = mushroomKeys[randomType];
 
-					g->cm()->addCreature( CreatureType::ANIMAL, type, pos, rand() % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
+					g->cm()->addCreature( CreatureType::ANIMAL, type, pos, RNG::rand( RngStream::World ) % 2 == 0 ? Gender::MALE : Gender::FEMALE, true, false );
 				}
 			}
 		}
@@ -832,7 +836,7 @@ QString WorldGenerator::getRandomMaterial( QString itemSID )
 	}
 	if ( out.size() )
 	{
-		return out[rand() % out.size()];
+		return out[RNG::rand( RngStream::World ) % out.size()];
 	}
 	else
 	{
@@ -1290,13 +1294,12 @@ QString WorldGenerator::getRandomEmbedded( int x, int y, int z, QMap<QString, Em
 ///        according to the ocean size setting. Also creates a sandy beach transition zone.
 void WorldGenerator::createOceanFront()
 {
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
 
 	auto& world = w->world();
 
 	int size = ngs->oceanSize();
 
-	int edge = rand() % 4;
+	int edge = RNG::rand( RngStream::World ) % 4;
 
 	int xStart = 1;
 	int yStart = 1;
@@ -252,13 +252,12 @@ Creature* World::firstCreatureAtPos( unsigned int posID, quint8& rotation )
 }
 
 /**
- * @brief Sets or clears the walkable flag on a tile and updates the region map.
+ * @brief Sets or clears the walkable flag on a tile, the flag setters queue the region map update.
  * @param pos World position.
  * @param value True to mark walkable, false to mark unwalkable.
  */
 void World::setWalkable( Position pos, bool value )
 {
-	Tile& tile = getTile( pos );
 	if ( value )
 	{
 		setTileFlag( pos, TileFlag::TF_WALKABLE );
@@ -267,11 +266,13 @@ void World::setWalkable( Position pos, bool value )
 	{
 		clearTileFlag( pos, TileFlag::TF_WALKABLE );
 	}
-	updateWalkable( pos );
 }
 
 /**
  * @brief Notifies the region map that the walkability of a tile may have changed.
+ *
+ * The update is queued and applied once per tile, see RegionMap::applyUpdates().
+ *
  * @param pos World position to update.
  */
 void World::updateWalkable( Position pos )
@@ -403,6 +404,8 @@ bool World::noShroom( const Position pos, const int xRange, const int yRange )
  */
 QSet<unsigned int> World::updatedTiles()
 {
+	applyTileUpdates();
+
 	QMutexLocker lock( &m_updateMutex );
 	QSet<unsigned int> ret;
 	ret.swap( m_updatedTiles );
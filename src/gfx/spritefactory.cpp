@@ -26,6 +26,7 @@
 #include "../base/db.h"
 #include "../base/gamestate.h"
 #include "../base/io.h"
+#include "../base/rng.h"
 #include "../base/util.h"
 
 #include <QDebug>
@@ -1183,7 +1184,7 @@ void SpriteFactory::getBaseSpriteDryRun( const DefNode* node, const QString item
 		{
 			if ( weights.contains( 0 ) )
 			{
-				randomNumber = rand() % node->childs.size();
+				randomNumber = RNG::rand( RngStream::Sprites ) % node->childs.size();
 				m_randomNumbers.insert( node->childPos.toInt(), randomNumber );
 			}
 			else
@@ -1191,7 +1192,7 @@ void SpriteFactory::getBaseSpriteDryRun( const DefNode* node, const QString item
 				int sum = 0;
 				for ( auto w : weights )
 					sum += w;
-				int ran   = rand() % sum;
+				int ran   = RNG::rand( RngStream::Sprites ) % sum;
 				int total = 0;
 				for ( int i = 0; i < weights.size(); ++i )
 				{
@@ -78,7 +78,7 @@ void AggregatorAgri::init( Game* game )
 			gp.materialID    = plantRow.value( "Material" ).toString();
 			gp.seedCount     = 0;
 			gp.harvestedItem = DB::select( "ItemID", "Plants_OnHarvest_HarvestedItem", key ).toString();
-			gp.name          = S::s( "$MaterialName_" + gp.materialID );
+			gp.name          = S::materialName( gp.materialID );
 			gp.sprite		 = Global::util->smallPixmap( g->sf()->createSprite( gp.harvestedItem, { gp.materialID } ), GameState::seasonString, 0 );
 			m_globalPlantInfo.append( gp );
 
@@ -101,7 +101,7 @@ void AggregatorAgri::init( Game* game )
 			gp.sprite        = Global::util->smallPixmap( g->sf()->createSprite( plantRow.value( "ToolButtonSprite" ).toString(), { gp.materialID } ), GameState::seasonString, 0 );
 			gp.seedCount     = 0;
 			gp.harvestedItem = DB::select( "ItemID", "Plants_OnHarvest_HarvestedItem", key ).toString();
-			gp.name          = S::s( "$MaterialName_" + gp.materialID );
+			gp.name          = S::materialName( gp.materialID );
 			
 
 			m_globalTreeInfo.append( gp );
@@ -325,7 +325,7 @@ void AggregatorAgri::onUpdatePasture( unsigned int id )
 
 					for( auto mat : mats )
 					{
-						QString name = S::s( "$MaterialName_" + mat ) + " " + S::s( "$ItemName_" + food );
+						QString name = S::materialName( mat ) + " " + S::itemName( food );
 						GuiPastureFoodItem pfi;
 						pfi.itemSID = food;
 						pfi.materialSID = mat;
@@ -598,7 +598,7 @@ void AggregatorAgri::onRequestProductInfo( AgriType type, unsigned int designati
 						gp.harvestedItem = DB::select( "ItemID", "Plants_OnHarvest_HarvestedItem", m_farmInfo.plantType ).toString();
 						gp.itemCount     = g->inv()->itemCount( gp.plantID, gp.materialID );
 
-						gp.name = S::s( "$MaterialName_" + gp.materialID );
+						gp.name = S::materialName( gp.materialID );
 
 						gp.sprite = Global::util->smallPixmap( g->sf()->createSprite( gp.harvestedItem, { gp.materialID } ), GameState::seasonString, 0 );
 					}
@@ -679,7 +679,7 @@ void AggregatorAgri::onRequestProductInfo( AgriType type, unsigned int designati
 						gp.harvestedItem = DB::select( "ItemID", "Plants_OnHarvest_HarvestedItem", m_groveInfo.treeType ).toString();
 						gp.itemCount     = g->inv()->itemCount( gp.harvestedItem, gp.materialID );
 
-						gp.name     = S::s( "$MaterialName_" + gp.materialID );
+						gp.name     = S::materialName( gp.materialID );
 
 						auto pm = Global::util->smallPixmap( g->sf()->createSprite( plantRow.value( "ToolButtonSprite" ).toString(), { gp.materialID } ), GameState::seasonString, 0 );
 						gp.sprite = pm;
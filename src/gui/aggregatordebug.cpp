@@ -23,6 +23,8 @@
 
 #include "../base/db.h"
 #include "../base/global.h"
+#include "../base/io.h"
+#include "../base/profiler.h"
 #include "../base/util.h"
 #include "../game/game.h"
 #include "../game/gnome.h"
@@ -280,3 +282,23 @@ void AggregatorDebug::onSetDisableNeedDecay( QString need, bool disable )
 	}
 	qDebug() << "Need decay for" << need << ( disable ? "disabled" : "enabled" );
 }
+
+/// @brief Emits per-subsystem tick time percentiles (P50/P90/P99/Max in ms) over the most
+///        recent ticks, as collected by the Profiler.
+/// @param numTicks Number of recent ticks to evaluate (clamped to the profiler capacity).
+void AggregatorDebug::onRequestProfile( int numTicks )
+{
+	emit signalProfile( Profiler::percentiles( numTicks ) );
+}
+
+/// @brief Writes the recorded tick timeline as Chrome trace JSON (loads in chrome://tracing
+///        and Perfetto). An empty path writes profile.json into the data folder.
+/// @param path Output file path.
+void AggregatorDebug::onExportProfile( QString path )
+{
+	if ( path.isEmpty() )
+	{
+		path = IO::getDataFolder() + "/profile.json";
+	}
+	Profiler::exportChromeTrace( path );
+}
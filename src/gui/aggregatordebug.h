@@ -17,7 +17,7 @@
 */
 /** @file aggregatordebug.h
  *  @brief Aggregator exposing debug/cheat commands to the XAML debug window: spawn creatures
- *         and items, set needs, kill gnomes, and tune need-decay multipliers.
+ *         and items, set needs, kill gnomes, tune need-decay multipliers, and read the tick profiler.
  */
 #pragma once
 
@@ -53,6 +53,8 @@ public slots:
 	void onRequestMaterials( QString itemSID );
 	void onSetNeedDecayMultiplier( float value );
 	void onSetDisableNeedDecay( QString need, bool disable );
+	void onRequestProfile( int numTicks );
+	void onExportProfile( QString path );
 
 signals:
 	void signalTriggerEvent( EventType type, QVariantMap args );
@@ -61,6 +63,7 @@ public slots:
 	void signalItemGroups( const QStringList& groups );
 	void signalItems( const QStringList& items );
 	void signalMaterials( int componentCount, const QStringList& mats1, const QStringList& mats2 );
+	void signalProfile( const QVariantList& sections );
 
 private:
 	QPointer<Game> g;  ///< Game instance (weak ownership).
@@ -36,6 +36,7 @@
 AggregatorInventory::AggregatorInventory( QObject* parent ) :
 	QObject( parent )
 {
+	qRegisterMetaType<QList<GuiInventoryMaterial>>();
 
 	m_buildSelection2String.insert( BuildSelection::Workshop, "Workshop" );
 	m_buildSelection2String.insert( BuildSelection::Wall, "Wall" );
@@ -118,18 +119,21 @@ void AggregatorInventory::onRequestCategories()
 {
 	if( !g ) return;
 	m_categories.clear();
+	m_leafIndex.clear();
+	// the tree below is built from the current counters, pending changes are already in it
+	g->inv()->takeChangedCounts();
 	for ( const auto& cat : g->inv()->categories() )
 	{
 		GuiInventoryCategory gic;
 		gic.id = cat;
-		gic.name = S::s( "$CategoryName_" + cat );
+		gic.name = S::categoryName( cat );
 		gic.watched = m_watchedItems.contains( cat );
 
 		for ( const auto& group : g->inv()->groups( cat ) )
 		{
 			GuiInventoryGroup gig;
 			gig.id = group;
-			gig.name = S::s( "$GroupName_" + group );
+			gig.name = S::groupName( group );
 			gig.cat = cat;
 			gig.watched = m_watchedItems.contains( cat + group );
 
@@ -137,7 +141,7 @@ void AggregatorInventory::onRequestCategories()
 			{
 				GuiInventoryItem gii;
 				gii.id = item;
-				gii.name = S::s( "$ItemName_" + item );
+				gii.name = S::itemName( item );
 				gii.cat = cat;
 				gii.group = group;
 				gii.watched = m_watchedItems.contains( cat + group + item );
@@ -149,7 +153,7 @@ void AggregatorInventory::onRequestCategories()
 					{
 						GuiInventoryMaterial gim;
 						gim.id = mat;
-						gim.name = S::s( "$MaterialName_" + mat );
+						gim.name = S::materialName( mat );
 						gim.cat = cat;
 						gim.group = group;
 						gim.item = item;
@@ -165,6 +169,7 @@ void AggregatorInventory::onRequestCategories()
 						gii.countTotal += result.total;
 						gii.countInStockpiles += result.inStockpile;
 
+						m_leafIndex.insert( { item, mat }, { (int)m_categories.size(), (int)gic.groups.size(), (int)gig.items.size(), (int)gii.materials.size() } );
 						gii.materials.append( gim );
 					}
 				}
@@ -186,6 +191,60 @@ void AggregatorInventory::onRequestCategories()
 	emit signalInventoryCategories( m_categories );
 }
 
+/// @brief Applies the counters that changed during the last tick to the cached category tree
+///        and emits only the changed material leaves. Parent totals are adjusted by the
+///        difference of each leaf, so the cost depends on the number of changes, not on the
+///        size of the inventory. Does nothing until the tree was requested once.
+void AggregatorInventory::onUpdateAfterTick()
+{
+	if( !g || m_categories.empty() ) return;
+
+	auto changed = g->inv()->takeChangedCounts();
+	if( changed.empty() ) return;
+
+	QList<GuiInventoryMaterial> out;
+	for ( const auto& key : changed )
+	{
+		auto it = m_leafIndex.constFind( key );
+		if ( it == m_leafIndex.constEnd() )
+		{
+			continue;
+		}
+		const LeafIndex& li = it.value();
+		auto& gic = m_categories[li.cat];
+		auto& gig = gic.groups[li.group];
+		auto& gii = gig.items[li.item];
+		auto& gim = gii.materials[li.mat];
+
+		auto result = g->inv()->itemCountDetailed( key.first, key.second );
+
+		const int dTotal   = (int)result.total - (int)gim.countTotal;
+		const int dInStock = (int)result.inStockpile - (int)gim.countInStockpiles;
+
+		gim.countTotal = result.total;
+		gim.countInJob = result.inJob;
+		gim.countInStockpiles = result.inStockpile;
+		gim.countEquipped = result.equipped;
+		gim.countConstructed = result.constructed;
+		gim.countLoose = result.loose;
+		gim.totalValue = result.totalValue;
+
+		gii.countTotal += dTotal;
+		gii.countInStockpiles += dInStock;
+		gig.countTotal += dTotal;
+		gig.countInStockpiles += dInStock;
+		gic.countTotal += dTotal;
+		gic.countInStockpiles += dInStock;
+
+		out.append( gim );
+	}
+
+	if( !out.empty() )
+	{
+		emit signalInventoryCounts( out );
+	}
+}
+
 /// @brief Collects the buildable entries for the given BuildSelection / category combination
 ///        (Constructions / Workshops / Containers / Items DB rows), produces preview icons
 ///        and required-item lists, and emits signalBuildItems.
@@ -477,7 +536,7 @@ void AggregatorInventory::updateWatchedItem( QString cat )
 					}
 				}
 			}
-			gwi.guiString = S::s( "$CategoryName_" + cat ) + ": " + QString::number( gwi.count );
+			gwi.guiString = S::categoryName( cat ) + ": " + QString::number( gwi.count );
 			break;
 		}
 	}
@@ -502,7 +561,7 @@ void AggregatorInventory::updateWatchedItem( QString cat, QString group )
 					gwi.count += g->inv()->itemCount( item, mat );
 				}
 			}
-			gwi.guiString = S::s( "$GroupName_" + group ) + ": " + QString::number( gwi.count );
+			gwi.guiString = S::groupName( group ) + ": " + QString::number( gwi.count );
 
 			break;
 		}
@@ -525,7 +584,7 @@ void AggregatorInventory::updateWatchedItem( QString cat, QString group, QString
 			{
 				gwi.count += g->inv()->itemCount( item, mat );
 			}
-			gwi.guiString = S::s( "$ItemName_" + item ) + ": " + QString::number( gwi.count );
+			gwi.guiString = S::itemName( item ) + ": " + QString::number( gwi.count );
 			break;
 		}
 	}
@@ -545,7 +604,7 @@ void AggregatorInventory::updateWatchedItem( QString cat, QString group, QString
 		if( gwi.category == cat && gwi.group == group && gwi.item == item && gwi.material == mat )
 		{
 			gwi.count = g->inv()->itemCount( item, mat );
-			gwi.guiString = S::s( "$MaterialName_" + mat ) + " " + S::s( "$ItemName_" + item ) + ": " + QString::number( gwi.count );
+			gwi.guiString = S::materialName( mat ) + " " + S::itemName( item ) + ": " + QString::number( gwi.count );
 			break;
 		}
 	}
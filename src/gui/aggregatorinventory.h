@@ -173,6 +173,16 @@ class AggregatorInventory : public QObject
     void setAvailableMats( GuiBuildRequiredItem& gbri );
 
     QHash<QString, QString> m_itemToGroupCache;     ///< Item ID → group ID lookup cache.
+
+    /// @brief Position of a material leaf in m_categories.
+    struct LeafIndex
+    {
+        int cat = 0;
+        int group = 0;
+        int item = 0;
+        int mat = 0;
+    };
+    QHash<QPair<QString, QString>, LeafIndex> m_leafIndex; ///< (item ID, material ID) → leaf position in m_categories.
     QHash<QString, QString> m_itemToCategoryCache;  ///< Item ID → category ID lookup cache.
 
     void updateWatchedItem( QString cat );
@@ -182,6 +192,7 @@ class AggregatorInventory : public QObject
 
 public slots:
 	void onRequestCategories();
+    void onUpdateAfterTick();
    
     void onRequestBuildItems( BuildSelection buildSelection, QString category );
 	
@@ -192,6 +203,7 @@ public slots:
 
 signals:
 	void signalInventoryCategories( const QList<GuiInventoryCategory>& categories );
+    void signalInventoryCounts( const QList<GuiInventoryMaterial>& materials );
     
     void signalBuildItems( const QList<GuiBuildItem>& items );
 
@@ -100,8 +100,7 @@ TileDataUpdate AggregatorRenderer::aggregateTile( unsigned int tileID ) const
 		}
 	}
 
-	td.flags  = (quint64)tile.flags;
-	td.flags2 = (quint64)tile.flags >> 32;
+	td.flags = tile.flags;
 
 	td.lightLevel      = qMin( tile.lightLevel, (unsigned char)20 );
 	td.fluidLevel      = qMin( tile.fluidLevel, (unsigned char)10 );
@@ -34,8 +34,7 @@ class Game;
 ///        can be uploaded as a small array of uints (see TD_SIZE).
 struct TileData
 {
-	unsigned int flags  = 0;                ///< Primary tile flags (walkable, occupied, …).
-	unsigned int flags2 = 0;                ///< Secondary flags overflow.
+	unsigned int flags = 0;                 ///< Tile flags (walkable, occupied, …).
 
 	unsigned int floorSpriteUID = 0;        ///< Floor sprite UID.
 	unsigned int wallSpriteUID  = 0;        ///< Wall sprite UID.
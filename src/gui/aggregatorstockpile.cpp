@@ -27,6 +27,7 @@
 #include "../base/global.h"
 #include "../game/game.h"
 #include "../game/inventory.h"
+#include "../game/replay.h"
 #include "../game/stockpilemanager.h"
 #include "../game/world.h"
 #include "../gui/strings.h"
@@ -114,8 +115,8 @@ bool AggregatorStockpile::aggregate( unsigned int stockpileID )
 			{
 				//QIcon icon( Global::util->smallPixmap( Global::sf().createSprite( entry.first, { entry.second } ), season, 0 ) );
 				ItemsSummary is;
-				is.itemName     = S::s( "$ItemName_" + entry.first );
-				is.materialName = S::s( "$MaterialName_" + entry.second );
+				is.itemName     = S::itemName( entry.first );
+				is.materialName = S::materialName( entry.second );
 				is.count        = count;
 
 				m_info.summary.append( is );
@@ -157,8 +158,8 @@ void AggregatorStockpile::onUpdateAfterTick()
 			{
 				//QIcon icon( Global::util->smallPixmap( Global::sf().createSprite( entry.first, { entry.second } ), season, 0 ) );
 				ItemsSummary is;
-				is.itemName     = S::s( "$ItemName_" + entry.first );
-				is.materialName = S::s( "$MaterialName_" + entry.second );
+				is.itemName     = S::itemName( entry.first );
+				is.materialName = S::materialName( entry.second );
 				is.count        = count;
 
 				m_info.summary.append( is );
@@ -179,6 +180,7 @@ void AggregatorStockpile::onUpdateAfterTick()
 void AggregatorStockpile::onSetBasicOptions( unsigned int stockpileID, QString name, int priority, bool suspended, bool pull, bool allowPull )
 {
 	if( !g ) return;
+	Replay::record( "StockpileOptions", { stockpileID, name, priority, suspended, pull, allowPull } );
 	auto sp = g->spm()->getStockpile( stockpileID );
 	if ( sp )
 	{
@@ -203,6 +205,7 @@ void AggregatorStockpile::onSetActive( unsigned int stockpileID, bool active, QS
 {
 	if( !g ) return;
 	qDebug() << "set active:" << stockpileID << active << category << group << item << material;
+	Replay::record( "StockpileFilter", { stockpileID, active, category, group, item, material } );
 	auto sp = g->spm()->getStockpile( stockpileID );
 	if ( sp )
 	{
@@ -122,21 +122,21 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 		{
 			QString wallSID = DBH::materialSID( tile.wallMaterial );
 			QString wType   = DB::select( "Type", "Materials", wallSID ).toString();
-			m_tileInfo.wall = "Wall: " + S::s( "$MaterialName_" + wallSID ) + " " + S::s( "$GroupName_" + wType ).toLower();
+			m_tileInfo.wall = "Wall: " + S::materialName( wallSID ) + " " + S::groupName( wType ).toLower();
 		}
 
 		if ( tile.embeddedMaterial )
 		{
 			QString embeddedSID = DBH::materialSID( tile.embeddedMaterial );
 			QString eType       = DB::select( "Type", "Materials", embeddedSID ).toString();
-			m_tileInfo.embedded = "Embedded: " + S::s( "$MaterialName_" + embeddedSID ) + " " + S::s( "$GroupName_" + eType ).toLower();
+			m_tileInfo.embedded = "Embedded: " + S::materialName( embeddedSID ) + " " + S::groupName( eType ).toLower();
 		}
 
 		if ( tile.floorMaterial )
 		{
 			QString floorSID = DBH::materialSID( tile.floorMaterial );
 			QString fType    = DB::select( "Type", "Materials", floorSID ).toString();
-			m_tileInfo.floor = "Floor: " + S::s( "$MaterialName_" + floorSID ) + " " + S::s( "$GroupName_" + fType ).toLower();
+			m_tileInfo.floor = "Floor: " + S::materialName( floorSID ) + " " + S::groupName( fType ).toLower();
 		}
 
 		if ( g->w()->plants().contains( pos.toInt() ) )
@@ -165,7 +165,7 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 			for ( auto item : pe )
 			{
 				QString itext = "";
-				QString info = S::s( "$MaterialName_" + g->inv()->materialSID( item ) ) + " " + S::s( "$ItemName_" + g->inv()->itemSID( item ) );
+				QString info = g->inv()->designation( item );
 				
 				if( g->inv()->isInStockpile( item ) )
 				{
@@ -198,7 +198,7 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 			if ( door )
 			{
 				GuiItemInfo git;
-				git.text = S::s( "$MaterialName_" + door->source.materialSID ) + " " + S::s( "$ItemName_" + door->source.itemSID ) + "(b)";
+				git.text = S::materialName( door->source.materialSID ) + " " + S::itemName( door->source.itemSID ) + "(b)";
 				m_tileInfo.items.append( git );
 			}
 		}
@@ -208,7 +208,7 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 		{
 			unsigned int id = g->mcm()->mechanismID( pos );
 			m_tileInfo.mechInfo = g->mcm()->mechanismData( id );
-			m_tileInfo.mechInfo.name = S::s( "$MaterialName_" + m_tileInfo.mechInfo.materialSID ) + " " + S::s( "$ItemName_" + m_tileInfo.mechInfo.itemSID );
+			m_tileInfo.mechInfo.name = S::materialName( m_tileInfo.mechInfo.materialSID ) + " " + S::itemName( m_tileInfo.mechInfo.itemSID );
 		}
 		else
 		{
@@ -224,7 +224,7 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 			{
 				SourceMaterial sm = SourceMaterial::deserialize( constr.value( "Source" ).toMap() );
 				GuiItemInfo git;
-				git.text = S::s( "$MaterialName_" + sm.materialSID ) + " " + S::s( "$ItemName_" + sm.itemSID ) + "(b)";
+				git.text = S::materialName( sm.materialSID ) + " " + S::itemName( sm.itemSID ) + "(b)";
 				m_tileInfo.items.append( git );
 			}
 		}
@@ -236,7 +236,7 @@ void AggregatorTileInfo::onUpdateTileInfo( unsigned int tileID )
 			{
 				SourceMaterial sm = SourceMaterial::deserialize( constr.value( "Source" ).toMap() );
 				GuiItemInfo git;
-				git.text = S::s( "$MaterialName_" + sm.materialSID ) + " " + S::s( "$ItemName_" + sm.itemSID ) + "(b)";
+				git.text = S::materialName( sm.materialSID ) + " " + S::itemName( sm.itemSID ) + "(b)";
 				m_tileInfo.items.append( git );
 			}
 		}
@@ -469,8 +469,8 @@ void AggregatorTileInfo::onRequestStockpileItems( unsigned int tileID )
 			{
 				//QIcon icon( Global::util->smallPixmap( Global::sf().createSprite( entry.first, { entry.second } ), season, 0 ) );
 				ItemsSummary is;
-				is.itemName     = S::s( "$ItemName_" + entry.first );
-				is.materialName = S::s( "$MaterialName_" + entry.second );
+				is.itemName     = S::itemName( entry.first );
+				is.materialName = S::materialName( entry.second );
 				is.count        = count;
 
 				m_spInfo.summary.append( is );
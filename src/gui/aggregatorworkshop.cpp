@@ -32,6 +32,7 @@
 #include "../game/gnomemanager.h"
 #include "../game/gnometrader.h"
 #include "../game/inventory.h"
+#include "../game/replay.h"
 #include "../game/workshopmanager.h"
 #include "../game/world.h"
 #include "../gui/strings.h"
@@ -259,6 +260,7 @@ void AggregatorWorkshop::onUpdateAfterTick()
 void AggregatorWorkshop::onSetBasicOptions( unsigned int workshopID, QString name, int priority, bool suspended, bool acceptGenerated, bool autoCraftMissing, bool connectStockpile )
 {
 	if( !g ) return;
+	Replay::record( "WorkshopOptions", { workshopID, name, priority, suspended, acceptGenerated, autoCraftMissing, connectStockpile } );
 	auto ws = g->wsm()->workshop( workshopID );
 	if ( ws )
 	{
@@ -310,6 +312,7 @@ void AggregatorWorkshop::onSetFisherOptions( unsigned int workshopID, bool catch
 void AggregatorWorkshop::onCraftItem( unsigned int workshopID, QString craftID, int mode, int number, QStringList mats )
 {
 	if( !g ) return;
+	Replay::record( "CraftItem", { workshopID, craftID, mode, number, mats } );
 	auto ws = g->wsm()->workshop( workshopID );
 	if ( ws )
 	{
@@ -332,6 +335,7 @@ void AggregatorWorkshop::onCloseWindow()
 void AggregatorWorkshop::onCraftJobCommand( unsigned int workshopID, unsigned int craftJobID, QString command )
 {
 	if( !g ) return;
+	Replay::record( "CraftJobCommand", { workshopID, craftJobID, command } );
 	auto ws = g->wsm()->workshop( workshopID );
 	if ( ws )
 	{
@@ -360,6 +364,7 @@ void AggregatorWorkshop::onCraftJobCommand( unsigned int workshopID, unsigned in
 void AggregatorWorkshop::onCraftJobParams( unsigned int workshopID, unsigned int craftJobID, int mode, int numToCraft, bool suspended, bool moveBack )
 {
 	if( !g ) return;
+	Replay::record( "CraftJobParams", { workshopID, craftJobID, mode, numToCraft, suspended, moveBack } );
 	auto ws = g->wsm()->workshop( workshopID );
 	if ( ws )
 	{
@@ -444,7 +449,7 @@ void AggregatorWorkshop::updateTraderStock( const QList<TraderItem>& source )
 				qName= S::s( "$QualityName_" + qID ) + " ";
 			}
 
-			gti.name = qName + S::s( "$MaterialName_" + gti.materialSIDorGender ) + " " + S::s( "$ItemName_" + gti.itemSID ) + " (" + QString::number( gti.value ) + ")";
+			gti.name = qName + S::materialName( gti.materialSIDorGender ) + " " + S::itemName( gti.itemSID ) + " (" + QString::number( gti.value ) + ")";
 		}
 		m_traderStock.append( gti );
 	}
@@ -507,7 +512,7 @@ void AggregatorWorkshop::updatePlayerStock( unsigned int workshopID )
 							gti.quality = key; 
 							gti.count = vlItems[(int)key].size();
 
-							gti.name = qName + S::s( "$MaterialName_" + mat ) + " " + S::s( "$ItemName_" + item ) + " (" + QString::number( gti.value ) + ")";
+							gti.name = qName + S::materialName( mat ) + " " + S::itemName( item ) + " (" + QString::number( gti.value ) + ")";
 							
 							m_playerStock.append( gti );
 						}
@@ -24,6 +24,8 @@
 
 #include "../base/config.h"
 #include "../base/db.h"
+#include "../base/dbhelper.h"
+#include "../base/rng.h"
 
 #include <QApplication>
 #include <QDebug>
@@ -33,6 +35,15 @@
 QMap<QString, QString> Strings::m_table = QMap<QString, QString>();
 QString Strings::m_language             = "";
 
+QHash<QString, QString> Strings::m_itemNames;
+QHash<QString, QString> Strings::m_materialNames;
+QHash<QString, QString> Strings::m_categoryNames;
+QHash<QString, QString> Strings::m_groupNames;
+
+std::vector<QString> Strings::m_itemNamesByUID;
+std::vector<QString> Strings::m_materialNamesByUID;
+QHash<quint32, QString> Strings::m_designations;
+
 /// @brief Private constructor (singleton pattern).
 Strings::Strings()
 {
@@ -50,10 +61,18 @@ bool Strings::init()
 {
 	m_language = Global::cfg->get( "language" ).toString();
 	m_table.clear();
+	m_itemNames.clear();
+	m_materialNames.clear();
+	m_categoryNames.clear();
+	m_groupNames.clear();
+	clearUIDNames();
 	//for( auto row : DB::selectRows( "Translation_" + m_language ) )
 	for ( auto row : DB::selectRows( "Translation" ) )
 	{
-		m_table.insert( row.value( "ID" ).toString(), row.value( "Text" ).toString() );
+		const QString key  = row.value( "ID" ).toString();
+		const QString text = row.value( "Text" ).toString();
+		m_table.insert( key, text );
+		indexName( key, text );
 	}
 
 	return true;
@@ -83,6 +102,132 @@ QString Strings::s( QString key )
 void Strings::insertString( QString key, QString string )
 {
 	m_table.insert( key, string );
+	indexName( key, string );
+}
+
+/// @brief Files a translation into the per-kind name tables if its key is an item,
+///        material, category or group name, so the name getters can skip building the key.
+/// @param key  Translation key.
+/// @param text Localised value.
+void Strings::indexName( const QString& key, const QString& text )
+{
+	if ( key.startsWith( QLatin1String( "$ItemName_" ) ) )
+	{
+		m_itemNames.insert( key.mid( 10 ), text );
+	}
+	else if ( key.startsWith( QLatin1String( "$MaterialName_" ) ) )
+	{
+		m_materialNames.insert( key.mid( 14 ), text );
+	}
+	else if ( key.startsWith( QLatin1String( "$CategoryName_" ) ) )
+	{
+		m_categoryNames.insert( key.mid( 14 ), text );
+	}
+	else if ( key.startsWith( QLatin1String( "$GroupName_" ) ) )
+	{
+		m_groupNames.insert( key.mid( 11 ), text );
+	}
+}
+
+/// @brief Looks up a name in one of the per-kind tables. Hits return the stored string
+///        without allocating; misses build the same "Error: <key>" placeholder as s().
+QString Strings::lookupName( const QHash<QString, QString>& names, const char* prefix, const QString& sid )
+{
+	auto it = names.constFind( sid );
+	if ( it != names.constEnd() )
+	{
+		return it.value();
+	}
+	return "Error: " + QString( prefix ) + sid;
+}
+
+/// @brief Localised item name, same result as s( "$ItemName_" + itemSID ).
+QString Strings::itemName( const QString& itemSID )
+{
+	return lookupName( m_itemNames, "$ItemName_", itemSID );
+}
+
+/// @brief Localised material name, same result as s( "$MaterialName_" + materialSID ).
+QString Strings::materialName( const QString& materialSID )
+{
+	return lookupName( m_materialNames, "$MaterialName_", materialSID );
+}
+
+/// @brief Localised item category name, same result as s( "$CategoryName_" + categorySID ).
+QString Strings::categoryName( const QString& categorySID )
+{
+	return lookupName( m_categoryNames, "$CategoryName_", categorySID );
+}
+
+/// @brief Localised item group name, same result as s( "$GroupName_" + groupSID ).
+QString Strings::groupName( const QString& groupSID )
+{
+	return lookupName( m_groupNames, "$GroupName_", groupSID );
+}
+
+/// @brief Localised item name by item UID. The UID table is filled on first use of a UID,
+///        so this must only be called from the game thread.
+/// @param itemUID UID from DBH::itemUID().
+QString Strings::itemName( int itemUID )
+{
+	if ( itemUID < 0 )
+	{
+		return itemName( DBH::itemSID( itemUID ) );
+	}
+	if ( (size_t)itemUID >= m_itemNamesByUID.size() )
+	{
+		m_itemNamesByUID.resize( itemUID + 1 );
+	}
+	QString& name = m_itemNamesByUID[itemUID];
+	if ( name.isNull() )
+	{
+		name = itemName( DBH::itemSID( itemUID ) );
+	}
+	return name;
+}
+
+/// @brief Localised material name by material UID. Game thread only, see itemName( int ).
+/// @param materialUID UID from DBH::materialUID().
+QString Strings::materialName( int materialUID )
+{
+	if ( materialUID < 0 )
+	{
+		return materialName( DBH::materialSID( materialUID ) );
+	}
+	if ( (size_t)materialUID >= m_materialNamesByUID.size() )
+	{
+		m_materialNamesByUID.resize( materialUID + 1 );
+	}
+	QString& name = m_materialNamesByUID[materialUID];
+	if ( name.isNull() )
+	{
+		name = materialName( DBH::materialSID( materialUID ) );
+	}
+	return name;
+}
+
+/// @brief Display name of an item type in a material (e.g. "Iron Pickaxe"), cached per
+///        item and material pair. Game thread only, see itemName( int ).
+QString Strings::designation( int itemUID, int materialUID )
+{
+	const quint32 key = ( (quint32)( itemUID & 0xffff ) << 16 ) | ( materialUID & 0xffff );
+	auto it           = m_designations.constFind( key );
+	if ( it != m_designations.constEnd() )
+	{
+		return it.value();
+	}
+	QString name = materialName( materialUID ) + " " + itemName( itemUID );
+	m_designations.insert( key, name );
+	return name;
+}
+
+/// @brief Drops the UID indexed name caches. Called whenever the item and material UID
+///        tables in GameState are replaced, e.g. when a save game is loaded.
+void Strings::clearUIDNames()
+{
+	m_itemNamesByUID.clear();
+	m_materialNamesByUID.clear();
+	m_designations.clear();
 }
 
 /// @brief Generates a random kingdom name by picking one of the Namerules_Rule "Faction"
@@ -92,8 +237,7 @@ QString Strings::randomKingdomName()
 {
 	auto ruleList = DB::selectRows( "Namerules_Rule", "Faction" );
 
-	srand( std::chrono::system_clock::now().time_since_epoch().count() );
-	auto rule = ruleList.at( rand() % ruleList.size() ).value( "Part" ).toString().split( "|" );
+	auto rule = ruleList.at( RNG::rand( RngStream::Names ) % ruleList.size() ).value( "Part" ).toString().split( "|" );
 	QString name;
 	for ( auto part : rule )
 	{
@@ -147,7 +291,7 @@ QString Strings::replaceNamePart( QString part )
 QString Strings::replaceNamePart2( QString part )
 {
 	QString tableName = "Words_" + part;
-	int ra            = rand() % DB::numRows( tableName );
+	int ra            = RNG::rand( RngStream::Names ) % DB::numRows( tableName );
 	return DB::select( "Word", tableName, ra ).toString();
 }
 
@@ -163,7 +307,7 @@ QString Strings::replaceNamePart2( QString part, QString part2 )
 		part2 = "Word";
 	}
 	QString tableName = "Words_" + part;
-	int ra            = rand() % DB::numRows( tableName );
+	int ra            = RNG::rand( RngStream::Names ) % DB::numRows( tableName );
 	return DB::select( part2, tableName, ra ).toString();
 }
 
@@ -22,8 +22,11 @@
  */
 #pragma once
 
+#include <QHash>
 #include <QMap>
 
+#include <vector>
+
 /// @brief Localisation singleton. Use via `S::s("$ItemName_IronSword")` or
 ///        `S::gi().numberWord(3)`. The table is populated from the language .xaml files
 ///        in content/xaml/localization/.
@@ -41,6 +44,18 @@ class Strings
 
 	QMap<int, QString> m_numberWords;       ///< Cardinal number → word mapping (e.g. 3 → "three").
 
+	static QHash<QString, QString> m_itemNames;     ///< Item SID → localised name.
+	static QHash<QString, QString> m_materialNames; ///< Material SID → localised name.
+	static QHash<QString, QString> m_categoryNames; ///< Item category SID → localised name.
+	static QHash<QString, QString> m_groupNames;    ///< Item group SID → localised name.
+
+	static std::vector<QString> m_itemNamesByUID;     ///< Item UID → localised name, filled on first use.
+	static std::vector<QString> m_materialNamesByUID; ///< Material UID → localised name, filled on first use.
+	static QHash<quint32, QString> m_designations;    ///< (item UID << 16 | material UID) → "<material> <item>".
+
+	static void indexName( const QString& key, const QString& text );
+	static QString lookupName( const QHash<QString, QString>& names, const char* prefix, const QString& sid );
+
 	static QString replaceNamePart( QString part );
 	static QString replaceNamePart2( QString part );
 	static QString replaceNamePart2( QString part, QString part2 );
@@ -74,6 +89,17 @@ class Strings
 
 	static void insertString( QString key, QString string );
 
+	static QString itemName( const QString& itemSID );
+	static QString materialName( const QString& materialSID );
+	static QString categoryName( const QString& categorySID );
+	static QString groupName( const QString& groupSID );
+
+	static QString itemName( int itemUID );
+	static QString materialName( int materialUID );
+	static QString designation( int itemUID, int materialUID );
+
+	static void clearUIDNames();
+
 	QString numberWord( int number );
 	QString randomKingdomName();
 };
@@ -18,6 +18,8 @@
 #include "debugmodel.h"
 #include "debugproxy.h"
 
+#include "../../base/profiler.h"
+
 #include <NsApp/Application.h>
 #include <NsCore/Log.h>
 #include <NsCore/ReflectionImplement.h>
@@ -79,6 +81,8 @@ DebugModel::DebugModel()
 	m_setSleepCmd.SetExecuteFunc( MakeDelegate( this, &DebugModel::onSetSleepCmd ) );
 	m_killGnomeCmd.SetExecuteFunc( MakeDelegate( this, &DebugModel::onKillGnomeCmd ) );
 	m_spawnItemCmd.SetExecuteFunc( MakeDelegate( this, &DebugModel::onSpawnItemCmd ) );
+	m_profileCmd.SetExecuteFunc( MakeDelegate( this, &DebugModel::onProfileCmd ) );
+	m_exportProfileCmd.SetExecuteFunc( MakeDelegate( this, &DebugModel::onExportProfileCmd ) );
 
 	m_gnomeList = *new ObservableCollection<NameEntry>();
 	m_gnomeList->Add( MakePtr<NameEntry>( "All Gnomes", 0 ) );
@@ -443,6 +447,37 @@ void DebugModel::SetDisableThirstDecay( bool v )
 	m_proxy->setDisableNeedDecay( "Thirst", v );
 }
 
+// Tick profiler
+/// @brief Requests percentiles over all ticks the profiler keeps.
+void DebugModel::onProfileCmd( BaseComponent* )
+{
+	m_proxy->requestProfile( Profiler::capacity );
+}
+
+/// @brief Writes the profiler timeline to profile.json in the data folder.
+void DebugModel::onExportProfileCmd( BaseComponent* )
+{
+	m_proxy->exportProfile( QString() );
+}
+
+/// @brief Formats the profiler percentiles as one line per section for the Game page.
+void DebugModel::updateProfile( const QVariantList& sections )
+{
+	QString text;
+	for ( const auto& vs : sections )
+	{
+		const auto entry = vs.toMap();
+		text += QString( "%1  p50 %2  p90 %3  p99 %4  max %5 ms\n" )
+					.arg( entry.value( "Section" ).toString(), -16 )
+					.arg( entry.value( "P50" ).toDouble(), 0, 'f', 2 )
+					.arg( entry.value( "P90" ).toDouble(), 0, 'f', 2 )
+					.arg( entry.value( "P99" ).toDouble(), 0, 'f', 2 )
+					.arg( entry.value( "Max" ).toDouble(), 0, 'f', 2 );
+	}
+	m_profileText = text.toStdString().c_str();
+	OnPropertyChanged( "ProfileText" );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NS_BEGIN_COLD_REGION
 
@@ -493,6 +528,10 @@ NS_IMPLEMENT_REFLECTION( DebugModel, "IngnomiaGUI.DebugModel" )
 	NsProp( "DisableSleepDecay", &DebugModel::GetDisableSleepDecay, &DebugModel::SetDisableSleepDecay );
 	NsProp( "DisableHungerDecay", &DebugModel::GetDisableHungerDecay, &DebugModel::SetDisableHungerDecay );
 	NsProp( "DisableThirstDecay", &DebugModel::GetDisableThirstDecay, &DebugModel::SetDisableThirstDecay );
+
+	NsProp( "ProfileCmd", &DebugModel::GetProfileCmd );
+	NsProp( "ExportProfileCmd", &DebugModel::GetExportProfileCmd );
+	NsProp( "ProfileText", &DebugModel::GetProfileText );
 }
 
 NS_IMPLEMENT_REFLECTION( NameEntry )
@@ -103,6 +103,8 @@ class DebugModel final : public NoesisApp::NotifyPropertyChangedBase
 	/// @brief Replaces the material dropdowns. @p componentCount selects whether one or two
 	///        material dropdowns are visible.
 	void updateMaterials( int componentCount, const QStringList& mats1, const QStringList& mats2 );
+	/// @brief Shows the tick profiler percentiles, one line per section.
+	void updateProfile( const QVariantList& sections );
 
 private:
 	DebugProxy* m_proxy = nullptr;
@@ -236,6 +238,16 @@ class DebugModel final : public NoesisApp::NotifyPropertyChangedBase
 	bool GetDisableThirstDecay() const { return m_disableThirstDecay; }
 	void SetDisableThirstDecay( bool v );
 
+	// Tick profiler
+	void onProfileCmd( BaseComponent* param );
+	void onExportProfileCmd( BaseComponent* param );
+	const NoesisApp::DelegateCommand* GetProfileCmd() const { return &m_profileCmd; }
+	const NoesisApp::DelegateCommand* GetExportProfileCmd() const { return &m_exportProfileCmd; }
+	NoesisApp::DelegateCommand m_profileCmd;
+	NoesisApp::DelegateCommand m_exportProfileCmd;
+	const char* GetProfileText() const { return m_profileText.Str(); }
+	Noesis::String m_profileText;
+
 	NS_DECLARE_REFLECTION( DebugModel, NotifyPropertyChangedBase )
 };
 
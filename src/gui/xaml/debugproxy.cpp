@@ -46,11 +46,14 @@ DebugProxy::DebugProxy( QObject* parent ) :
 	connect( this, &DebugProxy::signalRequestMaterials, agg, &AggregatorDebug::onRequestMaterials, Qt::QueuedConnection );
 	connect( this, &DebugProxy::signalSetNeedDecayMultiplier, agg, &AggregatorDebug::onSetNeedDecayMultiplier, Qt::QueuedConnection );
 	connect( this, &DebugProxy::signalSetDisableNeedDecay, agg, &AggregatorDebug::onSetDisableNeedDecay, Qt::QueuedConnection );
+	connect( this, &DebugProxy::signalRequestProfile, agg, &AggregatorDebug::onRequestProfile, Qt::QueuedConnection );
+	connect( this, &DebugProxy::signalExportProfile, agg, &AggregatorDebug::onExportProfile, Qt::QueuedConnection );
 
 	connect( agg, &AggregatorDebug::signalGnomeList, this, &DebugProxy::onGnomeList, Qt::QueuedConnection );
 	connect( agg, &AggregatorDebug::signalItemGroups, this, &DebugProxy::onItemGroups, Qt::QueuedConnection );
 	connect( agg, &AggregatorDebug::signalItems, this, &DebugProxy::onItems, Qt::QueuedConnection );
 	connect( agg, &AggregatorDebug::signalMaterials, this, &DebugProxy::onMaterials, Qt::QueuedConnection );
+	connect( agg, &AggregatorDebug::signalProfile, this, &DebugProxy::onProfile, Qt::QueuedConnection );
 }
 
 /// @brief Binds the proxy to its owning view model.
@@ -131,6 +134,18 @@ void DebugProxy::setDisableNeedDecay( QString need, bool disable )
 	emit signalSetDisableNeedDecay( need, disable );
 }
 
+/// @brief Asks the aggregator for tick time percentiles over the last @p numTicks ticks.
+void DebugProxy::requestProfile( int numTicks )
+{
+	emit signalRequestProfile( numTicks );
+}
+
+/// @brief Asks the aggregator to write the tick timeline as Chrome trace JSON.
+void DebugProxy::exportProfile( QString path )
+{
+	emit signalExportProfile( path );
+}
+
 /// @brief Slot: receives a fresh gnome list and pushes it into the model's dropdown,
 ///        keeping the synthetic "All Gnomes" entry at index 0.
 void DebugProxy::onGnomeList( const QList<QPair<QString, unsigned int>>& gnomes )
@@ -176,3 +191,12 @@ void DebugProxy::onMaterials( int componentCount, const QStringList& mats1, cons
 		m_parent->updateMaterials( componentCount, mats1, mats2 );
 	}
 }
+
+/// @brief Slot: relays the tick profiler percentiles to the model.
+void DebugProxy::onProfile( const QVariantList& sections )
+{
+	if ( m_parent )
+	{
+		m_parent->updateProfile( sections );
+	}
+}
@@ -47,6 +47,8 @@ class DebugProxy : public QObject
 	void requestMaterials( QString itemSID );
 	void setNeedDecayMultiplier( float value );
 	void setDisableNeedDecay( QString need, bool disable );
+	void requestProfile( int numTicks );
+	void exportProfile( QString path );
 
 private:
 	IngnomiaGUI::DebugModel* m_parent = nullptr;  ///< View model the proxy pushes updates into.
@@ -56,6 +58,7 @@ public slots:
 	void onItemGroups( const QStringList& groups );
 	void onItems( const QStringList& items );
 	void onMaterials( int componentCount, const QStringList& mats1, const QStringList& mats2 );
+	void onProfile( const QVariantList& sections );
 
 signals:
 	void signalSpawnCreature( QString type );
@@ -70,4 +73,6 @@ public slots:
 	void signalRequestMaterials( QString itemSID );
 	void signalSetNeedDecayMultiplier( float value );
 	void signalSetDisableNeedDecay( QString need, bool disable );
+	void signalRequestProfile( int numTicks );
+	void signalExportProfile( QString path );
 };
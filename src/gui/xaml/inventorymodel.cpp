@@ -53,6 +53,8 @@ IngnomiaGUI::InvMaterialItem::InvMaterialItem( const GuiInventoryMaterial& mat,
 	m_name   = mat.name.toStdString().c_str();
 	m_active = mat.watched;
 
+	m_countTotal   = mat.countTotal;
+	m_countInStock = mat.countInStockpiles;
 	m_inStock = QString::number( mat.countInStockpiles ).toStdString().c_str();
 	m_total = QString::number( mat.countTotal ).toStdString().c_str();
 }
@@ -88,6 +90,21 @@ const char* IngnomiaGUI::InvMaterialItem::getInStock() const
 	return m_inStock.Str();
 }
 
+/// @brief Sets new counts and returns the differences to the old ones for the parent rows.
+void IngnomiaGUI::InvMaterialItem::setCounts( int total, int inStock, int& dTotal, int& dInStock )
+{
+	dTotal   = total - m_countTotal;
+	dInStock = inStock - m_countInStock;
+
+	m_countTotal   = total;
+	m_countInStock = inStock;
+	m_inStock = QString::number( inStock ).toStdString().c_str();
+	m_total = QString::number( total ).toStdString().c_str();
+
+	OnPropertyChanged( "Total" );
+	OnPropertyChanged( "InStock" );
+}
+
 #pragma endregion MaterialItem
 
 #pragma region ItemItem
@@ -101,6 +118,8 @@ IngnomiaGUI::InvItemItem::InvItemItem( const GuiInventoryItem& gii, InventoryPro
 	m_group( gii.group )
 {
 	m_name = gii.name.toStdString().c_str();
+	m_countTotal   = gii.countTotal;
+	m_countInStock = gii.countInStockpiles;
 	m_inStock = QString::number( gii.countInStockpiles ).toStdString().c_str();
 	m_total = QString::number( gii.countTotal ).toStdString().c_str();
 
@@ -109,6 +128,7 @@ IngnomiaGUI::InvItemItem::InvItemItem( const GuiInventoryItem& gii, InventoryPro
 	for( const auto& mat : gii.materials )
 	{
 		m_materials->Add( MakePtr<InvMaterialItem>( mat, proxy ) );
+		m_materialSIDs.append( mat.id );
 	}
 
 	m_state = gii.watched;
@@ -188,6 +208,25 @@ const char* IngnomiaGUI::InvItemItem::getInStock() const
 	return m_inStock.Str();
 }
 
+/// @brief Adds the count differences of a changed child row.
+void IngnomiaGUI::InvItemItem::addCounts( int dTotal, int dInStock )
+{
+	m_countTotal += dTotal;
+	m_countInStock += dInStock;
+	m_inStock = QString::number( m_countInStock ).toStdString().c_str();
+	m_total = QString::number( m_countTotal ).toStdString().c_str();
+
+	OnPropertyChanged( "Total" );
+	OnPropertyChanged( "InStock" );
+}
+
+/// @brief Returns the child row of a material or nullptr.
+IngnomiaGUI::InvMaterialItem* IngnomiaGUI::InvItemItem::material( const QString& sid ) const
+{
+	int index = m_materialSIDs.indexOf( sid );
+	return index < 0 ? nullptr : m_materials->Get( index );
+}
+
 #pragma endregion ItemItem
 
 #pragma region GroupItem
@@ -200,6 +239,8 @@ IngnomiaGUI::InvGroupItem::InvGroupItem( const GuiInventoryGroup& gig, Inventory
 	m_category( gig.cat )
 {
 	m_name = gig.name.toStdString().c_str();
+	m_countTotal   = gig.countTotal;
+	m_countInStock = gig.countInStockpiles;
 	m_inStock = QString::number( gig.countInStockpiles ).toStdString().c_str();
 	m_total = QString::number( gig.countTotal ).toStdString().c_str();
 
@@ -208,6 +249,7 @@ IngnomiaGUI::InvGroupItem::InvGroupItem( const GuiInventoryGroup& gig, Inventory
 	for ( auto item : gig.items )
 	{
 		m_items->Add( MakePtr<InvItemItem>( item, proxy ) );
+		m_itemSIDs.append( item.id );
 	}
 
 	m_state = gig.watched;
@@ -289,6 +331,25 @@ const char* IngnomiaGUI::InvGroupItem::getInStock() const
 	return m_inStock.Str();
 }
 
+/// @brief Adds the count differences of a changed child row.
+void IngnomiaGUI::InvGroupItem::addCounts( int dTotal, int dInStock )
+{
+	m_countTotal += dTotal;
+	m_countInStock += dInStock;
+	m_inStock = QString::number( m_countInStock ).toStdString().c_str();
+	m_total = QString::number( m_countTotal ).toStdString().c_str();
+
+	OnPropertyChanged( "Total" );
+	OnPropertyChanged( "InStock" );
+}
+
+/// @brief Returns the child row of an item or nullptr.
+IngnomiaGUI::InvItemItem* IngnomiaGUI::InvGroupItem::item( const QString& sid ) const
+{
+	int index = m_itemSIDs.indexOf( sid );
+	return index < 0 ? nullptr : m_items->Get( index );
+}
+
 
 #pragma endregion GroupItem
 
@@ -301,6 +362,8 @@ IngnomiaGUI::InvCategoryItem::InvCategoryItem( const GuiInventoryCategory& gic,
 	m_sid( gic.id )
 {
 	m_name = gic.name.toStdString().c_str();
+	m_countTotal   = gic.countTotal;
+	m_countInStock = gic.countInStockpiles;
 	m_inStock = QString::number( gic.countInStockpiles ).toStdString().c_str();
 	m_total = QString::number( gic.countTotal ).toStdString().c_str();
 
@@ -309,6 +372,7 @@ IngnomiaGUI::InvCategoryItem::InvCategoryItem( const GuiInventoryCategory& gic,
 	for ( auto group : gic.groups )
 	{
 		m_groups->Add( MakePtr<InvGroupItem>( group, proxy ) );
+		m_groupSIDs.append( group.id );
 	}
 	m_state = gic.watched;
 	if( !m_state )
@@ -394,6 +458,25 @@ const char* IngnomiaGUI::InvCategoryItem::getInStock() const
 	return m_inStock.Str();
 }
 
+/// @brief Adds the count differences of a changed child row.
+void IngnomiaGUI::InvCategoryItem::addCounts( int dTotal, int dInStock )
+{
+	m_countTotal += dTotal;
+	m_countInStock += dInStock;
+	m_inStock = QString::number( m_countInStock ).toStdString().c_str();
+	m_total = QString::number( m_countTotal ).toStdString().c_str();
+
+	OnPropertyChanged( "Total" );
+	OnPropertyChanged( "InStock" );
+}
+
+/// @brief Returns the child row of a group or nullptr.
+IngnomiaGUI::InvGroupItem* IngnomiaGUI::InvCategoryItem::group( const QString& sid ) const
+{
+	int index = m_groupSIDs.indexOf( sid );
+	return index < 0 ? nullptr : m_groups->Get( index );
+}
+
 
 #pragma endregion CategoryItem
 
@@ -416,14 +499,47 @@ InventoryModel::InventoryModel()
 void InventoryModel::updateCategories( const QList<GuiInventoryCategory>& categories )
 {
 	m_categories->Clear();
+	m_categorySIDs.clear();
 	for ( const auto& cat : categories )
 	{
 		m_categories->Add( MakePtr<InvCategoryItem>( cat, m_proxy ) );
+		m_categorySIDs.append( cat.id );
 	}
 
 	OnPropertyChanged( "Categories" );
 }
 
+/// @brief Updates the rows of changed materials in place and adds the differences to their
+///        item, group and category rows. Materials that are not in the tree are skipped.
+void InventoryModel::updateCounts( const QList<GuiInventoryMaterial>& materials )
+{
+	for ( const auto& mat : materials )
+	{
+		int index = m_categorySIDs.indexOf( mat.cat );
+		if ( index < 0 )
+		{
+			continue;
+		}
+		auto cat   = m_categories->Get( index );
+		auto group = cat->group( mat.group );
+		auto item  = group ? group->item( mat.item ) : nullptr;
+		auto row   = item ? item->material( mat.id ) : nullptr;
+		if ( !row )
+		{
+			continue;
+		}
+		int dTotal   = 0;
+		int dInStock = 0;
+		row->setCounts( mat.countTotal, mat.countInStockpiles, dTotal, dInStock );
+		if ( dTotal || dInStock )
+		{
+			item->addCounts( dTotal, dInStock );
+			group->addCounts( dTotal, dInStock );
+			cat->addCounts( dTotal, dInStock );
+		}
+	}
+}
+
 Noesis::ObservableCollection<InvCategoryItem>* InventoryModel::GetCategories() const
 {
 	return m_categories;
@@ -64,10 +64,14 @@ class InvMaterialItem final : public NoesisApp::NotifyPropertyChangedBase
 	const char* getTotal() const;
 	const char* getInStock() const;
 
+	void setCounts( int total, int inStock, int& dTotal, int& dInStock );
+
 private:
 	Noesis::String m_name;
 	Noesis::String m_inStock;
 	Noesis::String m_total;
+	int m_countTotal   = 0;
+	int m_countInStock = 0;
 	QString m_sid;
 	QString m_item;
 	QString m_group;
@@ -96,14 +100,20 @@ class InvItemItem final : public NoesisApp::NotifyPropertyChangedBase
 	const char* getTotal() const;
 	const char* getInStock() const;
 
+	void addCounts( int dTotal, int dInStock );
+	InvMaterialItem* material( const QString& sid ) const;
+
 private:
 	void UpdateState();
 	Noesis::String m_name;
 	Noesis::String m_inStock;
 	Noesis::String m_total;
+	int m_countTotal   = 0;
+	int m_countInStock = 0;
 	QString m_sid;
 	QString m_group;
 	QString m_category;
+	QList<QString> m_materialSIDs;
 
 	unsigned char m_active = 0;
 	Noesis::Nullable<bool> m_state;
@@ -135,11 +145,17 @@ class InvGroupItem final : public NoesisApp::NotifyPropertyChangedBase
 	const char* getTotal() const;
 	const char* getInStock() const;
 
+	void addCounts( int dTotal, int dInStock );
+	InvItemItem* item( const QString& sid ) const;
+
 private:
 	void UpdateState();
 	Noesis::String m_name;
 	Noesis::String m_inStock;
 	Noesis::String m_total;
+	int m_countTotal   = 0;
+	int m_countInStock = 0;
+	QList<QString> m_itemSIDs;
 	unsigned int m_stockpileID = 0;
 	QString m_sid;
 	QString m_category;
@@ -174,11 +190,17 @@ class InvCategoryItem final : public NoesisApp::NotifyPropertyChangedBase
 	const char* getTotal() const;
 	const char* getInStock() const;
 
+	void addCounts( int dTotal, int dInStock );
+	InvGroupItem* group( const QString& sid ) const;
+
 private:
 	void UpdateState();
 	Noesis::String m_name;
 	Noesis::String m_inStock;
 	Noesis::String m_total;
+	int m_countTotal   = 0;
+	int m_countInStock = 0;
+	QList<QString> m_groupSIDs;
 	QString m_sid;
 
 	unsigned char m_active = 0;
@@ -208,9 +230,12 @@ class InventoryModel final : public NoesisApp::NotifyPropertyChangedBase
 
 	/// @brief Replaces the category tree with fresh data from the inventory aggregator.
 	void updateCategories( const QList<GuiInventoryCategory>& categories );
+	/// @brief Applies changed material counts to the existing tree and its parent totals.
+	void updateCounts( const QList<GuiInventoryMaterial>& materials );
 
 private:
 	InventoryProxy* m_proxy = nullptr;
+	QList<QString> m_categorySIDs;
 
 	Noesis::ObservableCollection<InvCategoryItem>* GetCategories() const;
 	Noesis::Ptr<Noesis::ObservableCollection<InvCategoryItem>> m_categories;
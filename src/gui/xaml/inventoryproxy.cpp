@@ -31,6 +31,7 @@ InventoryProxy::InventoryProxy( QObject* parent ) :
 {
 	
     connect( Global::eventConnector->aggregatorInventory(), &AggregatorInventory::signalInventoryCategories, this, &InventoryProxy::onCategoryUpdate, Qt::QueuedConnection );
+    connect( Global::eventConnector->aggregatorInventory(), &AggregatorInventory::signalInventoryCounts, this, &InventoryProxy::onCountsUpdate, Qt::QueuedConnection );
 
     connect( this, &InventoryProxy::signalRequestCategories, Global::eventConnector->aggregatorInventory(), &AggregatorInventory::onRequestCategories, Qt::QueuedConnection );
     connect( this, &InventoryProxy::signalSetActive, Global::eventConnector->aggregatorInventory(), &AggregatorInventory::onSetActive, Qt::QueuedConnection );
@@ -58,6 +59,15 @@ void InventoryProxy::onCategoryUpdate( const QList<GuiInventoryCategory>& catego
 	}
 }
 
+/// @brief Slot: relays changed material counts to the model.
+void InventoryProxy::onCountsUpdate( const QList<GuiInventoryMaterial>& materials )
+{
+    if( m_parent )
+	{
+        m_parent->updateCounts( materials );
+	}
+}
+
 /// @brief Forwards a watch toggle for a specific (category, group, item, material) row to
 ///        the aggregator.
 void InventoryProxy::setActive( bool active, const GuiWatchedItem& gwi )
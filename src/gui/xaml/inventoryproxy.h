@@ -46,6 +46,7 @@ class InventoryProxy : public QObject
 
 private slots:
     void onCategoryUpdate( const QList<GuiInventoryCategory>& categories );
+    void onCountsUpdate( const QList<GuiInventoryMaterial>& materials );
 
 signals:
     void signalRequestCategories();
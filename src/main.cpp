@@ -20,8 +20,10 @@
 #include "base/io.h"
 #include "base/crashhandler.h"
 #include "base/global.h"
+#include "base/rng.h"
 
 #include "game/gamemanager.h"
+#include "game/replay.h"
 
 #include "gui/mainwindow.h"
 #include "gui/strings.h"
@@ -31,12 +33,14 @@
 #include <QDebug>
 #include <QDir>
 #include <QFileIconProvider>
+#include <QHashSeed>
 #include <QStandardPaths>
 #include <QColorSpace>
 #include <QSurfaceFormat>
 #include <QWindow>
 #include <QtWidgets/QApplication>
 
+#include <chrono>
 #include <iostream>
 #ifdef _WIN32
 #include <windows.h>
@@ -136,6 +140,17 @@ void logOutput( QtMsgType type, const QMessageLogContext& context, const QString
 
 int main( int argc, char* argv[] )
 {
+	// Hash container iteration order has to match between the recording and the replay, so the
+	// seed is fixed before Config, DB and translations fill their hashes
+	for ( int i = 1; i < argc; ++i )
+	{
+		if ( qstrcmp( argv[i], "-record" ) == 0 || qstrcmp( argv[i], "-replay" ) == 0 )
+		{
+			QHashSeed::setDeterministicGlobalSeed();
+			break;
+		}
+	}
+
 	setupCrashHandler();
 	clearLog();
 	qInstallMessageHandler( &logOutput );
@@ -192,7 +207,12 @@ int main( int argc, char* argv[] )
 
 	Global::cfg->set( "CurrentVersion", PROJECT_VERSION );
 
+	// Until a game seeds the streams from its world seed, e.g. for kingdom names in the new game screen
+	RNG::seed( std::chrono::system_clock::now().time_since_epoch().count() );
+
 	QStringList args = a.arguments();
+	QString replayFile;
+	QString dumpFolder;
 
 	for ( int i = 1; i < args.size(); ++i )
 	{
@@ -201,6 +221,10 @@ int main( int argc, char* argv[] )
 			qDebug() << "Command line options:";
 			qDebug() << "-h : displays this message";
 			qDebug() << "-v : toggles verbose mode, warning: this will spam your console with messages";
+			qDebug() << "-log : writes the in-game event log to gamelog.txt in the data folder";
+			qDebug() << "-record <file> : records the next loaded save game as a replay";
+			qDebug() << "-replay <file> : runs a recorded replay without window and prints tick timings";
+			qDebug() << "-dumpitems <folder> : writes the items of a save folder as items.json and exits";
 			qDebug() << "---";
 		}
 		if ( args.at( i ) == "-v" )
@@ -211,6 +235,39 @@ int main( int argc, char* argv[] )
 		{
 			Global::debugSound = true;
 		}
+		if ( args.at( i ) == "-log" )
+		{
+			Global::logger().setLogFile( IO::getDataFolder() + "/gamelog.txt" );
+		}
+		if ( ( args.at( i ) == "-record" || args.at( i ) == "-replay" ) && i + 1 < args.size() )
+		{
+			if ( args.at( i ) == "-record" )
+			{
+				Replay::setRecordFile( args.at( ++i ) );
+			}
+			else
+			{
+				replayFile = args.at( ++i );
+			}
+		}
+		if ( args.at( i ) == "-dumpitems" && i + 1 < args.size() )
+		{
+			dumpFolder = args.at( ++i );
+		}
+	}
+
+	if ( !dumpFolder.isEmpty() )
+	{
+		if ( !dumpFolder.endsWith( "/" ) )
+		{
+			dumpFolder += "/";
+		}
+		return IO::dumpItems( dumpFolder ) ? 0 : 1;
+	}
+
+	if ( !replayFile.isEmpty() )
+	{
+		return Replay::runHeadless( replayFile );
 	}
 
 	int width  = qMax( 1200, Global::cfg->get( "WindowWidth" ).toInt() );